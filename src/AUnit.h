@@ -53,15 +53,28 @@ SOFTWARE.
 #include "aunit/print64.h"
 #include "aunit/Verbosity.h"
 #include "aunit/Compare.h"
+#include "aunit/ByteSource.h"
 #include "aunit/Printer.h"
 #include "aunit/Test.h"
 #include "aunit/Assertion.h"
 #include "aunit/MetaAssertion.h"
 #include "aunit/TestOnce.h"
 #include "aunit/TestAgain.h"
+#include "aunit/TestTable.h"
+#include "aunit/LazyTest.h"
+#include "aunit/AsyncTest.h"
+#include "aunit/Baselines.h"
+#include "aunit/Benchmark.h"
+#include "aunit/Reporter.h"
+#include "aunit/TextReporter.h"
+#include "aunit/TapReporter.h"
+#include "aunit/JsonLinesReporter.h"
+#include "aunit/JUnitReporter.h"
+#include "aunit/BinaryReporter.h"
 #include "aunit/TestRunner.h"
 #include "aunit/AssertMacros.h" // terse assertXxx() macros
 #include "aunit/MetaAssertMacros.h"
+#include "aunit/BenchmarkMacros.h"
 #include "aunit/TestMacros.h"
 
 // Version format: xxyyzz == "xx.yy.zz"
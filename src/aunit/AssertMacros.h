@@ -100,6 +100,42 @@ SOFTWARE.
     return;\
 } while (false)
 
+/**
+ * Assert that the first n elements of the arrays arg1 and arg2 are equal. The
+ * arrays of integers are compared as raw memory, the arrays of float or double
+ * are compared element by element with ==. Only the first mismatch is
+ * reported.
+ */
+#define assertArrayEqual(arg1, arg2, n) do { \
+  if (!assertionArray(__FILE__, __LINE__, arg1, arg2, n)) \
+    return;\
+} while (false)
+
+/** Assert that the first 'size' bytes pointed to by arg1 and arg2 are equal. */
+#define assertMemEqual(arg1, arg2, size) do { \
+  if (!assertionMem(__FILE__, __LINE__, arg1, arg2, size)) \
+    return;\
+} while (false)
+
+/**
+ * Assert that each of the first n elements of the float or double arrays arg1
+ * and arg2 are within error of each other.
+ */
+#define assertAllNear(arg1, arg2, n, error) do { \
+  if (!assertionAllNear(__FILE__, __LINE__, arg1, arg2, n, error)) \
+    return;\
+} while (false)
+
+/**
+ * Assert that the ByteSource arg1 and arg2 produce the same bytes. The sources
+ * are read chunk by chunk until the first difference, whose offset is
+ * reported.
+ */
+#define assertStreamEqual(arg1, arg2) do { \
+  if (!assertionStream(__FILE__, __LINE__, arg1, arg2)) \
+    return;\
+} while (false)
+
 /**
  * Assert that the inner 'statement' returns with no fatal assertions. This is
  * required because AUnit does not use exceptions, so we have to check the
@@ -105,6 +105,41 @@ SOFTWARE.
     return;\
 } while (false)
 
+/** Assert that the first n elements of the arrays arg1 and arg2 are equal. */
+#define assertArrayEqual(arg1, arg2, n) do { \
+  if (!assertionArrayVerbose(__FILE__, __LINE__, \
+      arg1, AUNIT_F(#arg1), arg2, AUNIT_F(#arg2), n)) \
+    return;\
+} while (false)
+
+/** Assert that the first 'size' bytes pointed to by arg1 and arg2 are equal. */
+#define assertMemEqual(arg1, arg2, size) do { \
+  if (!assertionMemVerbose(__FILE__, __LINE__, \
+      arg1, AUNIT_F(#arg1), arg2, AUNIT_F(#arg2), size)) \
+    return;\
+} while (false)
+
+/**
+ * Assert that each of the first n elements of the float or double arrays arg1
+ * and arg2 are within error of each other.
+ */
+#define assertAllNear(arg1, arg2, n, error) do { \
+  if (!assertionAllNearVerbose(__FILE__, __LINE__, \
+      arg1, AUNIT_F(#arg1), arg2, AUNIT_F(#arg2), n, error, AUNIT_F(#error))) \
+    return;\
+} while (false)
+
+/**
+ * Assert that the ByteSource arg1 and arg2 produce the same bytes. The sources
+ * are read chunk by chunk until the first difference, whose offset is
+ * reported.
+ */
+#define assertStreamEqual(arg1, arg2) do { \
+  if (!assertionStreamVerbose(__FILE__, __LINE__, \
+      arg1, AUNIT_F(#arg1), arg2, AUNIT_F(#arg2))) \
+    return;\
+} while (false)
+
 /**
  * Assert that the inner 'statement' returns with no fatal assertions. This is
  * required because AUnit does not use exceptions, so we have to check the
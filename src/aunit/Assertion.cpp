@@ -25,12 +25,15 @@ SOFTWARE.
 #include <stdint.h>
 #include <Arduino.h>  // definition of Print
 #include "Flash.h"
-#include "Printer.h"
+#include "Config.h"
+#include "Compare.h"
+#include "ByteSource.h"
 #include "Assertion.h"
 
 #if ! defined(ARDUINO_ARCH_STM32)
 #include "print64.h"
 #endif
+#include "print_util.h"
 
 namespace aunit {
 
@@ -62,10 +65,8 @@ void printAssertionMessage(
   // https://github.com/mmurdoch/arduinounit/issues/70
   // for more info. Normal (const char*) strings will be deduped by the
   // compiler/linker.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhs);
@@ -91,10 +92,8 @@ void printAssertionMessage(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhs ? "true" : "false");
@@ -120,10 +119,8 @@ void printAssertionMessage(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   print64(*printer, lhs);
@@ -148,10 +145,8 @@ void printAssertionMessage(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   print64(*printer, lhs);
@@ -180,10 +175,8 @@ void printAssertionMessage(
   // Technically, we should cast to (uintptr_t). But all Arduino
   // microcontrollers are 32-bit, so we can cast to (unsigned long) to avoid
   // calling print64().
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (0x");
   printer->print((unsigned long) lhs, HEX);
@@ -209,10 +202,8 @@ void printAssertionBoolMessage(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(arg ? "true" : "false");
@@ -232,10 +223,8 @@ void printAssertionNearMessage(
     const char* opName,
     const A& error
 ) {
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": |(");
   printer->print(lhs);
@@ -256,197 +245,187 @@ bool Assertion::isOutputEnabled(bool ok) const {
       (!ok && isVerbosity(Verbosity::kAssertionFailed));
 }
 
-bool Assertion::assertionBool(
+bool Assertion::reportAssertionBool(
     const char* file,
     uint16_t line,
     bool arg,
-    bool value
+    bool value,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = (arg == value);
   if (isOutputEnabled(ok)) {
-    printAssertionBoolMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionBoolMessage(beginMessage(), ok, file, line,
         arg, value);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     bool lhs,
     const char* opName,
-    bool (*op)(bool lhs, bool rhs),
-    bool rhs
+    bool rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     char lhs,
     const char* opName,
-    bool (*op)(char lhs, char rhs),
-    char rhs
+    char rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     int lhs,
     const char* opName,
-    bool (*op)(int lhs, int rhs),
-    int rhs
+    int rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     unsigned int lhs,
     const char* opName,
-    bool (*op)(unsigned int lhs, unsigned int rhs),
-    unsigned int rhs
+    unsigned int rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     long lhs,
     const char* opName,
-    bool (*op)(long lhs, long rhs),
-    long rhs
+    long rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     unsigned long lhs,
     const char* opName,
-    bool (*op)(unsigned long lhs, unsigned long rhs),
-    unsigned long rhs
+    unsigned long rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     long long lhs,
     const char* opName,
-    bool (*op)(long long lhs, long long rhs),
-    long long rhs
+    long long rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     unsigned long long lhs,
     const char* opName,
-    bool (*op)(unsigned long long lhs, unsigned long long rhs),
-    unsigned long long rhs
+    unsigned long long rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     double lhs,
     const char* opName,
-    bool (*op)(double lhs, double rhs),
-    double rhs
+    double rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertion(
+bool Assertion::reportAssertion(
     const char* file,
     uint16_t line,
     const void* lhs,
     const char* opName,
-    bool (*op)(const void* lhs, const void* rhs),
-    const void* rhs
+    const void* rhs,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -463,8 +442,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -481,8 +461,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -499,8 +480,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -517,8 +499,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -535,8 +518,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -553,8 +537,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -571,8 +556,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -589,8 +575,9 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -607,103 +594,99 @@ bool Assertion::assertion(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionMessage(beginMessage(), ok, file, line,
         lhs, opName, rhs);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNear(
+bool Assertion::reportAssertionNear(
     const char* file,
     uint16_t line,
     int lhs,
     int rhs,
     int error,
     const char* opName,
-    bool (*opNear)(int lhs, int rhs, int error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessage(beginMessage(), ok, file, line,
         lhs, rhs, opName, error);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNear(
+bool Assertion::reportAssertionNear(
     const char* file,
     uint16_t line,
     unsigned int lhs,
     unsigned int rhs,
     unsigned int error,
     const char* opName,
-    bool (*opNear)(unsigned int lhs, unsigned int rhs, unsigned int error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessage(beginMessage(), ok, file, line,
         lhs, rhs, opName, error);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNear(
+bool Assertion::reportAssertionNear(
     const char* file,
     uint16_t line,
     long lhs,
     long rhs,
     long error,
     const char* opName,
-    bool (*opNear)(long lhs, long rhs, long error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessage(beginMessage(), ok, file, line,
         lhs, rhs, opName, error);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNear(
+bool Assertion::reportAssertionNear(
     const char* file,
     uint16_t line,
     unsigned long lhs,
     unsigned long rhs,
     unsigned long error,
     const char* opName,
-    bool (*opNear)(unsigned long lhs, unsigned long rhs, unsigned long error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessage(beginMessage(), ok, file, line,
         lhs, rhs, opName, error);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNear(
+bool Assertion::reportAssertionNear(
     const char* file,
     uint16_t line,
     double lhs,
     double rhs,
     double error,
     const char* opName,
-    bool (*opNear)(double lhs, double rhs, double error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessage(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessage(beginMessage(), ok, file, line,
         lhs, rhs, opName, error);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -737,10 +720,8 @@ void printAssertionMessageVerbose(
   // duplication of all the strings below. See
   // https://github.com/mmurdoch/arduinounit/issues/70
   // for more info.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhsString);
@@ -772,10 +753,8 @@ void printAssertionMessageVerbose(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhsString);
@@ -807,10 +786,8 @@ void printAssertionMessageVerbose(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhsString);
@@ -841,10 +818,8 @@ void printAssertionMessageVerbose(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhsString);
@@ -879,10 +854,8 @@ void printAssertionMessageVerbose(
   // Technically, we should cast to (uintptr_t). But all Arduino
   // microcontrollers are 32-bit, so we can cast to (unsigned long) to avoid
   // calling print64().
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(lhsString);
@@ -913,10 +886,8 @@ void printAssertionBoolMessageVerbose(
 ) {
 
   // Don't use F() strings here. Same reason as above.
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": (");
   printer->print(argString);
@@ -941,10 +912,8 @@ void printAssertionNearMessageVerbose(
     const A& error,
     const __FlashStringHelper* errorString
 ) {
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(": |(");
   printer->print(lhsString);
@@ -966,218 +935,208 @@ void printAssertionNearMessageVerbose(
 
 } // namespace
 
-bool Assertion::assertionBoolVerbose(
+bool Assertion::reportAssertionBoolVerbose(
     const char* file,
     uint16_t line,
     bool arg,
     const __FlashStringHelper* argString,
-    bool value
+    bool value,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = (arg == value);
   if (isOutputEnabled(ok)) {
-    printAssertionBoolMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionBoolMessageVerbose(beginMessage(), ok, file, line,
         arg, argString, value);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     bool lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(bool lhs, bool rhs),
     bool rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     char lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(char lhs, char rhs),
     char rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     int lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(int lhs, int rhs),
     int rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     unsigned int lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(unsigned int lhs, unsigned int rhs),
     unsigned int rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     long lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(long lhs, long rhs),
     long rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     unsigned long lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(unsigned long lhs, unsigned long rhs),
     unsigned long rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     long long lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(long long lhs, long long rhs),
     long long rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     unsigned long long lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(unsigned long long lhs, unsigned long long rhs),
     unsigned long long rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     double lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(double lhs, double rhs),
     double rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionVerbose(
+bool Assertion::reportAssertionVerbose(
     const char* file,
     uint16_t line,
     const void* lhs,
     const __FlashStringHelper* lhsString,
     const char* opName,
-    bool (*op)(const void* lhs, const void* rhs),
     const void* rhs,
-    const __FlashStringHelper* rhsString
+    const __FlashStringHelper* rhsString,
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1196,8 +1155,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1216,8 +1176,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1236,8 +1197,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1256,8 +1218,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1276,8 +1239,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1296,8 +1260,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1317,8 +1282,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1337,8 +1303,9 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -1357,14 +1324,15 @@ bool Assertion::assertionVerbose(
   if (isDone()) return false;
   bool ok = op(lhs, rhs);
   if (isOutputEnabled(ok)) {
-    printAssertionMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, opName, rhs, rhsString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNearVerbose(
+bool Assertion::reportAssertionNearVerbose(
     const char* file,
     uint16_t line,
     int lhs,
@@ -1374,19 +1342,18 @@ bool Assertion::assertionNearVerbose(
     int error,
     const __FlashStringHelper* errorString,
     const char* opName,
-    bool (*opNear)(int lhs, int rhs, int error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, rhs, rhsString, opName, error, errorString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNearVerbose(
+bool Assertion::reportAssertionNearVerbose(
     const char* file,
     uint16_t line,
     unsigned int lhs,
@@ -1396,19 +1363,18 @@ bool Assertion::assertionNearVerbose(
     unsigned int error,
     const __FlashStringHelper* errorString,
     const char* opName,
-    bool (*opNear)(unsigned int lhs, unsigned int rhs, unsigned int error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, rhs, rhsString, opName, error, errorString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNearVerbose(
+bool Assertion::reportAssertionNearVerbose(
     const char* file,
     uint16_t line,
     long lhs,
@@ -1418,19 +1384,18 @@ bool Assertion::assertionNearVerbose(
     long error,
     const __FlashStringHelper* errorString,
     const char* opName,
-    bool (*opNear)(long lhs, long rhs, long error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, rhs, rhsString, opName, error, errorString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNearVerbose(
+bool Assertion::reportAssertionNearVerbose(
     const char* file,
     uint16_t line,
     unsigned long lhs,
@@ -1440,19 +1405,18 @@ bool Assertion::assertionNearVerbose(
     unsigned long error,
     const __FlashStringHelper* errorString,
     const char* opName,
-    bool (*opNear)(unsigned long lhs, unsigned long rhs, unsigned long error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, rhs, rhsString, opName, error, errorString);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
 }
 
-bool Assertion::assertionNearVerbose(
+bool Assertion::reportAssertionNearVerbose(
     const char* file,
     uint16_t line,
     double lhs,
@@ -1462,13 +1426,423 @@ bool Assertion::assertionNearVerbose(
     double error,
     const __FlashStringHelper* errorString,
     const char* opName,
-    bool (*opNear)(double lhs, double rhs, double error)
+    bool ok
 ) {
-  if (isDone()) return false;
-  bool ok = opNear(lhs, rhs, error);
   if (isOutputEnabled(ok)) {
-    printAssertionNearMessageVerbose(Printer::getPrinter(), ok, file, line,
+    printAssertionNearMessageVerbose(beginMessage(), ok, file, line,
         lhs, lhsString, rhs, rhsString, opName, error, errorString);
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+//---------------------------------------------------------------------------
+// Array assertions
+//---------------------------------------------------------------------------
+
+namespace internal {
+
+// Number of elements printed before the first mismatch, and the maximum number
+// of elements printed around it.
+const size_t kArrayWindowBefore = 3;
+const size_t kArrayWindowSize = 8;
+
+const char kHexDigits[] = "0123456789abcdef";
+
+// Print the element as a hex number, most significant byte first. Elements
+// which are not an integer size are printed in memory order.
+void printHexElement(Print* printer, const uint8_t* element, size_t size) {
+  bool isInteger = (size == 1 || size == 2 || size == 4 || size == 8);
+  for (size_t i = 0; i < size; i++) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint8_t b = element[i];
+#else
+    uint8_t b = element[isInteger ? size - 1 - i : i];
+#endif
+    printer->print(kHexDigits[b >> 4]);
+    printer->print(kHexDigits[b & 0xf]);
+  }
+}
+
+// Prints the window of elements around the mismatch at 'index', for example
+// "{0003 0004 [0005] 0006}".
+void printArrayWindow(
+    Print* printer,
+    const void* data,
+    ElementType type,
+    size_t elementSize,
+    size_t n,
+    size_t index
+) {
+  size_t begin = (index > kArrayWindowBefore) ? index - kArrayWindowBefore : 0;
+  size_t end = (n - begin > kArrayWindowSize) ? begin + kArrayWindowSize : n;
+
+  printer->print('{');
+  for (size_t i = begin; i < end; i++) {
+    if (i > begin) printer->print(' ');
+    if (i == index) printer->print('[');
+    if (type == ElementType::kFloat) {
+      printer->print(((const float*) data)[i], 6);
+    } else if (type == ElementType::kDouble) {
+      printer->print(((const double*) data)[i], 6);
+    } else {
+      printHexElement(printer, (const uint8_t*) data + i * elementSize,
+          elementSize);
+    }
+    if (i == index) printer->print(']');
+  }
+  printer->print('}');
+}
+
+// Prints the subject of the array message: the 'noun' (e.g. "arrays") for
+// the terse messages, "(lhs) and (rhs)" for the verbose messages.
+void printArraySubject(
+    Print* printer,
+    const char* noun,
+    const __FlashStringHelper* lhsString,
+    const __FlashStringHelper* rhsString
+) {
+  if (lhsString == nullptr) {
+    printer->print(noun);
+  } else {
+    printer->print('(');
+    printer->print(lhsString);
+    printer->print(") and (");
+    printer->print(rhsString);
+    printer->print(')');
+  }
+}
+
+// Prints the tolerance of assertAllNear(): "(0.01)" or "(eps=0.01)".
+void printArrayError(
+    Print* printer,
+    const double* error,
+    const __FlashStringHelper* errorString
+) {
+  printer->print('(');
+  if (errorString != nullptr) {
+    printer->print(errorString);
+    printer->print('=');
+  }
+  printer->print(*error, 6);
+  printer->print(')');
+}
+
+// The unread part of the current chunk of a ByteSource compared by
+// assertStreamEqual().
+class StreamChunk {
+  public:
+    explicit StreamChunk(ByteSource& source) : mSource(source) {}
+
+    // Read the next chunk if the current one is used up. Return false at the
+    // end of the source.
+    bool fill() {
+      if (mBegin < mEnd) return true;
+      mBegin = 0;
+      mEnd = mSource.read(mBuffer, sizeof(mBuffer));
+      return mEnd > 0;
+    }
+
+    const uint8_t* data() const { return mBuffer + mBegin; }
+
+    size_t available() const { return mEnd - mBegin; }
+
+    void consume(size_t n) { mBegin += n; }
+
+  private:
+    ByteSource& mSource;
+    uint8_t mBuffer[AUNIT_STREAM_CHUNK_SIZE];
+    size_t mBegin = 0;
+    size_t mEnd = 0;
+};
+
+// Prints the bytes from the first mismatch to the end of the chunk, up to the
+// size of the array window, for example "{[34] 35 36}". A source which has
+// ended prints as "{}".
+void printStreamWindow(Print* printer, const StreamChunk& chunk) {
+  size_t n = chunk.available();
+  if (n > kArrayWindowSize) n = kArrayWindowSize;
+  printer->print('{');
+  for (size_t i = 0; i < n; i++) {
+    if (i > 0) printer->print(' ');
+    if (i == 0) printer->print('[');
+    printHexElement(printer, chunk.data() + i, 1);
+    if (i == 0) printer->print(']');
+  }
+  printer->print('}');
+}
+
+} // namespace
+
+bool Assertion::assertionBytes(
+    const char* file,
+    uint16_t line,
+    const void* lhs,
+    const __FlashStringHelper* lhsString,
+    const void* rhs,
+    const __FlashStringHelper* rhsString,
+    ElementType type,
+    size_t elementSize,
+    size_t n
+) {
+  if (isDone()) return false;
+  size_t size = n * elementSize;
+  size_t offset = findMismatch(lhs, rhs, size);
+  bool ok = (offset == size);
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+  size_t index = ok ? n : offset / elementSize;
+  return reportAssertionArray(file, line, lhs, lhsString, rhs, rhsString,
+      type, elementSize, n, index, nullptr, nullptr);
+}
+
+bool Assertion::assertionArray(
+    const char* file,
+    uint16_t line,
+    const float* lhs,
+    const float* rhs,
+    size_t n
+) {
+  return assertionArrayVerbose(file, line, lhs, nullptr, rhs, nullptr, n);
+}
+
+bool Assertion::assertionArray(
+    const char* file,
+    uint16_t line,
+    const double* lhs,
+    const double* rhs,
+    size_t n
+) {
+  return assertionArrayVerbose(file, line, lhs, nullptr, rhs, nullptr, n);
+}
+
+bool Assertion::assertionAllNear(
+    const char* file,
+    uint16_t line,
+    const float* lhs,
+    const float* rhs,
+    size_t n,
+    float error
+) {
+  return assertionAllNearVerbose(file, line, lhs, nullptr, rhs, nullptr, n,
+      error, nullptr);
+}
+
+bool Assertion::assertionAllNear(
+    const char* file,
+    uint16_t line,
+    const double* lhs,
+    const double* rhs,
+    size_t n,
+    double error
+) {
+  return assertionAllNearVerbose(file, line, lhs, nullptr, rhs, nullptr, n,
+      error, nullptr);
+}
+
+bool Assertion::assertionArrayVerbose(
+    const char* file,
+    uint16_t line,
+    const float* lhs,
+    const __FlashStringHelper* lhsString,
+    const float* rhs,
+    const __FlashStringHelper* rhsString,
+    size_t n
+) {
+  if (isDone()) return false;
+  size_t index = findMismatch(lhs, rhs, n);
+  bool ok = (index == n);
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+  return reportAssertionArray(file, line, lhs, lhsString, rhs, rhsString,
+      ElementType::kFloat, sizeof(float), n, index, nullptr, nullptr);
+}
+
+bool Assertion::assertionArrayVerbose(
+    const char* file,
+    uint16_t line,
+    const double* lhs,
+    const __FlashStringHelper* lhsString,
+    const double* rhs,
+    const __FlashStringHelper* rhsString,
+    size_t n
+) {
+  if (isDone()) return false;
+  size_t index = findMismatch(lhs, rhs, n);
+  bool ok = (index == n);
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+  return reportAssertionArray(file, line, lhs, lhsString, rhs, rhsString,
+      ElementType::kDouble, sizeof(double), n, index, nullptr, nullptr);
+}
+
+bool Assertion::assertionAllNearVerbose(
+    const char* file,
+    uint16_t line,
+    const float* lhs,
+    const __FlashStringHelper* lhsString,
+    const float* rhs,
+    const __FlashStringHelper* rhsString,
+    size_t n,
+    float error,
+    const __FlashStringHelper* errorString
+) {
+  if (isDone()) return false;
+  size_t index = findNotNear(lhs, rhs, n, error);
+  bool ok = (index == n);
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+  double e = error;
+  return reportAssertionArray(file, line, lhs, lhsString, rhs, rhsString,
+      ElementType::kFloat, sizeof(float), n, index, &e, errorString);
+}
+
+bool Assertion::assertionAllNearVerbose(
+    const char* file,
+    uint16_t line,
+    const double* lhs,
+    const __FlashStringHelper* lhsString,
+    const double* rhs,
+    const __FlashStringHelper* rhsString,
+    size_t n,
+    double error,
+    const __FlashStringHelper* errorString
+) {
+  if (isDone()) return false;
+  size_t index = findNotNear(lhs, rhs, n, error);
+  bool ok = (index == n);
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+  return reportAssertionArray(file, line, lhs, lhsString, rhs, rhsString,
+      ElementType::kDouble, sizeof(double), n, index, &error, errorString);
+}
+
+bool Assertion::assertionStream(
+    const char* file,
+    uint16_t line,
+    ByteSource& lhs,
+    ByteSource& rhs
+) {
+  return assertionStreamVerbose(file, line, lhs, nullptr, rhs, nullptr);
+}
+
+// Prints something like the following:
+// Test.ino:820: Assertion failed: streams differ at byte 1234:
+//    {[34] 35 36 37} != {[78] 35 36 37}.
+// Test.ino:820: Assertion passed: streams are equal, 4096 bytes.
+bool Assertion::assertionStreamVerbose(
+    const char* file,
+    uint16_t line,
+    ByteSource& lhs,
+    const __FlashStringHelper* lhsString,
+    ByteSource& rhs,
+    const __FlashStringHelper* rhsString
+) {
+  if (isDone()) return false;
+
+  StreamChunk a(lhs);
+  StreamChunk b(rhs);
+  size_t offset = 0;
+  bool ok;
+  while (true) {
+    bool hasA = a.fill();
+    bool hasB = b.fill();
+    if (! hasA || ! hasB) {
+      ok = (hasA == hasB);
+      break;
+    }
+    size_t n = (a.available() < b.available()) ? a.available() : b.available();
+    size_t i = findMismatch(a.data(), b.data(), n);
+    a.consume(i);
+    b.consume(i);
+    offset += i;
+    if (i < n) {
+      ok = false;
+      break;
+    }
+  }
+  if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+
+  if (isOutputEnabled(ok)) {
+    // Don't use F() strings here. Same reason as printAssertionMessage().
+    Print* printer = beginMessage();
+    printLocation(printer, file, line);
+    printer->print("Assertion ");
+    printer->print(ok ? "passed" : "failed");
+    printer->print(": ");
+    printArraySubject(printer, "streams", lhsString, rhsString);
+    if (ok) {
+      printer->print(" are equal, ");
+      printer->print(offset);
+      printer->print(" bytes");
+    } else {
+      printer->print(" differ at byte ");
+      printer->print(offset);
+      printer->print(": ");
+      printStreamWindow(printer, a);
+      printer->print(" != ");
+      printStreamWindow(printer, b);
+    }
+    printer->println('.');
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+// Prints something like the following:
+// Test.ino:820: Assertion failed: arrays differ at [5] of 64:
+//    {0003 0004 0005 [0006] 0007} != {0003 0004 0005 [0106] 0007}.
+// Test.ino:820: Assertion passed: (expected) and (actual) are equal,
+//    64 elements.
+// (Each message is printed on a single line.)
+bool Assertion::reportAssertionArray(
+    const char* file,
+    uint16_t line,
+    const void* lhs,
+    const __FlashStringHelper* lhsString,
+    const void* rhs,
+    const __FlashStringHelper* rhsString,
+    ElementType type,
+    size_t elementSize,
+    size_t n,
+    size_t index,
+    const double* error,
+    const __FlashStringHelper* errorString
+) {
+  bool ok = (index == n);
+  if (isOutputEnabled(ok)) {
+    // Don't use F() strings here. Same reason as printAssertionMessage().
+    Print* printer = beginMessage();
+    printLocation(printer, file, line);
+    printer->print("Assertion ");
+    printer->print(ok ? "passed" : "failed");
+    printer->print(": ");
+    printArraySubject(printer, "arrays", lhsString, rhsString);
+    if (ok) {
+      if (error == nullptr) {
+        printer->print(" are equal, ");
+      } else {
+        printer->print(" are within ");
+        printArrayError(printer, error, errorString);
+        printer->print(", ");
+      }
+      printer->print(n);
+      printer->print(type == ElementType::kMemory ? " bytes" : " elements");
+    } else {
+      if (error == nullptr) {
+        printer->print(" differ at [");
+      } else {
+        printer->print(" differ by more than ");
+        printArrayError(printer, error, errorString);
+        printer->print(" at [");
+      }
+      printer->print(index);
+      printer->print("] of ");
+      printer->print(n);
+      printer->print(": ");
+      printArrayWindow(printer, lhs, type, elementSize, n, index);
+      printer->print(" != ");
+      printArrayWindow(printer, rhs, type, elementSize, n, index);
+    }
+    printer->println('.');
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -25,6 +25,7 @@ SOFTWARE.
 #ifndef AUNIT_ASSERTION_H
 #define AUNIT_ASSERTION_H
 
+#include <stddef.h> // size_t
 #include "Flash.h"
 #include "Test.h"
 
@@ -33,6 +34,20 @@ class String;
 
 namespace aunit {
 
+class ByteSource;
+
+namespace internal {
+
+/** Type of the elements of the arrays compared by the array assertions. */
+enum class ElementType : uint8_t {
+  kMemory,
+  kInteger,
+  kFloat,
+  kDouble,
+};
+
+}
+
 /**
  * An Assertion class is a subclass of Test and provides various overloaded
  * assertion() functions. Having this class inherit from Test allows it to
@@ -49,6 +64,13 @@ namespace aunit {
  * it interfered with the resolution of assertion(char*, char*). The wrong
  * function would be called.
  *
+ * The assertion() methods of the primitive types are inline, and only check
+ * the result of the comparison. The passed assertions never leave the call
+ * site, and the compiler can replace the call through the 'op' function
+ * pointer with the comparison itself. The assertion message is formatted by
+ * the out-of-line reportXxx() methods, only if the assertion failed or if the
+ * messages of passed assertions are enabled.
+ *
  * The assertion() methods are internal helpers, they should not be called
  * directly by users.
  */
@@ -67,7 +89,12 @@ class Assertion: public Test {
         const char* file,
         uint16_t line,
         bool arg,
-        bool value);
+        bool value) {
+      if (isDone()) return false;
+      bool ok = (arg == value);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionBool(file, line, arg, value, ok);
+    }
 
     /** Used by assertXxx(bool, bool). */
     bool assertion(
@@ -76,7 +103,12 @@ class Assertion: public Test {
         bool lhs,
         const char* opName,
         bool (*op)(bool lhs, bool rhs),
-        bool rhs);
+        bool rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(char, char). */
     bool assertion(
@@ -85,7 +117,12 @@ class Assertion: public Test {
         char lhs,
         const char* opName,
         bool (*op)(char lhs, char rhs),
-        char rhs);
+        char rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(int, int). */
     bool assertion(
@@ -94,7 +131,12 @@ class Assertion: public Test {
         int lhs,
         const char* opName,
         bool (*op)(int lhs, int rhs),
-        int rhs);
+        int rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(unsigned int, unsigned int). */
     bool assertion(
@@ -103,7 +145,12 @@ class Assertion: public Test {
         unsigned int lhs,
         const char* opName,
         bool (*op)(unsigned int lhs, unsigned int rhs),
-        unsigned int rhs);
+        unsigned int rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(long, long). */
     bool assertion(
@@ -112,7 +159,12 @@ class Assertion: public Test {
         long lhs,
         const char* opName,
         bool (*op)(long lhs, long rhs),
-        long rhs);
+        long rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(unsigned long, unsigned long). */
     bool assertion(
@@ -121,7 +173,12 @@ class Assertion: public Test {
         unsigned long lhs,
         const char* opName,
         bool (*op)(unsigned long lhs, unsigned long rhs),
-        unsigned long rhs);
+        unsigned long rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(long long, long long). */
     bool assertion(
@@ -130,7 +187,12 @@ class Assertion: public Test {
         long long lhs,
         const char* opName,
         bool (*op)(long long lhs, long long rhs),
-        long long rhs);
+        long long rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(unsigned long long, unsigned long long). */
     bool assertion(
@@ -139,7 +201,12 @@ class Assertion: public Test {
         unsigned long long lhs,
         const char* opName,
         bool (*op)(unsigned long long lhs, unsigned long long rhs),
-        unsigned long long rhs);
+        unsigned long long rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(double, double). */
     bool assertion(
@@ -148,7 +215,12 @@ class Assertion: public Test {
         double lhs,
         const char* opName,
         bool (*op)(double lhs, double rhs),
-        double rhs);
+        double rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(const void*, const void*). */
     bool assertion(
@@ -157,7 +229,12 @@ class Assertion: public Test {
         const void* lhs,
         const char* opName,
         bool (*op)(const void* lhs, const void* rhs),
-        const void* rhs);
+        const void* rhs) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertion(file, line, lhs, opName, rhs, ok);
+    }
 
     /** Used by assertXxx(const char*, const char*). */
     bool assertion(
@@ -254,7 +331,12 @@ class Assertion: public Test {
         int rhs,
         int error,
         const char* opName,
-        bool (*compareNear)(int lhs, int rhs, int error));
+        bool (*compareNear)(int lhs, int rhs, int error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNear(file, line, lhs, rhs, error, opName, ok);
+    }
 
     /** Used by assertNear(unsigned int, unsigned int). */
     bool assertionNear(
@@ -265,7 +347,12 @@ class Assertion: public Test {
         unsigned int error,
         const char* opName,
         bool (*compareNear)(
-            unsigned int lhs, unsigned int rhs, unsigned int error));
+            unsigned int lhs, unsigned int rhs, unsigned int error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNear(file, line, lhs, rhs, error, opName, ok);
+    }
 
     /** Used by assertNear(long, long). */
     bool assertionNear(
@@ -275,7 +362,12 @@ class Assertion: public Test {
         long rhs,
         long error,
         const char* opName,
-        bool (*compareNear)(long lhs, long rhs, long error));
+        bool (*compareNear)(long lhs, long rhs, long error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNear(file, line, lhs, rhs, error, opName, ok);
+    }
 
     /** Used by assertNear(unsigned long, unsigned long). */
     bool assertionNear(
@@ -286,7 +378,12 @@ class Assertion: public Test {
         unsigned long error,
         const char* opName,
         bool (*compareNear)(
-            unsigned long lhs, unsigned long rhs, unsigned long error));
+            unsigned long lhs, unsigned long rhs, unsigned long error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNear(file, line, lhs, rhs, error, opName, ok);
+    }
 
     /** Used by assertNear(double, double). */
     bool assertionNear(
@@ -296,7 +393,80 @@ class Assertion: public Test {
         double rhs,
         double error,
         const char* opName,
-        bool (*compareNear)(double lhs, double rhs, double error));
+        bool (*compareNear)(double lhs, double rhs, double error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNear(file, line, lhs, rhs, error, opName, ok);
+    }
+
+    /** Used by assertMemEqual(). */
+    bool assertionMem(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const void* rhs,
+        size_t size) {
+      return assertionBytes(file, line, lhs, nullptr, rhs, nullptr,
+          internal::ElementType::kMemory, 1, size);
+    }
+
+    /**
+     * Used by assertArrayEqual() for arrays of integers. The elements are
+     * compared as raw memory, so T must be an integer type, or a struct
+     * without any padding bytes.
+     */
+    template <typename T>
+    bool assertionArray(
+        const char* file,
+        uint16_t line,
+        const T* lhs,
+        const T* rhs,
+        size_t n) {
+      return assertionBytes(file, line, lhs, nullptr, rhs, nullptr,
+          internal::ElementType::kInteger, sizeof(T), n);
+    }
+
+    /** Used by assertArrayEqual(const float*, const float*). */
+    bool assertionArray(
+        const char* file,
+        uint16_t line,
+        const float* lhs,
+        const float* rhs,
+        size_t n);
+
+    /** Used by assertArrayEqual(const double*, const double*). */
+    bool assertionArray(
+        const char* file,
+        uint16_t line,
+        const double* lhs,
+        const double* rhs,
+        size_t n);
+
+    /** Used by assertAllNear(const float*, const float*). */
+    bool assertionAllNear(
+        const char* file,
+        uint16_t line,
+        const float* lhs,
+        const float* rhs,
+        size_t n,
+        float error);
+
+    /** Used by assertAllNear(const double*, const double*). */
+    bool assertionAllNear(
+        const char* file,
+        uint16_t line,
+        const double* lhs,
+        const double* rhs,
+        size_t n,
+        double error);
+
+    /** Used by assertStreamEqual(). */
+    bool assertionStream(
+        const char* file,
+        uint16_t line,
+        ByteSource& lhs,
+        ByteSource& rhs);
 
     // Verbose versions of above.
 
@@ -306,7 +476,12 @@ class Assertion: public Test {
         uint16_t line,
         bool arg,
         const __FlashStringHelper* argString,
-        bool value);
+        bool value) {
+      if (isDone()) return false;
+      bool ok = (arg == value);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionBoolVerbose(file, line, arg, argString, value, ok);
+    }
 
     /** Used by assertEqual(bool, bool). */
     bool assertionVerbose(
@@ -317,7 +492,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(bool lhs, bool rhs),
         bool rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(char, char). */
     bool assertionVerbose(
@@ -328,7 +509,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(char lhs, char rhs),
         char rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(int, int). */
     bool assertionVerbose(
@@ -339,7 +526,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(int lhs, int rhs),
         int rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(unsigned int, unsigned int). */
     bool assertionVerbose(
@@ -350,7 +543,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(unsigned int lhs, unsigned int rhs),
         unsigned int rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(long, long). */
     bool assertionVerbose(
@@ -361,7 +560,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(long lhs, long rhs),
         long rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(unsigned long, unsigned long). */
     bool assertionVerbose(
@@ -372,7 +577,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(unsigned long lhs, unsigned long rhs),
         unsigned long rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(long long, long long). */
     bool assertionVerbose(
@@ -383,7 +594,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(long long lhs, long long rhs),
         long long rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(unsigned long long, unsigned long long). */
     bool assertionVerbose(
@@ -394,7 +611,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(unsigned long long lhs, unsigned long long rhs),
         unsigned long long rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(double, double). */
     bool assertionVerbose(
@@ -405,7 +628,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(double lhs, double rhs),
         double rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(const void*, const void*). */
     bool assertionVerbose(
@@ -416,7 +645,13 @@ class Assertion: public Test {
         const char* opName,
         bool (*op)(const void* lhs, const void* rhs),
         const void* rhs,
-        const __FlashStringHelper* rhsString);
+        const __FlashStringHelper* rhsString) {
+      if (isDone()) return false;
+      bool ok = op(lhs, rhs);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionVerbose(
+          file, line, lhs, lhsString, opName, rhs, rhsString, ok);
+    }
 
     /** Used by assertXxx(const char*, const char*). */
     bool assertionVerbose(
@@ -534,7 +769,14 @@ class Assertion: public Test {
         int error,
         const __FlashStringHelper* errorString,
         const char* opName,
-        bool (*compareNear)(int lhs, int rhs, int error));
+        bool (*compareNear)(int lhs, int rhs, int error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNearVerbose(
+          file, line, lhs, lhsString, rhs, rhsString, error, errorString,
+          opName, ok);
+    }
 
     /** Used by assertNear(unsigned int, unsigned int). */
     bool assertionNearVerbose(
@@ -548,7 +790,14 @@ class Assertion: public Test {
         const __FlashStringHelper* errorString,
         const char* opName,
         bool (*compareNear)(
-            unsigned int lhs, unsigned int rhs, unsigned int error));
+            unsigned int lhs, unsigned int rhs, unsigned int error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNearVerbose(
+          file, line, lhs, lhsString, rhs, rhsString, error, errorString,
+          opName, ok);
+    }
 
     /** Used by assertNear(long, long). */
     bool assertionNearVerbose(
@@ -561,7 +810,14 @@ class Assertion: public Test {
         long error,
         const __FlashStringHelper* errorString,
         const char* opName,
-        bool (*compareNear)(long lhs, long rhs, long error));
+        bool (*compareNear)(long lhs, long rhs, long error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNearVerbose(
+          file, line, lhs, lhsString, rhs, rhsString, error, errorString,
+          opName, ok);
+    }
 
     /** Used by assertNear(unsigned long, unsigned long). */
     bool assertionNearVerbose(
@@ -575,7 +831,14 @@ class Assertion: public Test {
         const __FlashStringHelper* errorString,
         const char* opName,
         bool (*compareNear)(
-            unsigned long lhs, unsigned long rhs, unsigned long error));
+            unsigned long lhs, unsigned long rhs, unsigned long error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNearVerbose(
+          file, line, lhs, lhsString, rhs, rhsString, error, errorString,
+          opName, ok);
+    }
 
     /** Used by assertNear(double, double). */
     bool assertionNearVerbose(
@@ -588,9 +851,466 @@ class Assertion: public Test {
         double error,
         const __FlashStringHelper* errorString,
         const char* opName,
-        bool (*compareNear)(double lhs, double rhs, double error));
+        bool (*compareNear)(double lhs, double rhs, double error)) {
+      if (isDone()) return false;
+      bool ok = compareNear(lhs, rhs, error);
+      if (ok && !isVerbosity(Verbosity::kAssertionPassed)) return true;
+      return reportAssertionNearVerbose(
+          file, line, lhs, lhsString, rhs, rhsString, error, errorString,
+          opName, ok);
+    }
+
+    /** Used by assertMemEqual(). */
+    bool assertionMemVerbose(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const __FlashStringHelper* lhsString,
+        const void* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t size) {
+      return assertionBytes(file, line, lhs, lhsString, rhs, rhsString,
+          internal::ElementType::kMemory, 1, size);
+    }
+
+    /** Used by assertArrayEqual() for arrays of integers. */
+    template <typename T>
+    bool assertionArrayVerbose(
+        const char* file,
+        uint16_t line,
+        const T* lhs,
+        const __FlashStringHelper* lhsString,
+        const T* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t n) {
+      return assertionBytes(file, line, lhs, lhsString, rhs, rhsString,
+          internal::ElementType::kInteger, sizeof(T), n);
+    }
+
+    /** Used by assertArrayEqual(const float*, const float*). */
+    bool assertionArrayVerbose(
+        const char* file,
+        uint16_t line,
+        const float* lhs,
+        const __FlashStringHelper* lhsString,
+        const float* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t n);
+
+    /** Used by assertArrayEqual(const double*, const double*). */
+    bool assertionArrayVerbose(
+        const char* file,
+        uint16_t line,
+        const double* lhs,
+        const __FlashStringHelper* lhsString,
+        const double* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t n);
+
+    /** Used by assertAllNear(const float*, const float*). */
+    bool assertionAllNearVerbose(
+        const char* file,
+        uint16_t line,
+        const float* lhs,
+        const __FlashStringHelper* lhsString,
+        const float* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t n,
+        float error,
+        const __FlashStringHelper* errorString);
+
+    /** Used by assertAllNear(const double*, const double*). */
+    bool assertionAllNearVerbose(
+        const char* file,
+        uint16_t line,
+        const double* lhs,
+        const __FlashStringHelper* lhsString,
+        const double* rhs,
+        const __FlashStringHelper* rhsString,
+        size_t n,
+        double error,
+        const __FlashStringHelper* errorString);
+
+    /** Used by assertStreamEqual(). */
+    bool assertionStreamVerbose(
+        const char* file,
+        uint16_t line,
+        ByteSource& lhs,
+        const __FlashStringHelper* lhsString,
+        ByteSource& rhs,
+        const __FlashStringHelper* rhsString);
 
   private:
+    /**
+     * Compare 'n' elements of 'elementSize' bytes as raw memory, for
+     * assertMemEqual() and assertArrayEqual(). A nullptr lhsString selects
+     * the terse message.
+     */
+    bool assertionBytes(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const __FlashStringHelper* lhsString,
+        const void* rhs,
+        const __FlashStringHelper* rhsString,
+        internal::ElementType type,
+        size_t elementSize,
+        size_t n);
+
+    /**
+     * Report the result of the array assertions. The 'index' is the first
+     * mismatching element, or 'n' if the arrays are equal. A nullptr 'error'
+     * means an exact comparison.
+     */
+    bool reportAssertionArray(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const __FlashStringHelper* lhsString,
+        const void* rhs,
+        const __FlashStringHelper* rhsString,
+        internal::ElementType type,
+        size_t elementSize,
+        size_t n,
+        size_t index,
+        const double* error,
+        const __FlashStringHelper* errorString);
+
+    // Out-of-line parts of the inline assertions of the primitive types above,
+    // called only if the assertion failed or its message is enabled.
+
+    /** Report the result of assertTrue() and assertFalse(). */
+    bool reportAssertionBool(
+        const char* file,
+        uint16_t line,
+        bool arg,
+        bool value,
+        bool ok);
+
+    /** Report the result of assertXxx(bool, bool). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        bool lhs,
+        const char* opName,
+        bool rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(char, char). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        char lhs,
+        const char* opName,
+        char rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(int, int). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        int lhs,
+        const char* opName,
+        int rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned int, unsigned int). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        unsigned int lhs,
+        const char* opName,
+        unsigned int rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(long, long). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        long lhs,
+        const char* opName,
+        long rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned long, unsigned long). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        unsigned long lhs,
+        const char* opName,
+        unsigned long rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(long long, long long). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        long long lhs,
+        const char* opName,
+        long long rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned long long, unsigned long long). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        unsigned long long lhs,
+        const char* opName,
+        unsigned long long rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(double, double). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        double lhs,
+        const char* opName,
+        double rhs,
+        bool ok);
+
+    /** Report the result of assertXxx(const void*, const void*). */
+    bool reportAssertion(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const char* opName,
+        const void* rhs,
+        bool ok);
+
+    /** Report the result of assertNear(int, int). */
+    bool reportAssertionNear(
+        const char* file,
+        uint16_t line,
+        int lhs,
+        int rhs,
+        int error,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(unsigned int, unsigned int). */
+    bool reportAssertionNear(
+        const char* file,
+        uint16_t line,
+        unsigned int lhs,
+        unsigned int rhs,
+        unsigned int error,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(long, long). */
+    bool reportAssertionNear(
+        const char* file,
+        uint16_t line,
+        long lhs,
+        long rhs,
+        long error,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(unsigned long, unsigned long). */
+    bool reportAssertionNear(
+        const char* file,
+        uint16_t line,
+        unsigned long lhs,
+        unsigned long rhs,
+        unsigned long error,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(double, double). */
+    bool reportAssertionNear(
+        const char* file,
+        uint16_t line,
+        double lhs,
+        double rhs,
+        double error,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertTrue() and assertFalse(). */
+    bool reportAssertionBoolVerbose(
+        const char* file,
+        uint16_t line,
+        bool arg,
+        const __FlashStringHelper* argString,
+        bool value,
+        bool ok);
+
+    /** Report the result of assertEqual(bool, bool). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        bool lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        bool rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(char, char). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        char lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        char rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(int, int). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        int lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        int rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned int, unsigned int). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        unsigned int lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        unsigned int rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(long, long). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        long lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        long rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned long, unsigned long). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        unsigned long lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        unsigned long rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(long long, long long). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        long long lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        long long rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(unsigned long long, unsigned long long). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        unsigned long long lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        unsigned long long rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(double, double). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        double lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        double rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertXxx(const void*, const void*). */
+    bool reportAssertionVerbose(
+        const char* file,
+        uint16_t line,
+        const void* lhs,
+        const __FlashStringHelper* lhsString,
+        const char* opName,
+        const void* rhs,
+        const __FlashStringHelper* rhsString,
+        bool ok);
+
+    /** Report the result of assertNear(int, int). */
+    bool reportAssertionNearVerbose(
+        const char* file,
+        uint16_t line,
+        int lhs,
+        const __FlashStringHelper* lhsString,
+        int rhs,
+        const __FlashStringHelper* rhsString,
+        int error,
+        const __FlashStringHelper* errorString,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(unsigned int, unsigned int). */
+    bool reportAssertionNearVerbose(
+        const char* file,
+        uint16_t line,
+        unsigned int lhs,
+        const __FlashStringHelper* lhsString,
+        unsigned int rhs,
+        const __FlashStringHelper* rhsString,
+        unsigned int error,
+        const __FlashStringHelper* errorString,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(long, long). */
+    bool reportAssertionNearVerbose(
+        const char* file,
+        uint16_t line,
+        long lhs,
+        const __FlashStringHelper* lhsString,
+        long rhs,
+        const __FlashStringHelper* rhsString,
+        long error,
+        const __FlashStringHelper* errorString,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(unsigned long, unsigned long). */
+    bool reportAssertionNearVerbose(
+        const char* file,
+        uint16_t line,
+        unsigned long lhs,
+        const __FlashStringHelper* lhsString,
+        unsigned long rhs,
+        const __FlashStringHelper* rhsString,
+        unsigned long error,
+        const __FlashStringHelper* errorString,
+        const char* opName,
+        bool ok);
+
+    /** Report the result of assertNear(double, double). */
+    bool reportAssertionNearVerbose(
+        const char* file,
+        uint16_t line,
+        double lhs,
+        const __FlashStringHelper* lhsString,
+        double rhs,
+        const __FlashStringHelper* rhsString,
+        double error,
+        const __FlashStringHelper* errorString,
+        const char* opName,
+        bool ok);
+
     // Disable copy-constructor and assignment operator
     Assertion(const Assertion&) = delete;
     Assertion& operator=(const Assertion&) = delete;
@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Arduino.h> // millis(), Print
+#include "Printer.h"
+#include "print_util.h"
+#include "AsyncTest.h"
+
+namespace aunit {
+
+using internal::printLocation;
+
+void AsyncTest::setup() {
+  TestAgain::setup();
+  mResumeLine = 0;
+  mIsSuspended = false;
+#if ! AUNIT_ENABLE_TEST_TIMERS
+  mIsSleeping = false;
+#endif
+}
+
+void AsyncTest::again() {
+#if ! AUNIT_ENABLE_TEST_TIMERS
+  if (mIsSleeping) {
+    if (millis() - mStartMillis < mWaitMillis) return;
+    mIsSleeping = false;
+  }
+#endif
+
+  // A body which returns without being suspended has reached its end, or
+  // failed an assertion.
+  mIsSuspended = false;
+  run();
+  if (!mIsSuspended && isNotDone()) {
+    pass();
+  }
+}
+
+void AsyncTest::sleep(uint16_t line, unsigned long durationMillis) {
+  mResumeLine = line;
+#if AUNIT_ENABLE_TEST_TIMERS
+  sleepUntil(millis() + durationMillis);
+#else
+  mStartMillis = millis();
+  mWaitMillis = durationMillis;
+  mIsSleeping = true;
+#endif
+  mIsSuspended = true;
+}
+
+void AsyncTest::await(uint16_t line, unsigned long timeoutMillis) {
+  mResumeLine = line;
+  mStartMillis = millis();
+  mWaitMillis = timeoutMillis;
+}
+
+// "{file}:{line}: Assertion failed: AUNIT_AWAIT({condition}) timed out after
+// {millis} ms."
+void AsyncTest::awaitPending(const char* file, uint16_t line,
+    const __FlashStringHelper* condition) {
+  if (mWaitMillis == 0 || millis() - mStartMillis < mWaitMillis) {
+    mIsSuspended = true;
+    return;
+  }
+
+  if (isOutputEnabled(false)) {
+    Print* printer = beginMessage();
+    printLocation(printer, file, line);
+    printer->print(F("Assertion failed: AUNIT_AWAIT("));
+    printer->print(condition);
+    printer->print(F(") timed out after "));
+    printer->print(mWaitMillis);
+    printer->println(F(" ms."));
+    endMessage();
+  }
+  fail();
+}
+
+}
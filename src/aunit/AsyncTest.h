@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_ASYNC_TEST_H
+#define AUNIT_ASYNC_TEST_H
+
+#include <stdint.h>
+#include "TestAgain.h"
+
+class __FlashStringHelper;
+
+/** Tell the compiler that a case label is reached on purpose. */
+#if defined(__has_attribute)
+  #if __has_attribute(fallthrough)
+    #define AUNIT_FALLTHROUGH __attribute__((fallthrough))
+  #endif
+#endif
+#ifndef AUNIT_FALLTHROUGH
+  #define AUNIT_FALLTHROUGH do {} while (false)
+#endif
+
+namespace aunit {
+
+/**
+ * A TestAgain whose body, defined by the asyncTest() macro, is a stackless
+ * coroutine. The body is the run() method, delimited by AUNIT_ASYNC_BEGIN()
+ * and AUNIT_ASYNC_END(), which form a switch statement on the line number
+ * where the body was suspended. The AUNIT_AWAIT() and AUNIT_SLEEP() macros
+ * record their own line number and return, and the next call to run() jumps
+ * back to that line. Local variables do not survive a suspension, so the
+ * state of the test must be kept in static variables or in the members of a
+ * fixture.
+ *
+ * AUNIT_SLEEP() uses TestAgain::sleepUntil(), so run() is not called again
+ * until the deadline, and the tests waiting on I/O interleave with the other
+ * tests, instead of blocking the TestRunner with delay(). Without
+ * AUNIT_ENABLE_TEST_TIMERS, again() checks the deadline itself instead. The
+ * test passes when the body reaches AUNIT_ASYNC_END() without a failed
+ * assertion.
+ */
+class AsyncTest: public TestAgain {
+  public:
+    /** Constructor. */
+    AsyncTest() {}
+
+    /** Start run() from the beginning. */
+    void setup() override;
+
+    /** Resume run(), and pass at the end of run(). */
+    void again() override;
+
+    /** User-provided body of the test, which can be suspended. */
+    virtual void run() = 0;
+
+  protected:
+    /**
+     * Line number where run() resumes, or 0 at its start. Used by the
+     * AUNIT_ASYNC_BEGIN(), AUNIT_AWAIT() and AUNIT_SLEEP() macros.
+     */
+    uint16_t mResumeLine = 0;
+
+    /** Suspend run() at 'line' for 'durationMillis' milliseconds. */
+    void sleep(uint16_t line, unsigned long durationMillis);
+
+    /**
+     * Start the AUNIT_AWAIT() at 'line', which fails after 'timeoutMillis',
+     * or never if 0.
+     */
+    void await(uint16_t line, unsigned long timeoutMillis);
+
+    /**
+     * Called when the condition of the current AUNIT_AWAIT() is false. Suspend
+     * run(), or fail the test if the timeout of the AUNIT_AWAIT() is over.
+     */
+    void awaitPending(const char* file, uint16_t line,
+        const __FlashStringHelper* condition);
+
+  private:
+    // Disable copy-constructor and assignment operator
+    AsyncTest(const AsyncTest&) = delete;
+    AsyncTest& operator=(const AsyncTest&) = delete;
+
+    unsigned long mStartMillis = 0;
+    unsigned long mWaitMillis = 0;
+    bool mIsSuspended = false;
+  #if ! AUNIT_ENABLE_TEST_TIMERS
+    // The AUNIT_SLEEP() in progress, without TestAgain::sleepUntil().
+    bool mIsSleeping = false;
+  #endif
+};
+
+}
+
+/**
+ * Start the body of an asyncTest(). Must be the first statement of the body,
+ * and matched by AUNIT_ASYNC_END().
+ */
+#define AUNIT_ASYNC_BEGIN() switch (mResumeLine) { case 0:
+
+/** End the body of an asyncTest(). The test passes if it is not done. */
+#define AUNIT_ASYNC_END() }
+
+/**
+ * Suspend the body of an asyncTest() until 'condition' is true, evaluating it
+ * each time the TestRunner visits the test. The test fails if the condition is
+ * still false after 'timeoutMillis' milliseconds (0 for no limit). Only one
+ * AUNIT_AWAIT() or AUNIT_SLEEP() can be used per line.
+ */
+#define AUNIT_AWAIT(condition, timeoutMillis) do {\
+  await(__LINE__, (timeoutMillis));\
+  AUNIT_FALLTHROUGH;\
+  case __LINE__:\
+  if (!(condition)) {\
+    awaitPending(__FILE__, __LINE__, F(#condition));\
+    return;\
+  }\
+} while (false)
+
+/**
+ * Suspend the body of an asyncTest() for 'millis' milliseconds, during which
+ * the other tests keep running. Only one AUNIT_AWAIT() or AUNIT_SLEEP() can be
+ * used per line.
+ */
+#define AUNIT_SLEEP(millis) do {\
+  sleep(__LINE__, (millis));\
+  return;\
+  case __LINE__:;\
+} while (false)
+
+#endif
@@ -0,0 +1,90 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // pgm_read_ptr(), pgm_read_dword()
+#include "Flash.h"
+#include "Baselines.h"
+#if EPOXY_DUINO
+#include "NamedValueFile.h"
+#endif
+
+namespace aunit {
+
+using internal::FCString;
+
+const BaselineEntry* Baselines::sTable = nullptr;
+uint16_t Baselines::sNumEntries = 0;
+
+void Baselines::setTable(const BaselineEntry* table, uint16_t numEntries) {
+  sTable = table;
+  sNumEntries = numEntries;
+}
+
+#if EPOXY_DUINO
+
+bool Baselines::sIsUpdating = false;
+
+namespace {
+
+/** Baselines read from the file, in file order, followed by new entries. */
+internal::NamedValueFile baselinesFile;
+
+}
+
+bool Baselines::load(const char* fileName) {
+  return baselinesFile.load(fileName);
+}
+
+bool Baselines::hasFile() {
+  return baselinesFile.hasFile();
+}
+
+void Baselines::record(const FCString& name, uint32_t nanos) {
+  baselinesFile.record(name, nanos);
+}
+
+bool Baselines::save() {
+  if (!sIsUpdating || !baselinesFile.hasFile()) return true;
+  return baselinesFile.save("baselines");
+}
+
+#endif
+
+bool Baselines::find(const FCString& name, uint32_t& nanos) {
+#if EPOXY_DUINO
+  if (baselinesFile.find(name, nanos)) return true;
+#endif
+
+  for (uint16_t i = 0; i < sNumEntries; i++) {
+    const BaselineEntry* entry = &sTable[i];
+    const char* entryName = (const char*) pgm_read_ptr(&entry->name);
+    if (name.compareTo(FCString(AUNIT_FPSTR(entryName))) == 0) {
+      nanos = pgm_read_dword(&entry->nanos);
+      return true;
+    }
+  }
+  return false;
+}
+
+}
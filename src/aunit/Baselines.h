@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_BASELINES_H
+#define AUNIT_BASELINES_H
+
+#include <stdint.h>
+#include "FCString.h"
+
+namespace aunit {
+
+/**
+ * An entry of a compiled-in table of benchmark baselines, stored in PROGMEM
+ * along with the string pointed to by 'name'. For example:
+ *
+ * @code
+ * static const char kCrc16[] PROGMEM = "crc16";
+ * static const aunit::BaselineEntry kBaselines[] PROGMEM = {
+ *   {kCrc16, 2756},
+ * };
+ * ...
+ * aunit::Baselines::setTable(kBaselines,
+ *     sizeof(kBaselines) / sizeof(kBaselines[0]));
+ * @endcode
+ */
+struct BaselineEntry {
+  /** Name of the benchmark, in PROGMEM. */
+  const char* name;
+
+  /** Baseline median time per iteration, in nanoseconds. */
+  uint32_t nanos;
+};
+
+/**
+ * The registry of benchmark baselines used by assertNoRegression(). The
+ * baselines come from a compiled-in table set by setTable(), and on
+ * EpoxyDuino, from a text file given by the '--baselines' flag, which takes
+ * precedence. The file contains one "name nanos" pair per line, and is
+ * rewritten with the measured medians when the '--update-baselines' flag is
+ * given.
+ */
+class Baselines {
+  public:
+    /** Set the compiled-in table of baselines, stored in PROGMEM. */
+    static void setTable(const BaselineEntry* table, uint16_t numEntries);
+
+    /**
+     * Find the baseline of the benchmark with the given name. Return true and
+     * set 'nanos' if found.
+     */
+    static bool find(const internal::FCString& name, uint32_t& nanos);
+
+  #if EPOXY_DUINO
+    /**
+     * Read the baselines from the given file, which becomes the destination of
+     * save(). A missing file is treated as empty. Return false if the file
+     * exists but cannot be read.
+     */
+    static bool load(const char* fileName);
+
+    /** Return true if the baselines are being updated instead of checked. */
+    static bool isUpdating() { return sIsUpdating; }
+
+    /** Enable the update of the baselines file by save(). */
+    static void setUpdating(bool isUpdating) { sIsUpdating = isUpdating; }
+
+    /** Return true if a file was given by load(). */
+    static bool hasFile();
+
+    /** Record the measured time of a benchmark, written by save(). */
+    static void record(const internal::FCString& name, uint32_t nanos);
+
+    /**
+     * If updating, write the baselines to the file given by load(), through a
+     * temporary file which replaces the original. Return false on error.
+     */
+    static bool save();
+  #endif
+
+  private:
+    static const BaselineEntry* sTable;
+    static uint16_t sNumEntries;
+  #if EPOXY_DUINO
+    static bool sIsUpdating;
+  #endif
+};
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // micros()
+#include "Baselines.h"
+#include "Benchmark.h"
+#include "print_util.h"
+
+namespace aunit {
+
+using internal::printLocation;
+
+namespace {
+
+/**
+ * Convert the elapsed micros of a sample into nanoseconds per iteration,
+ * rounded to the nearest integer, without overflowing 32 bits and without the
+ * 64-bit division which is expensive on 8-bit processors.
+ */
+uint32_t toNanosPerIteration(unsigned long elapsedMicros, uint32_t iterations) {
+  if (elapsedMicros < 0xFFFFFFFFUL / 1000) {
+    return (elapsedMicros * 1000 + iterations / 2) / iterations;
+  } else {
+    return (elapsedMicros / iterations) * 1000;
+  }
+}
+
+/** Insertion sort, good enough for the small number of samples. */
+void sortSamples(uint32_t samples[], uint16_t n) {
+  for (uint16_t i = 1; i < n; i++) {
+    uint32_t value = samples[i];
+    uint16_t j = i;
+    for (; j > 0 && samples[j - 1] > value; j--) {
+      samples[j] = samples[j - 1];
+    }
+    samples[j] = value;
+  }
+}
+
+}
+
+unsigned long Benchmark::timeIterations(uint32_t iterations) {
+  unsigned long start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    iterate();
+  }
+  return micros() - start;
+}
+
+uint32_t Benchmark::calibrate() {
+  uint32_t iterations = 1;
+  while (iterations < kMaxIterations
+      && timeIterations(iterations) < AUNIT_BENCHMARK_SAMPLE_MICROS) {
+    iterations *= 2;
+  }
+  return iterations;
+}
+
+void Benchmark::once() {
+  const uint16_t n = AUNIT_BENCHMARK_SAMPLES;
+  uint32_t samples[n];
+
+  mIterations = calibrate();
+  for (uint16_t i = 0; i < n; i++) {
+    samples[i] = toNanosPerIteration(timeIterations(mIterations), mIterations);
+  }
+  sortSamples(samples, n);
+
+  // Nearest-rank percentiles.
+  mMinNanos = samples[0];
+  mMedianNanos = samples[(n - 1) / 2];
+  mP99Nanos = samples[(99 * (uint32_t) n + 99) / 100 - 1];
+
+  printResult();
+#if EPOXY_DUINO
+  if (Baselines::isUpdating()) Baselines::record(getName(), mMedianNanos);
+#endif
+
+  verify();
+}
+
+void Benchmark::printResult() const {
+  if (!isVerbosity(Verbosity::kTestPassed)) return;
+
+  Print* printer = beginMessage();
+  printer->print(F("Benchmark "));
+  getName().print(printer);
+  printer->print(F(": min "));
+  printer->print(mMinNanos);
+  printer->print(F(" ns/op, median "));
+  printer->print(mMedianNanos);
+  printer->print(F(" ns/op, p99 "));
+  printer->print(mP99Nanos);
+  printer->print(F(" ns/op ("));
+  printer->print(AUNIT_BENCHMARK_SAMPLES);
+  printer->print(F(" samples of "));
+  printer->print(mIterations);
+  printer->println(F(" iterations)"));
+  endMessage();
+}
+
+namespace {
+
+/** Print the "file:line: Assertion passed/failed: " prefix. */
+void printAssertionHead(Print* printer, bool ok, const char* file,
+    uint16_t line) {
+  printLocation(printer, file, line);
+  printer->print(F("Assertion "));
+  printer->print(ok ? F("passed") : F("failed"));
+  printer->print(F(": "));
+}
+
+/**
+ * Return baseline * (100 + tolerancePct) / 100, without overflowing 32 bits
+ * for baselines up to a few seconds per iteration.
+ */
+uint32_t applyTolerance(uint32_t baseline, uint16_t tolerancePct) {
+  return baseline + (baseline / 100) * tolerancePct
+      + (baseline % 100) * tolerancePct / 100;
+}
+
+}
+
+bool Benchmark::assertionFasterThan(const char* file, uint16_t line,
+    uint32_t maxNanos) {
+  if (isDone()) return false;
+  bool ok = mMedianNanos < maxNanos;
+  if (isOutputEnabled(ok)) {
+    // Prints something like:
+    // Test.ino:42: Assertion failed: median (130 ns/op) < (100 ns/op).
+    Print* printer = beginMessage();
+    printAssertionHead(printer, ok, file, line);
+    printer->print(F("median ("));
+    printer->print(mMedianNanos);
+    printer->print(F(" ns/op) < ("));
+    printer->print(maxNanos);
+    printer->println(F(" ns/op)."));
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+bool Benchmark::assertionNoRegression(const char* file, uint16_t line,
+    const internal::FCString& name, uint16_t tolerancePct) {
+  if (isDone()) return false;
+
+  uint32_t baseline;
+  bool hasBaseline = Baselines::find(name, baseline);
+#if EPOXY_DUINO
+  bool isChecked = hasBaseline && !Baselines::isUpdating();
+#else
+  bool isChecked = hasBaseline;
+#endif
+  uint32_t limit = isChecked ? applyTolerance(baseline, tolerancePct) : 0;
+  bool ok = !isChecked || mMedianNanos <= limit;
+
+  if (isOutputEnabled(ok)) {
+    // Prints something like:
+    // Test.ino:42: Assertion failed: median (130 ns/op) <= baseline crc16
+    // (100 ns/op) + 10%.
+    Print* printer = beginMessage();
+    printAssertionHead(printer, ok, file, line);
+    if (!isChecked) {
+      printer->print(hasBaseline ? F("updating baseline ") : F("no baseline "));
+      name.print(printer);
+      printer->println('.');
+    } else {
+      printer->print(F("median ("));
+      printer->print(mMedianNanos);
+      printer->print(F(" ns/op) <= baseline "));
+      name.print(printer);
+      printer->print(F(" ("));
+      printer->print(baseline);
+      printer->print(F(" ns/op) + "));
+      printer->print(tolerancePct);
+      printer->println(F("%."));
+    }
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+}
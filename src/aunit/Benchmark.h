@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_BENCHMARK_H
+#define AUNIT_BENCHMARK_H
+
+#include <stdint.h>
+#include "Config.h"
+#include "TestOnce.h"
+
+namespace aunit {
+
+/**
+ * A TestOnce which measures the time taken by the user-provided iterate()
+ * method, normally defined by the benchmark() or benchmarkF() macros. The
+ * number of iterations per sample is first calibrated so that a sample lasts
+ * at least AUNIT_BENCHMARK_SAMPLE_MICROS, then AUNIT_BENCHMARK_SAMPLES samples
+ * are taken. The min, median and p99 of the time per iteration are computed
+ * using only integer arithmetic, in nanoseconds, and printed through the
+ * Printer.
+ */
+class Benchmark: public TestOnce {
+  public:
+    /** Constructor. */
+    Benchmark() {}
+
+    /**
+     * Calibrate, take the samples, print the result, record it as the new
+     * baseline if the baselines are being updated, then call verify().
+     */
+    void once() override;
+
+    /** User-provided code to benchmark, called many times. */
+    virtual void iterate() = 0;
+
+    /** Return the minimum time per iteration in nanoseconds. */
+    uint32_t getMinNanos() const { return mMinNanos; }
+
+    /** Return the median time per iteration in nanoseconds. */
+    uint32_t getMedianNanos() const { return mMedianNanos; }
+
+    /** Return the 99th percentile time per iteration in nanoseconds. */
+    uint32_t getP99Nanos() const { return mP99Nanos; }
+
+    /** Return the number of iterations per sample chosen by calibration. */
+    uint32_t getIterations() const { return mIterations; }
+
+    /**
+     * Prevent the compiler from optimizing away the computation of 'value'
+     * inside iterate(), without adding any instruction.
+     */
+    template <typename T>
+    static void doNotOptimize(const T& value) {
+      asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+  protected:
+    /**
+     * Optional user-provided check of the results, called after the
+     * measurement. Overridden in a benchmarkF() fixture to use the
+     * assertFasterThan() and assertNoRegression() macros.
+     */
+    virtual void verify() {}
+
+    /** Used by assertFasterThan(). Compares the median to maxNanos. */
+    bool assertionFasterThan(const char* file, uint16_t line,
+        uint32_t maxNanos);
+
+    /**
+     * Used by assertNoRegression(). Compares the median to the baseline of the
+     * given name from Baselines, plus tolerancePct percent. Passes if there is
+     * no baseline, or if the baselines are being updated.
+     */
+    bool assertionNoRegression(const char* file, uint16_t line,
+        const internal::FCString& name, uint16_t tolerancePct);
+
+  private:
+    /** Upper bound on the number of iterations per sample. */
+    static const uint32_t kMaxIterations = 0x1000000;
+
+    // Disable copy-constructor and assignment operator
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    /** Return the micros() elapsed while calling iterate() 'iterations' times. */
+    unsigned long timeIterations(uint32_t iterations);
+
+    /** Find the number of iterations which fills a sample. */
+    uint32_t calibrate();
+
+    /** Print the result of the benchmark, if kTestPassed is enabled. */
+    void printResult() const;
+
+    uint32_t mMinNanos = 0;
+    uint32_t mMedianNanos = 0;
+    uint32_t mP99Nanos = 0;
+    uint32_t mIterations = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file BenchmarkMacros.h
+ *
+ * Assertion macros which check the results of a benchmark. They can be used
+ * only inside the verify() method of a Benchmark fixture defined with
+ * benchmarkF(), after the measurement. A failure marks the benchmark as
+ * failed, like any other assertion.
+ */
+
+#ifndef AUNIT_BENCHMARK_MACROS_H
+#define AUNIT_BENCHMARK_MACROS_H
+
+/** Assert that the median time per iteration is less than maxNanos. */
+#define assertFasterThan(maxNanos) do {\
+  if (!assertionFasterThan(__FILE__, __LINE__, (maxNanos)))\
+    return;\
+} while (false)
+
+/**
+ * Assert that the median time per iteration is no more than tolerancePct
+ * percent slower than the stored baseline (see aunit::Baselines). Two versions
+ * are supported: assertNoRegression(tolerancePct) uses the baseline with the
+ * name of the current benchmark, and assertNoRegression(name, tolerancePct)
+ * uses the baseline of the given name.
+ */
+#define assertNoRegression(...)\
+  get_assertNoRegression(__VA_ARGS__, assertNoRegression2, assertNoRegression1)\
+      (__VA_ARGS__)
+#define get_assertNoRegression(_1, _2, NAME, ...) NAME
+
+#define assertNoRegression1(tolerancePct) do {\
+  if (!assertionNoRegression(__FILE__, __LINE__, getName(), (tolerancePct)))\
+    return;\
+} while (false)
+
+#define assertNoRegression2(name, tolerancePct) do {\
+  if (!assertionNoRegression(__FILE__, __LINE__,\
+      aunit::internal::FCString(name), (tolerancePct)))\
+    return;\
+} while (false)
+
+#endif
@@ -0,0 +1,268 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Arduino.h> // Print
+#include "Config.h"
+#include "Printer.h"
+#include "Test.h"
+#include "print_util.h"
+#include "BinaryReporter.h"
+
+namespace aunit {
+
+namespace {
+
+/** The types of the records. See BinaryReporter. */
+enum RecordType : uint8_t {
+  kStart = 0x01,
+  kTest = 0x02,
+  kFile = 0x03,
+  kMessage = 0x04,
+  kAssertionMessage = 0x05,
+  kResult = 0x06,
+  kEnd = 0x07,
+  kRepeat = 0x08,
+};
+
+/** The bits of the flags of a result record, above the Test::Status. */
+const uint8_t kTestTimeoutFlag = 0x08;
+const uint8_t kTimingFlag = 0x10;
+const uint8_t kHeapFlag = 0x20;
+const uint8_t kStackFlag = 0x40;
+
+/** Write the 'value' as an unsigned LEB128 varint. */
+void writeVarint(Print* printer, unsigned long value) {
+  while (value >= 0x80) {
+    printer->write((uint8_t) (value | 0x80));
+    value >>= 7;
+  }
+  printer->write((uint8_t) value);
+}
+
+/** Write the NUL-terminated name of the test, or an empty name. */
+void writeName(Print* printer, const Test* test) {
+  if (test) test->getName().print(printer);
+  printer->write((uint8_t) 0);
+}
+
+/**
+ * A Print which forwards the text of a message to the Printer, after the
+ * header of a message record which is written lazily, so that an empty
+ * message costs nothing. The trailing newline of the message is dropped by
+ * deferring each newline until the next character arrives, and the decoder
+ * adds it back. The NUL and carriage return characters are dropped, since the
+ * NUL terminates the text.
+ */
+class MessagePrint: public Print {
+  public:
+    void begin(Print* printer) {
+      mPrinter = printer;
+      mIsOpen = false;
+      mHasNewline = false;
+    }
+
+    /** Mark the header as written by BinaryReporter::printLocation(). */
+    void open() { mIsOpen = true; }
+
+    /** Terminate the text if any was written. */
+    void end() {
+      if (mIsOpen) mPrinter->write((uint8_t) 0);
+      mIsOpen = false;
+      mHasNewline = false;
+    }
+
+    size_t write(uint8_t c) override {
+      if (c == '\0' || c == '\r') return 1;
+      if (!mIsOpen) {
+        mPrinter->write((uint8_t) kMessage);
+        mIsOpen = true;
+      }
+      if (mHasNewline) {
+        mPrinter->write('\n');
+        mHasNewline = false;
+      }
+      if (c == '\n') {
+        mHasNewline = true;
+      } else {
+        mPrinter->write(c);
+      }
+      return 1;
+    }
+
+  private:
+    Print* mPrinter = nullptr;
+    bool mIsOpen = false;
+    bool mHasNewline = false;
+};
+
+AUNIT_THREAD_LOCAL MessagePrint messagePrint;
+
+// The test of the current block of records, whose name was already sent.
+// Each result record ends the block.
+AUNIT_THREAD_LOCAL const Test* openTest = nullptr;
+
+/**
+ * Start the block of records of the 'test' if it is not already open. The
+ * paths of the files are sent again in each block, since the blocks of
+ * --jobs are flushed out of order, and the worker processes of --isolate
+ * assign their own ids.
+ */
+void openBlock(Print* printer, const Test* test) {
+  if (test == openTest) return;
+  printer->write((uint8_t) kTest);
+  writeName(printer, test);
+  internal::resetPrintedFiles();
+  openTest = test;
+}
+
+}
+
+void BinaryReporter::beginRun(uint16_t numTests, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  openTest = nullptr;
+  printer->write((uint8_t) kStart);
+  printer->write('A');
+  printer->write('U');
+  printer->write(kVersion);
+  writeVarint(printer, numTests);
+  writeVarint(printer, Test::getDisplayMinPosition());
+}
+
+Print* BinaryReporter::beginMessage(const Test* test) {
+  Print* printer = Printer::getBufferedPrinter();
+  openBlock(printer, test);
+  messagePrint.begin(printer);
+  return &messagePrint;
+}
+
+void BinaryReporter::endMessage() {
+  messagePrint.end();
+}
+
+void BinaryReporter::printLocation(Print* /*printer*/, const char* file,
+    uint16_t line) {
+  Print* printer = Printer::getBufferedPrinter();
+  bool isNew;
+  uint8_t id = internal::internFile(file, isNew);
+  if (isNew) {
+    printer->write((uint8_t) kFile);
+    writeVarint(printer, id);
+    printer->print(file);
+    printer->write((uint8_t) 0);
+  }
+  printer->write((uint8_t) kAssertionMessage);
+  writeVarint(printer, id);
+  if (id == 0) {
+    printer->print(file);
+    printer->write((uint8_t) 0);
+  }
+  writeVarint(printer, line);
+  messagePrint.open();
+}
+
+void BinaryReporter::endTest(const Test& test, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  openBlock(printer, &test);
+  openTest = nullptr;
+
+  uint8_t flags = (uint8_t) test.getStatus();
+  if (test.isTestTimeout()) flags |= kTestTimeoutFlag;
+  if (test.isStarted()) {
+#if AUNIT_ENABLE_TIMING
+    flags |= kTimingFlag;
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+    flags |= kHeapFlag;
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+    flags |= kStackFlag;
+#endif
+  }
+  printer->write((uint8_t) kResult);
+  printer->write(flags);
+
+#if AUNIT_ENABLE_TIMING
+  if (flags & kTimingFlag) {
+    writeVarint(printer, test.getTiming().totalMicros());
+  }
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+  if (flags & kHeapFlag) {
+    const Test::HeapUsage& usage = test.getHeapUsage();
+    writeVarint(printer, usage.allocCount);
+    writeVarint(printer, usage.allocBytes);
+    writeVarint(printer, usage.peakBytes);
+    // Zigzag encoding, since the bytes in use may be negative.
+    writeVarint(printer, ((unsigned long) usage.inUseBytes << 1)
+        ^ (unsigned long) (usage.inUseBytes >> (sizeof(long) * 8 - 1)));
+  }
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+  if (flags & kStackFlag) {
+    writeVarint(printer, test.getStackUsage());
+  }
+#endif
+}
+
+void BinaryReporter::endRun(const RunSummary& summary,
+    Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->write((uint8_t) kEnd);
+  writeVarint(printer, summary.count);
+  writeVarint(printer, summary.passedCount);
+  writeVarint(printer, summary.failedCount);
+  writeVarint(printer, summary.skippedCount);
+  writeVarint(printer, summary.expiredCount);
+  writeVarint(printer, summary.testTimeoutCount);
+  writeVarint(printer, summary.durationMillis);
+}
+
+void BinaryReporter::endRepeat(const RepeatSummary& summary,
+    Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->write((uint8_t) kRepeat);
+  writeVarint(printer, summary.iterationCount);
+  writeVarint(printer, summary.failedIterationCount);
+  writeVarint(printer, summary.durationMillis);
+
+  uint16_t count = 0;
+#if AUNIT_ENABLE_REPEAT_STATS
+  for (Test* test = summary.tests; test != nullptr; test = *test->getNext()) {
+    if (test->getRepeatStats().failedCount > 0) count++;
+  }
+#endif
+  writeVarint(printer, count);
+#if AUNIT_ENABLE_REPEAT_STATS
+  for (Test* test = summary.tests; test != nullptr; test = *test->getNext()) {
+    const Test::RepeatStats& stats = test->getRepeatStats();
+    if (stats.failedCount == 0) continue;
+    writeName(printer, test);
+    writeVarint(printer, stats.passedCount);
+    writeVarint(printer, stats.failedCount);
+  }
+#endif
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_BINARY_REPORTER_H
+#define AUNIT_BINARY_REPORTER_H
+
+#include "Reporter.h"
+
+namespace aunit {
+
+/**
+ * A Reporter which writes a compact binary stream of records, to be decoded
+ * on the host into the text or JUnit output by tools/aunit_decode.py. The
+ * name of each test and the path of each source file are sent only once per
+ * block of records of a test, and the numbers are sent as unsigned LEB128
+ * varints, which cuts the traffic of a slow serial port, especially with
+ * Verbosity::kAssertionAll.
+ *
+ * Each record starts with a type byte, and the strings end with a NUL:
+ *
+ *  * 0x01 start: 'A', 'U', version 1, numTests, width of the test names
+ *  * 0x02 test: name. The following messages and the result belong to it.
+ *  * 0x03 file: id, path. Sent before the first record of the block which
+ *    uses the id.
+ *  * 0x04 message: text, without its trailing newline
+ *  * 0x05 assertion message: file id, (path if the id is 0,) line, text
+ *  * 0x06 result: flags, [micros], [allocs, bytes, peak, zigzag inUse],
+ *    [stack]. The bits 0-2 of the flags are the Test::Status, bit 3 is
+ *    set if the test exceeded its own timeout, and the bits 4-6 tell if the
+ *    optional fields are present.
+ *  * 0x07 end: tests, passed, failed, skipped, expired, testTimeouts, millis
+ *  * 0x08 repeat: iterations, failed, millis, count, and 'count' times the
+ *    name, passed and failed counts of the tests which failed at least once
+ *
+ * The test name is sent again for each test of a parallel run, because the
+ * output of the worker threads is interleaved one test at a time. The ids of
+ * the files are valid only in the block which defines them, since each worker
+ * process of an isolated run assigns its own ids. The bytes outside of a
+ * record, for example the text printed to Serial by the tests, are passed
+ * through by the decoder.
+ */
+class BinaryReporter: public Reporter {
+  public:
+    /** Version of the stream in the start record. */
+    static const uint8_t kVersion = 1;
+
+    /** Constructor. */
+    BinaryReporter() {}
+
+    void beginRun(uint16_t numTests, Verbosity verbosity) override;
+
+    Print* beginMessage(const Test* test) override;
+
+    void endMessage() override;
+
+    void printLocation(Print* printer, const char* file, uint16_t line)
+        override;
+
+    void endTest(const Test& test, Verbosity verbosity) override;
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override;
+
+    void endRepeat(const RepeatSummary& summary, Verbosity verbosity)
+        override;
+};
+
+}
+
+#endif
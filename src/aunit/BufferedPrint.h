@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_BUFFERED_PRINT_H
+#define AUNIT_BUFFERED_PRINT_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include <Print.h>
+
+namespace aunit {
+namespace internal {
+
+/**
+ * A Print which collects the characters into a fixed buffer of SIZE bytes,
+ * and forwards them to the target Print with a single
+ * write(const uint8_t*, size_t) call when a newline is written or when the
+ * buffer is full. The AUnit messages are composed of many small print()
+ * calls, and this avoids a virtual write() call for each character on the
+ * target (e.g. HardwareSerial), which may also block on the UART.
+ *
+ * The characters of an incomplete line stay in the buffer until
+ * flushBuffer() is called. The flush() method is not used for this, because
+ * it is not virtual on some platforms (ESP32, STM32).
+ */
+template <uint16_t SIZE>
+class BufferedPrint: public Print {
+  public:
+    /** Return the target Print. */
+    Print* getTarget() const { return mTarget; }
+
+    /** Flush the buffer, then set the target Print. */
+    void setTarget(Print* target) {
+      flushBuffer();
+      mTarget = target;
+    }
+
+    size_t write(uint8_t c) override {
+      append(c);
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+      for (size_t i = 0; i < size; i++) {
+        append(buffer[i]);
+      }
+      return size;
+    }
+
+    /** Write the buffered characters to the target. */
+    void flushBuffer() {
+      if (mLength == 0) return;
+      if (mTarget) mTarget->write(mBuffer, mLength);
+      mLength = 0;
+    }
+
+  private:
+    void append(uint8_t c) {
+      mBuffer[mLength++] = c;
+      if (c == '\n' || mLength >= SIZE) flushBuffer();
+    }
+
+    Print* mTarget = nullptr;
+    uint16_t mLength = 0;
+    uint8_t mBuffer[SIZE];
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <string.h> // memcpy()
+#include "Flash.h" // memcpy_P()
+#include "ByteSource.h"
+
+#if EPOXY_DUINO
+  #include <fcntl.h> // open()
+  #include <sys/mman.h> // mmap()
+  #include <sys/stat.h> // fstat()
+  #include <unistd.h> // close()
+#endif
+
+namespace aunit {
+
+size_t MemorySource::read(uint8_t* buffer, size_t size) {
+  if (size > mSize) size = mSize;
+  memcpy(buffer, mData, size);
+  mData += size;
+  mSize -= size;
+  return size;
+}
+
+size_t FlashSource::read(uint8_t* buffer, size_t size) {
+  if (size > mSize) size = mSize;
+  memcpy_P(buffer, mData, size);
+  mData += size;
+  mSize -= size;
+  return size;
+}
+
+#if EPOXY_DUINO
+
+FileSource::FileSource(const char* fileName) {
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0) {
+    if (st.st_size == 0) {
+      // mmap() rejects an empty mapping.
+      mIsEmpty = true;
+    } else {
+      void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        mData = (const uint8_t*) data;
+        mSize = st.st_size;
+        // The data is read front to back, exactly once.
+        madvise(data, mSize, MADV_SEQUENTIAL);
+      }
+    }
+  }
+  close(fd);
+}
+
+FileSource::~FileSource() {
+  if (mData != nullptr) munmap((void*) mData, mSize);
+}
+
+size_t FileSource::read(uint8_t* buffer, size_t size) {
+  size_t remaining = mSize - mPosition;
+  if (size > remaining) size = remaining;
+  if (size == 0) return 0;
+  memcpy(buffer, mData + mPosition, size);
+  mPosition += size;
+  return size;
+}
+
+#endif
+
+}
@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_BYTE_SOURCE_H
+#define AUNIT_BYTE_SOURCE_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+
+class __FlashStringHelper;
+
+namespace aunit {
+
+/**
+ * A stream of bytes compared by assertStreamEqual(). The bytes are read in
+ * chunks into a fixed buffer (AUNIT_STREAM_CHUNK_SIZE), so data which is too
+ * large for RAM (e.g. a PROGMEM table, a file, or the output of a codec) can
+ * be compared with constant memory. Each source can be read only once.
+ */
+class ByteSource {
+  public:
+    /**
+     * Copy up to 'size' bytes into 'buffer', and return the number of bytes
+     * copied, which may be less than 'size'. Return 0 at the end of the data.
+     */
+    virtual size_t read(uint8_t* buffer, size_t size) = 0;
+
+  protected:
+    ~ByteSource() = default;
+};
+
+/** Bytes in RAM. */
+class MemorySource: public ByteSource {
+  public:
+    MemorySource(const void* data, size_t size) :
+        mData((const uint8_t*) data),
+        mSize(size) {}
+
+    size_t read(uint8_t* buffer, size_t size) override;
+
+  private:
+    const uint8_t* mData;
+    size_t mSize;
+};
+
+/**
+ * Bytes in flash memory, e.g. a PROGMEM table cast with
+ * AUNIT_FPSTR(table). Read with memcpy_P(), which handles the alignment
+ * required on the ESP8266.
+ */
+class FlashSource: public ByteSource {
+  public:
+    FlashSource(const __FlashStringHelper* data, size_t size) :
+        mData((const uint8_t*) data),
+        mSize(size) {}
+
+    size_t read(uint8_t* buffer, size_t size) override;
+
+  private:
+    const uint8_t* mData;
+    size_t mSize;
+};
+
+/**
+ * Bytes produced on demand by a callback, which has the same contract as
+ * ByteSource::read(). The 'context' is passed through to the callback.
+ */
+class CallbackSource: public ByteSource {
+  public:
+    typedef size_t (*Producer)(void* context, uint8_t* buffer, size_t size);
+
+    explicit CallbackSource(Producer producer, void* context = nullptr) :
+        mProducer(producer),
+        mContext(context) {}
+
+    size_t read(uint8_t* buffer, size_t size) override {
+      return mProducer(mContext, buffer, size);
+    }
+
+  private:
+    Producer mProducer;
+    void* mContext;
+};
+
+#if EPOXY_DUINO
+
+/**
+ * Contents of a file, memory-mapped on EpoxyDuino so that only the pages
+ * being compared are loaded. A file which cannot be opened is reported by
+ * isOpen(), and reads as empty.
+ */
+class FileSource: public ByteSource {
+  public:
+    explicit FileSource(const char* fileName);
+    ~FileSource();
+
+    /** Return true if the file was opened and mapped. */
+    bool isOpen() const { return mData != nullptr || mIsEmpty; }
+
+    /** Size of the file. */
+    size_t size() const { return mSize; }
+
+    size_t read(uint8_t* buffer, size_t size) override;
+
+  private:
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    const uint8_t* mData = nullptr;
+    size_t mSize = 0;
+    size_t mPosition = 0;
+    bool mIsEmpty = false;
+};
+
+#endif
+
+}
+
+#endif
@@ -113,13 +113,26 @@ against each other will work for all 3 environments.
 
 Inlining:
 --------
-Even though most of these functions are one-liners, there is no advantage to
-inlining them because they are almost always used through a function pointer.
+The functions for the primitive types are defined inline in the header. They
+are still passed as function pointers to the assertion() methods, but those
+are inline too, so the pointer is a compile-time constant at the call site of
+the assertXxx() macro, and the compiler replaces the indirect call with the
+comparison itself. The functions for the string types are not worth inlining
+because they call the out-of-line compareString() functions anyway.
+
+Arrays:
+-------
+The array assertions compare the whole buffer in one call instead of one
+assertion per element. The integer arrays are compared as raw memory with
+memcmp(), which is the fastest compare available on every platform. The
+floating point arrays cannot be compared that way (0.0 == -0.0, NaN != NaN),
+so findMismatch() and findNotNear() compare them in blocks that the compiler
+can vectorize. In all cases, only the index of the first mismatch is
+returned, which is all that the assertion message needs.
 */
 
 #include <stdint.h>
 #include <string.h>
-#include <math.h> // fabs()
 #include <WString.h>
 #include "Flash.h"
 #include "Compare.h"
@@ -397,46 +410,6 @@ bool compareSubstring(
 // compareEqual()
 //---------------------------------------------------------------------------
 
-bool compareEqual(bool a, bool b) {
-  return (a == b);
-}
-
-bool compareEqual(char a, char b) {
-  return (a == b);
-}
-
-bool compareEqual(int a, int b) {
-  return (a == b);
-}
-
-bool compareEqual(unsigned int a, unsigned int b) {
-  return (a == b);
-}
-
-bool compareEqual(long a, long b) {
-  return (a == b);
-}
-
-bool compareEqual(unsigned long a, unsigned long b) {
-  return (a == b);
-}
-
-bool compareEqual(long long a, long long b) {
-  return (a == b);
-}
-
-bool compareEqual(unsigned long long a, unsigned long long b) {
-  return (a == b);
-}
-
-bool compareEqual(double a, double b) {
-  return (a == b);
-}
-
-bool compareEqual(const void* a, const void* b) {
-  return (a == b);
-}
-
 bool compareEqual(const char* a, const char* b) {
   return compareString(a, b) == 0;
 }
@@ -477,42 +450,6 @@ bool compareEqual(const String& a, const __FlashStringHelper* b) {
 // compareLess()
 //---------------------------------------------------------------------------
 
-bool compareLess(bool a, bool b) {
-  return (a < b);
-}
-
-bool compareLess(char a, char b) {
-  return (a < b);
-}
-
-bool compareLess(int a, int b) {
-  return (a < b);
-}
-
-bool compareLess(unsigned int a, unsigned int b) {
-  return (a < b);
-}
-
-bool compareLess(long a, long b) {
-  return (a < b);
-}
-
-bool compareLess(unsigned long a, unsigned long b) {
-  return (a < b);
-}
-
-bool compareLess(long long a, long long b) {
-  return (a < b);
-}
-
-bool compareLess(unsigned long long a, unsigned long long b) {
-  return (a < b);
-}
-
-bool compareLess(double a, double b) {
-  return (a < b);
-}
-
 bool compareLess(const char* a, const char* b) {
   return compareString(a, b) < 0;
 }
@@ -554,42 +491,6 @@ bool compareLess(const String& a, const __FlashStringHelper* b) {
 // compareMore()
 //---------------------------------------------------------------------------
 
-bool compareMore(bool a, bool b) {
-  return (a > b);
-}
-
-bool compareMore(char a, char b) {
-  return (a > b);
-}
-
-bool compareMore(int a, int b) {
-  return (a > b);
-}
-
-bool compareMore(unsigned int a, unsigned int b) {
-  return (a > b);
-}
-
-bool compareMore(long a, long b) {
-  return (a > b);
-}
-
-bool compareMore(unsigned long a, unsigned long b) {
-  return (a > b);
-}
-
-bool compareMore(long long a, long long b) {
-  return (a > b);
-}
-
-bool compareMore(unsigned long long a, unsigned long long b) {
-  return (a > b);
-}
-
-bool compareMore(double a, double b) {
-  return (a > b);
-}
-
 bool compareMore(const char* a, const char* b) {
   return compareString(a, b) > 0;
 }
@@ -630,42 +531,6 @@ bool compareMore(const String& a, const __FlashStringHelper* b) {
 // compareLessOrEqual
 //---------------------------------------------------------------------------
 
-bool compareLessOrEqual(bool a, bool b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(char a, char b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(int a, int b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(unsigned int a, unsigned int b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(long a, long b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(unsigned long a, unsigned long b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(long long a, long long b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(unsigned long long a, unsigned long long b) {
-  return (a <= b);
-}
-
-bool compareLessOrEqual(double a, double b) {
-  return (a <= b);
-}
-
 bool compareLessOrEqual(const char* a, const char* b) {
   return compareString(a, b) <= 0;
 }
@@ -707,42 +572,6 @@ bool compareLessOrEqual(const String& a, const __FlashStringHelper* b) {
 // compareMoreOrEqual
 //---------------------------------------------------------------------------
 
-bool compareMoreOrEqual(bool a, bool b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(char a, char b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(int a, int b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(unsigned int a, unsigned int b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(long a, long b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(unsigned long a, unsigned long b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(long long a, long long b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(unsigned long long a, unsigned long long b) {
-  return (a >= b);
-}
-
-bool compareMoreOrEqual(double a, double b) {
-  return (a >= b);
-}
-
 bool compareMoreOrEqual(const char* a, const char* b) {
   return compareString(a, b) >= 0;
 }
@@ -784,46 +613,6 @@ bool compareMoreOrEqual(const String& a, const __FlashStringHelper* b) {
 // compareNotEqual
 //---------------------------------------------------------------------------
 
-bool compareNotEqual(bool a, bool b) {
-  return (a != b);
-}
-
-bool compareNotEqual(char a, char b) {
-  return (a != b);
-}
-
-bool compareNotEqual(int a, int b) {
-  return (a != b);
-}
-
-bool compareNotEqual(unsigned int a, unsigned int b) {
-  return (a != b);
-}
-
-bool compareNotEqual(long a, long b) {
-  return (a != b);
-}
-
-bool compareNotEqual(unsigned long a, unsigned long b) {
-  return (a != b);
-}
-
-bool compareNotEqual(long long a, long long b) {
-  return (a != b);
-}
-
-bool compareNotEqual(unsigned long long a, unsigned long long b) {
-  return (a != b);
-}
-
-bool compareNotEqual(double a, double b) {
-  return (a != b);
-}
-
-bool compareNotEqual(const void* a, const void* b) {
-  return (a != b);
-}
-
 bool compareNotEqual(const char* a, const char* b) {
   return compareString(a, b) != 0;
 }
@@ -944,47 +733,84 @@ bool compareStringCaseNotEqual(const String& a, const __FlashStringHelper* b) {
 }
 
 //---------------------------------------------------------------------------
-// compareNear()
+// findMismatch() and findNotNear()
 //---------------------------------------------------------------------------
 
-bool compareNear(int a, int b, int error) {
-  return abs(a - b) <= error;
-}
-
-bool compareNear(unsigned int a, unsigned int b, unsigned int error) {
-  return (unsigned int) abs((int)(a - b)) <= error;
+namespace {
+
+// Size of the blocks scanned by the floating point versions. The comparisons
+// within a block are OR'ed together without an early exit, so that the
+// compiler is able to vectorize the loop. Only the block which contains the
+// mismatch is scanned again element by element.
+const size_t kBlockSize = 64;
+
+template <typename T>
+size_t findMismatchT(const T* a, const T* b, size_t n) {
+  for (size_t begin = 0; begin < n; begin += kBlockSize) {
+    size_t end = (n - begin < kBlockSize) ? n : begin + kBlockSize;
+    bool differs = false;
+    for (size_t i = begin; i < end; i++) {
+      differs |= !(a[i] == b[i]);
+    }
+    if (! differs) continue;
+    for (size_t i = begin; i < end; i++) {
+      if (!(a[i] == b[i])) return i;
+    }
+  }
+  return n;
 }
 
-bool compareNear(long a, long b, long error) {
-  return abs(a - b) <= error;
+template <typename T>
+size_t findNotNearT(const T* a, const T* b, size_t n, T error) {
+  for (size_t begin = 0; begin < n; begin += kBlockSize) {
+    size_t end = (n - begin < kBlockSize) ? n : begin + kBlockSize;
+    bool differs = false;
+    for (size_t i = begin; i < end; i++) {
+      differs |= !(fabs(a[i] - b[i]) <= error);
+    }
+    if (! differs) continue;
+    for (size_t i = begin; i < end; i++) {
+      if (!(fabs(a[i] - b[i]) <= error)) return i;
+    }
+  }
+  return n;
 }
 
-bool compareNear(unsigned long a, unsigned long b, unsigned long error) {
-  return (unsigned long) abs((long)(a - b)) <= error;
-}
+} // namespace
 
-bool compareNear(double a, double b, double error) {
-  return fabs(a - b) <= error;
-}
+size_t findMismatch(const void* a, const void* b, size_t size) {
+  // memcmp() is optimized (and usually vectorized) by the C library, so the
+  // common case of equal blocks is a single pass. Locating the mismatch is
+  // done with memcmp() too, one block at a time.
+  if (size == 0 || memcmp(a, b, size) == 0) return size;
 
-bool compareNotNear(int a, int b, int error) {
-  return !compareNear(a, b, error);
+  const uint8_t* pa = (const uint8_t*) a;
+  const uint8_t* pb = (const uint8_t*) b;
+  size_t begin = 0;
+  while (size - begin > kBlockSize
+      && memcmp(pa + begin, pb + begin, kBlockSize) == 0) {
+    begin += kBlockSize;
+  }
+  for (size_t i = begin; i < size; i++) {
+    if (pa[i] != pb[i]) return i;
+  }
+  return size;
 }
 
-bool compareNotNear(unsigned int a, unsigned int b, unsigned int error) {
-  return !compareNear(a, b, error);
+size_t findMismatch(const float* a, const float* b, size_t n) {
+  return findMismatchT(a, b, n);
 }
 
-bool compareNotNear(long a, long b, long error) {
-  return !compareNear(a, b, error);
+size_t findMismatch(const double* a, const double* b, size_t n) {
+  return findMismatchT(a, b, n);
 }
 
-bool compareNotNear(unsigned long a, unsigned long b, unsigned long error) {
-  return !compareNear(a, b, error);
+size_t findNotNear(const float* a, const float* b, size_t n, float error) {
+  return findNotNearT(a, b, n, error);
 }
 
-bool compareNotNear(double a, double b, double error) {
-  return !compareNear(a, b, error);
+size_t findNotNear(const double* a, const double* b, size_t n, double error) {
+  return findNotNearT(a, b, n, error);
 }
 
 }
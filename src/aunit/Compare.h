@@ -70,7 +70,9 @@ SOFTWARE.
 #ifndef AUNIT_COMPARE_H
 #define AUNIT_COMPARE_H
 
+#include <math.h> // fabs()
 #include <stddef.h> // size_t
+#include <stdlib.h> // abs()
 
 class String;
 class __FlashStringHelper;
@@ -188,25 +190,45 @@ bool compareSubstring(
 // compareEqual()
 //---------------------------------------------------------------------------
 
-bool compareEqual(bool a, bool b);
+inline bool compareEqual(bool a, bool b) {
+  return (a == b);
+}
 
-bool compareEqual(char a, char b);
+inline bool compareEqual(char a, char b) {
+  return (a == b);
+}
 
-bool compareEqual(int a, int b);
+inline bool compareEqual(int a, int b) {
+  return (a == b);
+}
 
-bool compareEqual(unsigned int a, unsigned int b);
+inline bool compareEqual(unsigned int a, unsigned int b) {
+  return (a == b);
+}
 
-bool compareEqual(long a, long b);
+inline bool compareEqual(long a, long b) {
+  return (a == b);
+}
 
-bool compareEqual(unsigned long a, unsigned long b);
+inline bool compareEqual(unsigned long a, unsigned long b) {
+  return (a == b);
+}
 
-bool compareEqual(long long a, long long b);
+inline bool compareEqual(long long a, long long b) {
+  return (a == b);
+}
 
-bool compareEqual(unsigned long long a, unsigned long long b);
+inline bool compareEqual(unsigned long long a, unsigned long long b) {
+  return (a == b);
+}
 
-bool compareEqual(double a, double b);
+inline bool compareEqual(double a, double b) {
+  return (a == b);
+}
 
-bool compareEqual(const void* a, const void* b);
+inline bool compareEqual(const void* a, const void* b) {
+  return (a == b);
+}
 
 bool compareEqual(const char* a, const char* b);
 
@@ -230,23 +252,41 @@ bool compareEqual(const String& a, const __FlashStringHelper* b);
 // compareLess()
 //---------------------------------------------------------------------------
 
-bool compareLess(bool a, bool b);
+inline bool compareLess(bool a, bool b) {
+  return (a < b);
+}
 
-bool compareLess(char a, char b);
+inline bool compareLess(char a, char b) {
+  return (a < b);
+}
 
-bool compareLess(int a, int b);
+inline bool compareLess(int a, int b) {
+  return (a < b);
+}
 
-bool compareLess(unsigned int a, unsigned int b);
+inline bool compareLess(unsigned int a, unsigned int b) {
+  return (a < b);
+}
 
-bool compareLess(long a, long b);
+inline bool compareLess(long a, long b) {
+  return (a < b);
+}
 
-bool compareLess(unsigned long a, unsigned long b);
+inline bool compareLess(unsigned long a, unsigned long b) {
+  return (a < b);
+}
 
-bool compareLess(long long a, long long b);
+inline bool compareLess(long long a, long long b) {
+  return (a < b);
+}
 
-bool compareLess(unsigned long long a, unsigned long long b);
+inline bool compareLess(unsigned long long a, unsigned long long b) {
+  return (a < b);
+}
 
-bool compareLess(double a, double b);
+inline bool compareLess(double a, double b) {
+  return (a < b);
+}
 
 bool compareLess(const char* a, const char* b);
 
@@ -270,23 +310,41 @@ bool compareLess(const String& a, const __FlashStringHelper* b);
 // compareMore()
 //---------------------------------------------------------------------------
 
-bool compareMore(bool a, bool b);
+inline bool compareMore(bool a, bool b) {
+  return (a > b);
+}
 
-bool compareMore(char a, char b);
+inline bool compareMore(char a, char b) {
+  return (a > b);
+}
 
-bool compareMore(int a, int b);
+inline bool compareMore(int a, int b) {
+  return (a > b);
+}
 
-bool compareMore(unsigned int a, unsigned int b);
+inline bool compareMore(unsigned int a, unsigned int b) {
+  return (a > b);
+}
 
-bool compareMore(long a, long b);
+inline bool compareMore(long a, long b) {
+  return (a > b);
+}
 
-bool compareMore(unsigned long a, unsigned long b);
+inline bool compareMore(unsigned long a, unsigned long b) {
+  return (a > b);
+}
 
-bool compareMore(long long a, long long b);
+inline bool compareMore(long long a, long long b) {
+  return (a > b);
+}
 
-bool compareMore(unsigned long long a, unsigned long long b);
+inline bool compareMore(unsigned long long a, unsigned long long b) {
+  return (a > b);
+}
 
-bool compareMore(double a, double b);
+inline bool compareMore(double a, double b) {
+  return (a > b);
+}
 
 bool compareMore(const char* a, const char* b);
 
@@ -310,23 +368,41 @@ bool compareMore(const String& a, const __FlashStringHelper* b);
 // compareLessOrEqual
 //---------------------------------------------------------------------------
 
-bool compareLessOrEqual(bool a, bool b);
+inline bool compareLessOrEqual(bool a, bool b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(char a, char b);
+inline bool compareLessOrEqual(char a, char b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(int a, int b);
+inline bool compareLessOrEqual(int a, int b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(unsigned int a, unsigned int b);
+inline bool compareLessOrEqual(unsigned int a, unsigned int b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(long a, long b);
+inline bool compareLessOrEqual(long a, long b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(unsigned long a, unsigned long b);
+inline bool compareLessOrEqual(unsigned long a, unsigned long b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(long long a, long long b);
+inline bool compareLessOrEqual(long long a, long long b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(unsigned long long a, unsigned long long b);
+inline bool compareLessOrEqual(unsigned long long a, unsigned long long b) {
+  return (a <= b);
+}
 
-bool compareLessOrEqual(double a, double b);
+inline bool compareLessOrEqual(double a, double b) {
+  return (a <= b);
+}
 
 bool compareLessOrEqual(const char* a, const char* b);
 
@@ -351,23 +427,41 @@ bool compareLessOrEqual(const String& a, const __FlashStringHelper* b);
 // compareMoreOrEqual
 //---------------------------------------------------------------------------
 
-bool compareMoreOrEqual(bool a, bool b);
+inline bool compareMoreOrEqual(bool a, bool b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(char a, char b);
+inline bool compareMoreOrEqual(char a, char b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(int a, int b);
+inline bool compareMoreOrEqual(int a, int b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(unsigned int a, unsigned int b);
+inline bool compareMoreOrEqual(unsigned int a, unsigned int b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(long a, long b);
+inline bool compareMoreOrEqual(long a, long b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(unsigned long a, unsigned long b);
+inline bool compareMoreOrEqual(unsigned long a, unsigned long b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(long long a, long long b);
+inline bool compareMoreOrEqual(long long a, long long b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(unsigned long long a, unsigned long long b);
+inline bool compareMoreOrEqual(unsigned long long a, unsigned long long b) {
+  return (a >= b);
+}
 
-bool compareMoreOrEqual(double a, double b);
+inline bool compareMoreOrEqual(double a, double b) {
+  return (a >= b);
+}
 
 bool compareMoreOrEqual(const char* a, const char* b);
 
@@ -392,25 +486,45 @@ bool compareMoreOrEqual(const String& a, const __FlashStringHelper* b);
 // compareNotEqual
 //---------------------------------------------------------------------------
 
-bool compareNotEqual(bool a, bool b);
+inline bool compareNotEqual(bool a, bool b) {
+  return (a != b);
+}
 
-bool compareNotEqual(char a, char b);
+inline bool compareNotEqual(char a, char b) {
+  return (a != b);
+}
 
-bool compareNotEqual(int a, int b);
+inline bool compareNotEqual(int a, int b) {
+  return (a != b);
+}
 
-bool compareNotEqual(unsigned int a, unsigned int b);
+inline bool compareNotEqual(unsigned int a, unsigned int b) {
+  return (a != b);
+}
 
-bool compareNotEqual(long a, long b);
+inline bool compareNotEqual(long a, long b) {
+  return (a != b);
+}
 
-bool compareNotEqual(unsigned long a, unsigned long b);
+inline bool compareNotEqual(unsigned long a, unsigned long b) {
+  return (a != b);
+}
 
-bool compareNotEqual(long long a, long long b);
+inline bool compareNotEqual(long long a, long long b) {
+  return (a != b);
+}
 
-bool compareNotEqual(unsigned long long a, unsigned long long b);
+inline bool compareNotEqual(unsigned long long a, unsigned long long b) {
+  return (a != b);
+}
 
-bool compareNotEqual(double a, double b);
+inline bool compareNotEqual(double a, double b) {
+  return (a != b);
+}
 
-bool compareNotEqual(const void* a, const void* b);
+inline bool compareNotEqual(const void* a, const void* b) {
+  return (a != b);
+}
 
 bool compareNotEqual(const char* a, const char* b);
 
@@ -481,29 +595,75 @@ bool compareStringCaseNotEqual(const String& a, const __FlashStringHelper* b);
 // compareNear
 //---------------------------------------------------------------------------
 
-bool compareNear(int a, int b, int error);
+inline bool compareNear(int a, int b, int error) {
+  return abs(a - b) <= error;
+}
 
-bool compareNear(unsigned int a, unsigned int b, unsigned int error);
+inline bool compareNear(unsigned int a, unsigned int b, unsigned int error) {
+  return (unsigned int) abs((int)(a - b)) <= error;
+}
 
-bool compareNear(long a, long b, long error);
+inline bool compareNear(long a, long b, long error) {
+  return abs(a - b) <= error;
+}
 
-bool compareNear(unsigned long a, unsigned long b, unsigned long error);
+inline bool compareNear(unsigned long a, unsigned long b, unsigned long error) {
+  return (unsigned long) abs((long)(a - b)) <= error;
+}
 
-bool compareNear(double a, double b, double error);
+inline bool compareNear(double a, double b, double error) {
+  return fabs(a - b) <= error;
+}
 
 //---------------------------------------------------------------------------
 // compareNotNear
 //---------------------------------------------------------------------------
 
-bool compareNotNear(int a, int b, int error);
+inline bool compareNotNear(int a, int b, int error) {
+  return !compareNear(a, b, error);
+}
+
+inline bool compareNotNear(unsigned int a, unsigned int b, unsigned int error) {
+  return !compareNear(a, b, error);
+}
+
+inline bool compareNotNear(long a, long b, long error) {
+  return !compareNear(a, b, error);
+}
+
+inline bool compareNotNear(unsigned long a, unsigned long b, unsigned long error) {
+  return !compareNear(a, b, error);
+}
+
+inline bool compareNotNear(double a, double b, double error) {
+  return !compareNear(a, b, error);
+}
+
+//---------------------------------------------------------------------------
+// findMismatch() and findNotNear() - used by the array assertions
+//---------------------------------------------------------------------------
+
+/**
+ * Return the offset of the first byte which differs between a and b, or
+ * 'size' if the two blocks of memory are equal.
+ */
+size_t findMismatch(const void* a, const void* b, size_t size);
 
-bool compareNotNear(unsigned int a, unsigned int b, unsigned int error);
+/**
+ * Return the index of the first element which is not equal (using ==), or
+ * 'n' if all elements are equal. A NaN never compares equal.
+ */
+size_t findMismatch(const float* a, const float* b, size_t n);
 
-bool compareNotNear(long a, long b, long error);
+size_t findMismatch(const double* a, const double* b, size_t n);
 
-bool compareNotNear(unsigned long a, unsigned long b, unsigned long error);
+/**
+ * Return the index of the first element which is not within 'error' of the
+ * other, or 'n' if all elements are near.
+ */
+size_t findNotNear(const float* a, const float* b, size_t n, float error);
 
-bool compareNotNear(double a, double b, double error);
+size_t findNotNear(const double* a, const double* b, size_t n, double error);
 
 }
 }
@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file CompileFilter.h
+ *
+ * The compile-time filter of the tests, selected by the AUNIT_INCLUDE_PATTERN
+ * and AUNIT_EXCLUDE_PATTERN macros (see Config.h). The test() and testF()
+ * family of macros declare the object of each test with AUNIT_TEST_TYPE(),
+ * which is an internal::DisabledTest for the tests which do not pass the
+ * filter. The class of a disabled test is never constructed, so its vtable and
+ * its body are removed from the program by the '--gc-sections' linker flag
+ * used by the Arduino cores.
+ */
+
+#ifndef AUNIT_COMPILE_FILTER_H
+#define AUNIT_COMPILE_FILTER_H
+
+#include "Config.h"
+
+/**
+ * The type of the object of the test of class 'testClass', whose full name is
+ * the string literal 'name': 'testClass' itself if the test passes the
+ * compile-time filter, or internal::DisabledTest otherwise.
+ */
+#define AUNIT_TEST_TYPE(testClass, name) \
+    aunit::internal::TestType<testClass, aunit::internal::isTestEnabled(\
+        AUNIT_INCLUDE_PATTERN, AUNIT_EXCLUDE_PATTERN, name)>::type
+
+namespace aunit {
+namespace internal {
+
+/**
+ * Return true if the glob pattern 'pattern', which ends at the next ',' or at
+ * the end of the string, matches the entire 'name'. The '*' matches any
+ * sequence of characters, and '?' matches any single character, like the
+ * patterns of TestRunner::include() and TestRunner::exclude().
+ */
+constexpr bool globMatches(const char* pattern, const char* name) {
+  return (*pattern == '\0' || *pattern == ',')
+      ? *name == '\0'
+      : (*pattern == '*')
+          ? globMatches(pattern + 1, name)
+              || (*name != '\0' && globMatches(pattern, name + 1))
+          : *name != '\0'
+              && (*pattern == '?' || *pattern == *name)
+              && globMatches(pattern + 1, name + 1);
+}
+
+/** Return the pattern after the next ',', or nullptr if this is the last. */
+constexpr const char* nextGlobPattern(const char* pattern) {
+  return (*pattern == '\0')
+      ? nullptr
+      : (*pattern == ',') ? pattern + 1 : nextGlobPattern(pattern + 1);
+}
+
+/**
+ * Return true if one of the comma-separated glob patterns matches 'name'. An
+ * empty list matches nothing.
+ */
+constexpr bool globMatchesAny(const char* patterns, const char* name) {
+  return patterns != nullptr && *patterns != '\0'
+      && (globMatches(patterns, name)
+          || globMatchesAny(nextGlobPattern(patterns), name));
+}
+
+/**
+ * Return true if the test 'name' matches one of the 'includes' patterns and
+ * none of the 'excludes' patterns.
+ */
+constexpr bool isTestEnabled(const char* includes, const char* excludes,
+    const char* name) {
+  return globMatchesAny(includes, name) && !globMatchesAny(excludes, name);
+}
+
+/**
+ * Stands for a test removed by the compile-time filter. It is never
+ * registered with the TestRunner, and reports the status of an excluded test
+ * to the assertTestXxx() and checkTestXxx() meta assertions, so that they
+ * remain valid.
+ */
+class DisabledTest {
+  public:
+    /** Accept the arguments of the constructor of any test, e.g. LazyTest. */
+    template <typename... Args>
+    constexpr DisabledTest(Args&&...) {}
+
+    constexpr bool isDone() const { return true; }
+    constexpr bool isNotDone() const { return false; }
+    constexpr bool isPassed() const { return false; }
+    constexpr bool isNotPassed() const { return true; }
+    constexpr bool isFailed() const { return false; }
+    constexpr bool isNotFailed() const { return true; }
+    constexpr bool isSkipped() const { return true; }
+    constexpr bool isNotSkipped() const { return false; }
+    constexpr bool isExpired() const { return false; }
+    constexpr bool isNotExpired() const { return true; }
+};
+
+/** Select the type of the object of a test, see AUNIT_TEST_TYPE(). */
+template <typename T, bool isEnabled>
+struct TestType {
+  typedef T type;
+};
+
+template <typename T>
+struct TestType<T, false> {
+  typedef DisabledTest type;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,324 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file Config.h
+ *
+ * Compile-time configuration of optional features which cost memory on every
+ * test, or flash on every program. Each macro can be overridden by defining it
+ * (e.g. with a -D compiler flag) before any AUnit header is included.
+ */
+
+#ifndef AUNIT_CONFIG_H
+#define AUNIT_CONFIG_H
+
+/**
+ * Storage class of the global state used while a test is running (e.g. the
+ * current printer), which must be per thread on EpoxyDuino where tests can run
+ * on worker threads (see TestRunner::setParallelism()).
+ */
+#if defined(EPOXY_DUINO)
+  #define AUNIT_THREAD_LOCAL thread_local
+#else
+  #define AUNIT_THREAD_LOCAL
+#endif
+
+/**
+ * Size of the line buffer in front of the Printer, which collects the many
+ * small print() calls of an AUnit message and writes each complete line to
+ * the printer (usually Serial) with a single write(buffer, size). Set to 0 to
+ * write directly to the printer. Disabled by default on the 8-bit AVR
+ * processors to save static memory, where the HardwareSerial already has its
+ * own transmit buffer.
+ */
+#ifndef AUNIT_PRINTER_BUFFER_SIZE
+  #if defined(ARDUINO_ARCH_AVR)
+    #define AUNIT_PRINTER_BUFFER_SIZE 0
+  #else
+    #define AUNIT_PRINTER_BUFFER_SIZE 64
+  #endif
+#endif
+
+/**
+ * Size of the buffer of the native output on EpoxyDuino, which replaces the
+ * emulated Serial as the default printer, and writes directly to stdout, or to
+ * the file or file descriptor given by the '--output' flag. The output is
+ * written with writev() when this buffer is full, at the end of each line and
+ * before each step of a test when it goes to stdout, and at the end of the
+ * run. Set to 0 to print through
+ * the Serial of EpoxyDuino, as on a microcontroller. Only supported on
+ * EpoxyDuino.
+ */
+#ifndef AUNIT_NATIVE_OUTPUT_BUFFER_SIZE
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_NATIVE_OUTPUT_BUFFER_SIZE 65536
+  #else
+    #define AUNIT_NATIVE_OUTPUT_BUFFER_SIZE 0
+  #endif
+#endif
+
+/**
+ * If set to 1, each Test records the time spent in its setup(), loop() and
+ * teardown() methods, which can be printed with Verbosity::kTestTiming. This
+ * costs 16 bytes of static memory per test, so it is enabled by default only
+ * on EpoxyDuino.
+ */
+#ifndef AUNIT_ENABLE_TIMING
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_ENABLE_TIMING 1
+  #else
+    #define AUNIT_ENABLE_TIMING 0
+  #endif
+#endif
+
+/**
+ * If set to 1, each testing() test can have its own timeout, set by
+ * TestAgain::setTimeout() or the testingWithTimeout() macro, and can sleep
+ * with TestAgain::sleepUntil(), which lets the TestRunner idle while all the
+ * remaining tests are asleep. Costs 14 bytes of static memory per testing()
+ * test (16 on 32-bit processors). Otherwise, the AUNIT_SLEEP() of an
+ * asyncTest() polls its wake time on every visit of the TestRunner. Enabled
+ * by default only on EpoxyDuino.
+ */
+#ifndef AUNIT_ENABLE_TEST_TIMERS
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_ENABLE_TEST_TIMERS 1
+  #else
+    #define AUNIT_ENABLE_TEST_TIMERS 0
+  #endif
+#endif
+
+/**
+ * If set to 1, the TestRunner records the heap memory allocated by the
+ * setup(), loop() and teardown() methods of each Test, which is checked by
+ * assertNoLeaks() and assertMaxHeap(), and printed with
+ * Verbosity::kTestTiming. On EpoxyDuino, AUnit replaces the global operator
+ * new and operator delete, which precisely count the allocations. On the
+ * ESP8266 and ESP32, the free heap is sampled around each call instead, which
+ * records only the memory in use and its peak. Costs 16 bytes of static memory
+ * per test (32 on 64-bit processors). Disabled by default, since replacing
+ * operator new conflicts with a program or a library which defines its own.
+ */
+#ifndef AUNIT_ENABLE_HEAP_TRACKING
+  #define AUNIT_ENABLE_HEAP_TRACKING 0
+#endif
+
+/**
+ * If set to 1, the TestRunner fills the free stack below its own frame with a
+ * canary pattern before each call to the setup(), loop() and teardown()
+ * methods of a Test, and finds the deepest byte overwritten by the call. The
+ * highest value is the stack usage of the test, checked by assertMaxStack()
+ * and printed with Verbosity::kTestTiming. Costs 2 bytes of static memory per
+ * test, and the time to paint and scan AUNIT_STACK_PAINT_SIZE bytes on every
+ * call. Supported on AVR, ESP32 and EpoxyDuino. Disabled by default.
+ */
+#ifndef AUNIT_ENABLE_STACK_TRACKING
+  #define AUNIT_ENABLE_STACK_TRACKING 0
+#endif
+
+/**
+ * Maximum number of bytes of stack painted by AUNIT_ENABLE_STACK_TRACKING,
+ * i.e. the largest stack usage which can be measured. On AVR, the painted
+ * region also stops at the top of the heap, and on ESP32 at the start of the
+ * stack of the task. At most 65535.
+ */
+#ifndef AUNIT_STACK_PAINT_SIZE
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_STACK_PAINT_SIZE 16384
+  #else
+    #define AUNIT_STACK_PAINT_SIZE 4096
+  #endif
+#endif
+
+/**
+ * If set to 1, the TestRunner records the functions executed by each test on
+ * EpoxyDuino (Linux only), and maps them to their source files, for the
+ * '--impact-map' and '--changed-files' flags. Only the code compiled with the
+ * '-finstrument-functions' flag of the compiler is seen, and every call of
+ * that code is slowed down by a hash table lookup. Disabled by default.
+ */
+#ifndef AUNIT_ENABLE_IMPACT_TRACKING
+  #define AUNIT_ENABLE_IMPACT_TRACKING 0
+#endif
+
+/**
+ * If set to 1, each Test counts the iterations in which it passed and failed
+ * when the TestRunner repeats the run with setRepeat() or setUntilFail(), and
+ * the tests which failed in some of the iterations are reported at the end.
+ * Costs 4 bytes of static memory per test. Enabled by default only on
+ * EpoxyDuino.
+ */
+#ifndef AUNIT_ENABLE_REPEAT_STATS
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_ENABLE_REPEAT_STATS 1
+  #else
+    #define AUNIT_ENABLE_REPEAT_STATS 0
+  #endif
+#endif
+
+/**
+ * If set to 1, the assertion messages refer to their source file by a small
+ * id, as in "#1:820: Assertion failed: ...", instead of the full path of the
+ * file given to the compiler. The path of each file is printed only once per
+ * test, on a "TestRunner file 1: {path}" line before the first message of the
+ * test which uses the id, which saves a lot of output over a slow serial link
+ * in verbose mode, or when many assertions fail. The JUnitReporter and the
+ * JsonLinesReporter keep the full paths. Disabled by default.
+ */
+#ifndef AUNIT_INTERN_FILE_NAMES
+  #define AUNIT_INTERN_FILE_NAMES 0
+#endif
+
+/**
+ * Maximum number of source files with an id when AUNIT_INTERN_FILE_NAMES is
+ * enabled, or when the BinaryReporter is used. The messages of the other
+ * files carry their full path. Costs one pointer of static memory per file.
+ * At most 255.
+ */
+#ifndef AUNIT_FILE_TABLE_SIZE
+  #define AUNIT_FILE_TABLE_SIZE 16
+#endif
+
+/**
+ * Comma-separated list of glob patterns, e.g. "net_*,led_*", of the tests
+ * which are compiled into the program. The full name of a test is matched
+ * like the patterns of TestRunner::include(), e.g. "suite_name" for
+ * test(suite, name) and "Fixture_name" for testF(Fixture, name). The other
+ * tests are removed at compile time, which saves their flash memory instead
+ * of only skipping them at run time, so that a large test suite can be split
+ * into several smaller programs. Usually defined on the command line of the
+ * compiler. The default "*" keeps all the tests.
+ */
+#ifndef AUNIT_INCLUDE_PATTERN
+  #define AUNIT_INCLUDE_PATTERN "*"
+#endif
+
+/**
+ * Comma-separated list of glob patterns of the tests which are removed at
+ * compile time, like the tests which do not match AUNIT_INCLUDE_PATTERN. The
+ * default "" removes none.
+ */
+#ifndef AUNIT_EXCLUDE_PATTERN
+  #define AUNIT_EXCLUDE_PATTERN ""
+#endif
+
+/**
+ * If set to 1, each Test uses a compact layout: the LifeCycle, the Status and
+ * the flags of the test share a single byte, and the name does not cache its
+ * length and hash (see AUNIT_ENABLE_NAME_CACHE). A Test without the other
+ * optional features is then 9 bytes on the 8-bit AVR processors instead of
+ * 11, and 20 bytes on 32-bit processors instead of 24, at the cost of a few
+ * more instructions to read and write the bit fields. The behavior is
+ * identical. Disabled by default.
+ */
+#ifndef AUNIT_COMPACT_TEST
+  #define AUNIT_COMPACT_TEST 0
+#endif
+
+/**
+ * If set to 1, each FCString, i.e. the name of each Test, caches the length
+ * and the hash of the string, which are used to pad the names in the output
+ * and to reject most names quickly in the filters and in TestRunner::find().
+ * Otherwise the string is scanned when they are needed. Costs 4 bytes of
+ * static memory per test, so it is disabled by default on the 8-bit AVR
+ * processors and with AUNIT_COMPACT_TEST. If both are enabled, the flash/RAM
+ * discriminator of the name shares 16 bits with the cached length.
+ */
+#ifndef AUNIT_ENABLE_NAME_CACHE
+  #if defined(ARDUINO_ARCH_AVR) || AUNIT_COMPACT_TEST
+    #define AUNIT_ENABLE_NAME_CACHE 0
+  #else
+    #define AUNIT_ENABLE_NAME_CACHE 1
+  #endif
+#endif
+
+/**
+ * Number of samples taken by each benchmark() to compute the min, median and
+ * p99 times. The samples are kept on the stack while the benchmark runs.
+ */
+#ifndef AUNIT_BENCHMARK_SAMPLES
+  #if defined(ARDUINO_ARCH_AVR)
+    #define AUNIT_BENCHMARK_SAMPLES 16
+  #else
+    #define AUNIT_BENCHMARK_SAMPLES 64
+  #endif
+#endif
+
+/**
+ * Minimum duration of a single benchmark() sample in microseconds. The number
+ * of iterations per sample is calibrated to reach this duration, so that the
+ * resolution of micros() (4 microseconds on AVR) becomes negligible.
+ */
+#ifndef AUNIT_BENCHMARK_SAMPLE_MICROS
+  #define AUNIT_BENCHMARK_SAMPLE_MICROS 1000
+#endif
+
+/**
+ * If set to 1, the TestRunner builds the index of the tests by name used by
+ * TestRunner::find() when it starts, which costs 2 pointers per test on the
+ * heap. Otherwise the index is built by the first call to find(), which finds
+ * only the tests which have not been removed from the list of active tests
+ * yet, i.e. not finished, unless it is called before the first run() or
+ * AUNIT_ENABLE_TEST_ARRAY is set.
+ * Enabled by default only on EpoxyDuino, so that a program which never calls
+ * find() does not allocate the index.
+ */
+#ifndef AUNIT_ENABLE_TEST_INDEX
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_ENABLE_TEST_INDEX 1
+  #else
+    #define AUNIT_ENABLE_TEST_INDEX 0
+  #endif
+#endif
+
+/**
+ * If set to 1, the TestRunner copies the pointers of all the tests into an
+ * array on the heap when it starts, and uses that array instead of the linked
+ * list for sorting, filtering, counting and indexing the tests, which is
+ * faster for large numbers of tests. Costs 1 pointer per test on the heap,
+ * and another one temporarily while sorting, and the allocations are not
+ * checked, so it is enabled by default only on EpoxyDuino.
+ */
+#ifndef AUNIT_ENABLE_TEST_ARRAY
+  #if defined(EPOXY_DUINO)
+    #define AUNIT_ENABLE_TEST_ARRAY 1
+  #else
+    #define AUNIT_ENABLE_TEST_ARRAY 0
+  #endif
+#endif
+
+/**
+ * Size of each of the 2 buffers on the stack used by assertStreamEqual() to
+ * compare a ByteSource chunk by chunk. The memory used by the comparison does
+ * not depend on the size of the data.
+ */
+#ifndef AUNIT_STREAM_CHUNK_SIZE
+  #if defined(ARDUINO_ARCH_AVR)
+    #define AUNIT_STREAM_CHUNK_SIZE 32
+  #else
+    #define AUNIT_STREAM_CHUNK_SIZE 256
+  #endif
+#endif
+
+#endif
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <Arduino.h> // pgm_read_byte()
+#include <string.h> // strlen()
 #include <Print.h>
 #include "Compare.h"
 #include "FCString.h"
@@ -29,6 +31,71 @@ SOFTWARE.
 namespace aunit {
 namespace internal {
 
+namespace {
+
+// One step of the djb2 hash (with xor), truncated to 16 bits. The hash is
+// only used to reject unequal names quickly, so the quality of the
+// distribution is not critical.
+inline uint16_t mixHash(uint16_t h, uint8_t c) {
+  return (uint16_t) ((h << 5) + h) ^ c;
+}
+
+}
+
+uint16_t FCString::hash(const char* s, size_t n, uint16_t h) {
+  for (size_t i = 0; i < n; i++) {
+    h = mixHash(h, s[i]);
+  }
+  return h;
+}
+
+size_t FCString::scanKey(uint16_t& hash) const {
+  uint16_t h = kHashSeed;
+  size_t n = 0;
+  if (mString.cstring != nullptr) {
+    const char* s = mString.cstring;
+    if (mStringType == kCStringType) {
+      for (; s[n] != '\0'; n++) {
+        h = mixHash(h, s[n]);
+      }
+    } else {
+      for (uint8_t c; (c = pgm_read_byte(s + n)) != '\0'; n++) {
+        h = mixHash(h, c);
+      }
+    }
+  }
+  hash = h;
+  return n;
+}
+
+size_t FCString::scanLength() const {
+  if (mString.cstring == nullptr) return 0;
+  return (mStringType == kCStringType)
+      ? strlen(getCString())
+      : strlen_P((const char*) getFString());
+}
+
+#if AUNIT_ENABLE_NAME_CACHE
+
+// Saturating instead of truncating keeps the longer strings from looking
+// shorter than they are, so length() can tell which ones to scan again.
+void FCString::initKey() {
+  uint16_t h;
+  size_t n = scanKey(h);
+  mLength = (n < kMaxCachedLength) ? n : kMaxCachedLength;
+  mHash = h;
+}
+
+#else
+
+uint16_t FCString::getHash() const {
+  uint16_t h;
+  scanKey(h);
+  return h;
+}
+
+#endif
+
 void FCString::print(Print* printer) const {
   if (mString.cstring == nullptr) return;
 
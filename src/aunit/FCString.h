@@ -26,7 +26,8 @@ SOFTWARE.
 #define AUNIT_FSTRING_H
 
 #include <stddef.h> // size_t
-#include <cstring>
+#include <stdint.h>
+#include "Config.h"
 
 class Print;
 class __FlashStringHelper;
@@ -50,6 +51,19 @@ namespace internal {
  * static memory for a large suite of 25 unit tests does not seem worth the
  * minor convenience.
  *
+ * If AUNIT_ENABLE_NAME_CACHE is set, the length and a 16-bit hash of the
+ * string are computed once by the constructor (a single pass over the string,
+ * which is the expensive part for flash strings on AVR), so that the column
+ * padding of the test names, the filters and the lookups by exact name can
+ * reject most names without reading the characters again. This costs 4 bytes
+ * per instance, which is why it is disabled by default with
+ * AUNIT_COMPACT_TEST. If both are enabled, the discriminator is stored in the
+ * top bit of the length, which saves 1 byte on 8-bit processors and 4 bytes
+ * of padding on 32-bit processors. The cached length saturates at
+ * kMaxCachedLength (32767 in the compact layout, 65535 otherwise), and
+ * length() scans the longer strings again. Otherwise, length() and getHash()
+ * scan the string on each call.
+ *
  * Use the print() and println() methods to print to the given 'Print'. In
  * hindsight, with more Arduino programming under my belt, I think these
  * functions should accept a reference `Print&` instead of a pointer `Print*`.
@@ -62,20 +76,36 @@ class FCString {
     static const uint8_t kFStringType = 1;
 
     /** Default constructor initializes to a nullptr of kCStringType. */
-    FCString() {}
+    FCString():
+        mStringType(kCStringType) {
+      initKey();
+    }
 
     /** Construct with a c-string. */
     explicit FCString(const char* s):
         mStringType(kCStringType) {
       mString.cstring = s;
+      initKey();
     }
 
     /** Construct with a flash string. */
     explicit FCString(const __FlashStringHelper* s):
         mStringType(kFStringType) {
       mString.fstring = s;
+      initKey();
     }
 
+    /** Initial value of the hash, which is also the hash of "". */
+    static const uint16_t kHashSeed = 5381;
+
+    /**
+     * Continue the hash 'h' with the first n characters of s. The hash of a
+     * string is the same as getHash() of an FCString of that string, and can
+     * be computed in pieces, e.g. hash("_name", 5, hash("Class", 5)). Used to
+     * match other names against the hash of the tests.
+     */
+    static uint16_t hash(const char* s, size_t n, uint16_t h = kHashSeed);
+
     /** Get the internal type of string. */
     uint8_t getType() const { return mStringType; }
 
@@ -108,10 +138,48 @@ class FCString {
      */
     int compareToN(const __FlashStringHelper* that, size_t n) const;
 
+    /**
+     * Return true if the two strings are equal. With AUNIT_ENABLE_NAME_CACHE,
+     * strings with a different length or hash are rejected without reading
+     * their characters. Two strings longer than kMaxCachedLength have the
+     * same saturated length, and are compared by their characters.
+     */
+    bool equals(const FCString& that) const {
+    #if AUNIT_ENABLE_NAME_CACHE
+      if (mLength != that.mLength || mHash != that.mHash) return false;
+    #endif
+      return compareTo(that) == 0;
+    }
+
     /** Determine if given substring exists. */
     bool hasSubstring(const char* substring) const;
 
-    size_t length() const { return strlen(mString.cstring); }
+  #if AUNIT_ENABLE_NAME_CACHE
+    #if AUNIT_COMPACT_TEST
+    /** The largest length stored in the 15 bits of mLength. */
+    static const uint16_t kMaxCachedLength = 0x7FFF;
+    #else
+    /** The largest length stored in mLength. */
+    static const uint16_t kMaxCachedLength = 0xFFFF;
+    #endif
+
+    /**
+     * Length of the string, 0 for a nullptr. Scans the string only if it is
+     * longer than kMaxCachedLength.
+     */
+    size_t length() const {
+      return (mLength < kMaxCachedLength) ? mLength : scanLength();
+    }
+
+    /** The 16-bit hash of the string, see hash(). */
+    uint16_t getHash() const { return mHash; }
+  #else
+    /** Length of the string, 0 for a nullptr. Scans the string. */
+    size_t length() const { return scanLength(); }
+
+    /** The 16-bit hash of the string, see hash(). Scans the string. */
+    uint16_t getHash() const;
+  #endif
 
   private:
     // NOTE: It might be possible just use a (void *) instead of a union.
@@ -120,7 +188,34 @@ class FCString {
       const __FlashStringHelper* fstring;
     } mString = { nullptr };
 
-    uint8_t mStringType = kCStringType;
+  #if AUNIT_ENABLE_NAME_CACHE
+    #if AUNIT_COMPACT_TEST
+    // The discriminator shares 16 bits with the length, which limits the
+    // cached length to 32767 characters.
+    uint16_t mStringType : 1;
+    uint16_t mLength : 15;
+    #else
+    uint8_t mStringType;
+    uint16_t mLength;
+    #endif
+    uint16_t mHash;
+
+    /**
+     * Compute mLength and mHash in a single pass over the string. The length
+     * saturates at kMaxCachedLength.
+     */
+    void initKey();
+  #else
+    uint8_t mStringType;
+
+    void initKey() {}
+  #endif
+
+    /** Return the length of the string, and its hash in 'hash'. */
+    size_t scanKey(uint16_t& hash) const;
+
+    /** Return the length of the string, 0 for a nullptr. */
+    size_t scanLength() const;
 };
 
 }
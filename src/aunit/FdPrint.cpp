@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Config.h"
+
+#if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h> // atexit()
+#include <string.h> // memchr(), memcpy()
+#include <sys/uio.h> // writev()
+#include "FdPrint.h"
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+// The signals which terminate a test that crashes. The buffered output is
+// written before the default action, so that the messages of the test that
+// led to the crash are not lost. A handler installed by the program is kept.
+const int kCrashSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+void flushOnExit() {
+  FdPrint::getInstance()->flushBuffer();
+}
+
+// Only calls writev(), which is async-signal-safe.
+void flushOnSignal(int sig) {
+  FdPrint::getInstance()->flushBuffer();
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+}
+
+FdPrint FdPrint::sInstance;
+
+void FdPrint::setFd(int fd) {
+  flushBuffer();
+  mFd = fd;
+  mIsShared = (fd == STDOUT_FILENO);
+  if (mHasHandlers) return;
+
+  mHasHandlers = true;
+  atexit(flushOnExit);
+  for (int sig : kCrashSignals) {
+    void (*old)(int) = signal(sig, flushOnSignal);
+    if (old != SIG_DFL) signal(sig, old);
+  }
+}
+
+size_t FdPrint::write(const uint8_t* buffer, size_t size) {
+  if (size <= sizeof(mBuffer) - mLength) {
+    memcpy(mBuffer + mLength, buffer, size);
+    mLength += size;
+    if (mIsShared && memchr(buffer, '\n', size) != nullptr) flushBuffer();
+  } else {
+    // Write a large block, such as the output of a parallel test, along with
+    // the buffer instead of copying it.
+    writeAll(buffer, size);
+  }
+  return size;
+}
+
+void FdPrint::writeAll(const uint8_t* data, size_t size) {
+  iovec iov[2];
+  iov[0].iov_base = mBuffer;
+  iov[0].iov_len = mLength;
+  iov[1].iov_base = const_cast<uint8_t*>(data);
+  iov[1].iov_len = size;
+  iovec* next = (mLength > 0) ? iov : iov + 1;
+  int count = (mLength > 0) ? 2 : 1;
+  if (size == 0) count--;
+  mLength = 0;
+
+  while (count > 0) {
+    ssize_t n = writev(mFd, next, count);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return;
+    while (count > 0 && (size_t) n >= next->iov_len) {
+      n -= next->iov_len;
+      next++;
+      count--;
+    }
+    if (count > 0) {
+      next->iov_base = static_cast<uint8_t*>(next->iov_base) + n;
+      next->iov_len -= n;
+    }
+  }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_FD_PRINT_H
+#define AUNIT_FD_PRINT_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include <Print.h>
+#include "Config.h"
+
+#if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+
+#if !defined(EPOXY_DUINO)
+  #error AUNIT_NATIVE_OUTPUT_BUFFER_SIZE requires EpoxyDuino
+#endif
+
+#include <unistd.h> // STDOUT_FILENO
+
+namespace aunit {
+namespace internal {
+
+/**
+ * The native output of AUnit on EpoxyDuino. A Print which copies the
+ * characters into a buffer of AUNIT_NATIVE_OUTPUT_BUFFER_SIZE bytes, and
+ * writes them to a file descriptor with a single writev() system call when the
+ * buffer cannot hold the next write(), or when flushBuffer() is called. This
+ * bypasses the per-line write() of the emulated Serial, so a verbose run is
+ * bound by the I/O of the file descriptor instead of the call overhead.
+ *
+ * The output is written to stdout unless setFd() is called. Since the Serial
+ * of EpoxyDuino also writes directly to stdout, the buffer is then written at
+ * the end of each line, so that the messages of the assertions stay in order
+ * with the lines that a test prints to Serial in the same step. The
+ * TestRunner also calls sync() before each step of a test, which writes an
+ * incomplete line in that case.
+ *
+ * Not thread-safe. The TestRunner writes to it from one thread at a time.
+ */
+class FdPrint: public Print {
+  public:
+    /** Return the instance used as the default printer by the TestRunner. */
+    static FdPrint* getInstance() { return &sInstance; }
+
+    /**
+     * Flush the buffer, then send the output to 'fd'. The first call also
+     * registers the handlers which write the buffer when the program exits
+     * or crashes while it is not empty.
+     */
+    void setFd(int fd);
+
+    /** Return the file descriptor of the output. */
+    int getFd() const { return mFd; }
+
+    size_t write(uint8_t c) override {
+      if (mLength >= sizeof(mBuffer)) flushBuffer();
+      mBuffer[mLength++] = c;
+      if (c == '\n' && mIsShared) flushBuffer();
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    /** Write the buffered characters to the file descriptor. */
+    void flushBuffer() { writeAll(nullptr, 0); }
+
+    /** Flush the buffer if the output may interleave with the Serial. */
+    void sync() {
+      if (mIsShared && mLength > 0) flushBuffer();
+    }
+
+  private:
+    FdPrint() = default;
+
+    /**
+     * Write the buffer followed by 'size' bytes of 'data' with writev(),
+     * retrying the partial writes, then empty the buffer. The output is
+     * dropped if the file descriptor returns an error.
+     */
+    void writeAll(const uint8_t* data, size_t size);
+
+    static FdPrint sInstance;
+
+    int mFd = STDOUT_FILENO;
+    bool mIsShared = true;
+    bool mHasHandlers = false;
+    size_t mLength = 0;
+    uint8_t mBuffer[AUNIT_NATIVE_OUTPUT_BUFFER_SIZE];
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // pgm_read_byte()
+#include <string.h>
+#include "Flash.h"
+#include "FCString.h"
+#include "Test.h"
+#include "Filter.h"
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+/**
+ * Read-only access to the characters of a test name, which may be a
+ * c-string or a flash string.
+ */
+class NameReader {
+  public:
+    explicit NameReader(const FCString& name):
+      mString(name.getCString()),
+      mIsFlash(name.getType() == FCString::kFStringType) {}
+
+    char operator[](size_t i) const {
+      return mIsFlash ? (char) pgm_read_byte(mString + i) : mString[i];
+    }
+
+  private:
+    const char* const mString;
+    const bool mIsFlash;
+};
+
+/** Return true if the name at 'start' begins with the first n chars of s. */
+bool startsWith(const NameReader& name, size_t start, const char* s,
+    size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (name[start + i] != s[i]) return false;
+  }
+  return true;
+}
+
+/**
+ * Match the name from 'start' against the glob pattern. Uses the usual
+ * greedy algorithm which backtracks only to the most recent '*', so it needs
+ * no recursion and no extra memory.
+ */
+bool matchesGlob(const NameReader& name, size_t start, const char* pattern,
+    size_t length) {
+  size_t n = start;
+  size_t p = 0;
+  size_t starP = length; // no '*' seen yet
+  size_t starN = 0;
+  while (name[n] != '\0') {
+    if (p < length && (pattern[p] == '?' || pattern[p] == name[n])) {
+      n++;
+      p++;
+    } else if (p < length && pattern[p] == '*') {
+      starP = p++;
+      starN = n;
+    } else if (starP < length) {
+      p = starP + 1;
+      n = ++starN;
+    } else {
+      return false;
+    }
+  }
+  while (p < length && pattern[p] == '*') p++;
+  return p == length;
+}
+
+bool hasSubstring(const NameReader& name, size_t start, const char* s,
+    size_t n) {
+  for (size_t i = start; name[i] != '\0'; i++) {
+    if (startsWith(name, i, s, n)) return true;
+  }
+  return n == 0;
+}
+
+}
+
+FilterRule FilterRule::compile(const char* testClass, const char* pattern,
+    size_t length, bool isSubstring, bool isInclude) {
+  FilterRule rule;
+  rule.mTestClass = testClass;
+  rule.mTestClassLength = testClass ? strlen(testClass) : 0;
+  rule.mPattern = pattern;
+  rule.mLength = length;
+  rule.mIsInclude = isInclude;
+  rule.mHash = 0;
+
+  if (isSubstring) {
+    rule.mKind = Kind::kSubstring;
+    return rule;
+  }
+
+  rule.mKind = Kind::kExact;
+  for (size_t i = 0; i < length; i++) {
+    if (pattern[i] == '?' || (pattern[i] == '*' && i != length - 1)) {
+      rule.mKind = Kind::kGlob;
+      break;
+    }
+    if (pattern[i] == '*') {
+      rule.mKind = Kind::kPrefix;
+      rule.mLength = length - 1;
+    }
+  }
+
+  // An exact rule matches a single name, whose hash is compared before any of
+  // its characters.
+  if (rule.mKind == Kind::kExact) {
+    uint16_t h = FCString::kHashSeed;
+    if (testClass) {
+      h = FCString::hash(testClass, rule.mTestClassLength, h);
+      h = FCString::hash("_", 1, h);
+    }
+    rule.mHash = FCString::hash(pattern, length, h);
+  }
+  return rule;
+}
+
+bool FilterRule::matches(const FCString& name) const {
+  return matches(name, name.length(), name.getHash());
+}
+
+bool FilterRule::matches(const FCString& name, size_t length,
+    uint16_t hash) const {
+  // Reject the names which are too short (or have the wrong hash) using the
+  // length and hash of the name, without reading the name itself.
+  size_t start = mTestClass ? mTestClassLength + 1 : 0;
+  if (mKind == Kind::kExact) {
+    if (length != start + mLength || hash != mHash) return false;
+  } else if (mKind != Kind::kGlob) {
+    if (length < start + mLength) return false;
+  } else {
+    if (length < start) return false;
+  }
+
+  NameReader reader(name);
+  if (mTestClass) {
+    if (!startsWith(reader, 0, mTestClass, mTestClassLength)) return false;
+    if (reader[mTestClassLength] != '_') return false;
+  }
+
+  switch (mKind) {
+    case Kind::kExact:
+    case Kind::kPrefix:
+      return startsWith(reader, start, mPattern, mLength);
+    case Kind::kGlob:
+      return matchesGlob(reader, start, mPattern, mLength);
+    case Kind::kSubstring:
+      return hasSubstring(reader, start, mPattern, mLength);
+  }
+  return false;
+}
+
+namespace {
+
+/**
+ * Apply the last of the 'rules' which matches the test. The length and the
+ * hash of the name are computed once, in case they are not cached by the
+ * FCString.
+ */
+void applyFilters(Test* test, const FilterRule* rules, size_t numRules,
+    bool isExcludedByDefault) {
+  const FCString& name = test->getName();
+  size_t length = name.length();
+  uint16_t hash = name.getHash();
+  size_t i = numRules;
+  while (i > 0 && !rules[i - 1].matches(name, length, hash)) {
+    i--;
+  }
+  if (i > 0) {
+    test->setLifeCycle(rules[i - 1].isInclude()
+        ? Test::LifeCycle::New
+        : Test::LifeCycle::Excluded);
+  } else if (isExcludedByDefault) {
+    test->setLifeCycle(Test::LifeCycle::Excluded);
+  }
+}
+
+}
+
+void applyFilters(Test** root, const FilterRule* rules, size_t numRules,
+    bool isExcludedByDefault) {
+  for (Test** p = root; *p != nullptr; p = (*p)->getNext()) {
+    applyFilters(*p, rules, numRules, isExcludedByDefault);
+  }
+}
+
+void applyFilters(Test* const* begin, Test* const* end,
+    const FilterRule* rules, size_t numRules, bool isExcludedByDefault) {
+  for (Test* const* p = begin; p != end; p++) {
+    applyFilters(*p, rules, numRules, isExcludedByDefault);
+  }
+}
+
+}
+}
@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_FILTER_H
+#define AUNIT_FILTER_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+class FCString;
+
+/**
+ * A compiled include or exclude rule of the TestRunner. The kind of matching
+ * is determined once by compile(), so that matching a test name does not need
+ * to scan the pattern for wildcards again. The pattern does not need to be
+ * NUL-terminated, which allows a rule to point directly into a
+ * comma-separated list on the command line. The strings must outlive the
+ * rule.
+ */
+class FilterRule {
+  public:
+    /**
+     * Compile the 'pattern' of 'length' characters. If 'testClass' is not
+     * nullptr, the name of the test must start with (testClass + "_"),
+     * followed by a match of the pattern, the same concatenation rule used by
+     * testF() and testingF(). If 'isSubstring' is true, the pattern matches
+     * anywhere in the name, without wildcards. Otherwise, '*' matches any
+     * sequence of characters, and '?' matches any single character.
+     */
+    static FilterRule compile(const char* testClass, const char* pattern,
+        size_t length, bool isSubstring, bool isInclude);
+
+    /** Return true if the rule matches the name of a test. */
+    bool matches(const FCString& name) const;
+
+    /**
+     * Same as matches(name), with the 'length' and the 'hash' of the name
+     * computed once by the caller for all the rules.
+     */
+    bool matches(const FCString& name, size_t length, uint16_t hash) const;
+
+    /** Return true if this is an include rule. */
+    bool isInclude() const { return mIsInclude; }
+
+  private:
+    enum class Kind : uint8_t {
+      kExact, // no wildcard
+      kPrefix, // single trailing '*'
+      kGlob, // any other combination of '*' and '?'
+      kSubstring, // includesub() or excludesub()
+    };
+
+    const char* mTestClass;
+    const char* mPattern;
+    uint16_t mTestClassLength;
+    uint16_t mLength;
+    uint16_t mHash; // hash of the whole name matched by kExact
+    Kind mKind;
+    bool mIsInclude;
+};
+
+/**
+ * Apply the 'rules' in a single pass over the linked list of tests starting
+ * at 'root'. The result is the same as applying each rule in order to all
+ * tests: the last rule matching a test determines whether it is included or
+ * excluded. If 'isExcludedByDefault' is true, the tests which do not match any
+ * rule are excluded, otherwise they are left unchanged.
+ */
+void applyFilters(Test** root, const FilterRule* rules, size_t numRules,
+    bool isExcludedByDefault);
+
+/** Same as applyFilters() on a list, for the array of tests [begin, end). */
+void applyFilters(Test* const* begin, Test* const* end,
+    const FilterRule* rules, size_t numRules, bool isExcludedByDefault);
+
+}
+}
+
+#endif
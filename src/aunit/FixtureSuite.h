@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_FIXTURE_SUITE_H
+#define AUNIT_FIXTURE_SUITE_H
+
+#include <stdint.h>
+
+namespace aunit {
+namespace internal {
+
+/**
+ * The suite of all the testF() and testingF() tests of one fixture class
+ * which defines the static setupSuite() or teardownSuite() methods. A single
+ * instance is shared by all the tests of the class (see Test::initSuite()),
+ * and keeps track of whether setupSuite() has been called, and of the number
+ * of tests of the suite which are currently running. The TestRunner opens the
+ * suite before the setup() of its first test, and closes it after the
+ * teardown() of its last test.
+ */
+class FixtureSuite {
+  public:
+    /** Type of the static setupSuite() and teardownSuite() methods. */
+    typedef void (*Hook)();
+
+    FixtureSuite(Hook setupHook, Hook teardownHook):
+        mSetupHook(setupHook),
+        mTeardownHook(teardownHook) {}
+
+    /** Return true if setupSuite() was called, but not teardownSuite(). */
+    bool isOpen() const { return mIsOpen; }
+
+    /** Return the number of tests of the suite which are running. */
+    uint16_t getNumActive() const { return mNumActive; }
+
+    /**
+     * Called before the setup() of a test of the suite. Calls setupSuite() if
+     * the suite is not already open.
+     */
+    void open() {
+      if (!mIsOpen) {
+        mIsOpen = true;
+        mSetupHook();
+      }
+      mNumActive++;
+    }
+
+    /** Called after the teardown() of a test of the suite. */
+    void release() { mNumActive--; }
+
+    /** Call teardownSuite(). The suite may be opened again later. */
+    void close() {
+      mIsOpen = false;
+      mTeardownHook();
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    FixtureSuite(const FixtureSuite&) = delete;
+    FixtureSuite& operator=(const FixtureSuite&) = delete;
+
+    Hook mSetupHook;
+    Hook mTeardownHook;
+    uint16_t mNumActive = 0;
+    bool mIsOpen = false;
+};
+
+}
+}
+
+#endif
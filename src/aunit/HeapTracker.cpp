@@ -0,0 +1,186 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <Arduino.h> // ESP.getFreeHeap()
+#include <stdlib.h> // malloc(), free(), abort()
+#include "HeapTracker.h"
+
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+#if defined(EPOXY_DUINO)
+  #include <new>
+#endif
+
+namespace aunit {
+namespace internal {
+
+AUNIT_THREAD_LOCAL HeapTracker* HeapTracker::sCurrent = nullptr;
+
+namespace {
+
+// Add 'delta' bytes to the memory in use, and raise the peak if needed.
+void addInUse(Test::HeapUsage& usage, long delta) {
+  usage.inUseBytes += delta;
+  if (usage.inUseBytes > 0
+      && (unsigned long) usage.inUseBytes > usage.peakBytes) {
+    usage.peakBytes = usage.inUseBytes;
+  }
+}
+
+}
+
+#if defined(EPOXY_DUINO)
+
+HeapTracker::HeapTracker(Test::HeapUsage* usage):
+    mUsage(usage),
+    mPrevious(sCurrent) {
+  sCurrent = this;
+}
+
+HeapTracker::~HeapTracker() {
+  sCurrent = mPrevious;
+}
+
+Test::HeapUsage HeapTracker::getUsage() const {
+  return mUsage ? *mUsage : Test::HeapUsage();
+}
+
+void HeapTracker::recordAlloc(size_t size) {
+  if (sCurrent == nullptr || sCurrent->mUsage == nullptr) return;
+  Test::HeapUsage& usage = *sCurrent->mUsage;
+  usage.allocCount++;
+  usage.allocBytes += size;
+  addInUse(usage, size);
+}
+
+void HeapTracker::recordFree(size_t size) {
+  if (sCurrent == nullptr || sCurrent->mUsage == nullptr) return;
+  addInUse(*sCurrent->mUsage, -(long) size);
+}
+
+#else
+
+HeapTracker::HeapTracker(Test::HeapUsage* usage):
+    mUsage(usage),
+    mPrevious(sCurrent),
+    mFreeHeap(ESP.getFreeHeap()) {
+  sCurrent = this;
+}
+
+HeapTracker::~HeapTracker() {
+  if (mUsage) {
+    addInUse(*mUsage, (long) mFreeHeap - (long) ESP.getFreeHeap());
+  }
+  sCurrent = mPrevious;
+}
+
+Test::HeapUsage HeapTracker::getUsage() const {
+  if (mUsage == nullptr) return Test::HeapUsage();
+  Test::HeapUsage usage = *mUsage;
+  addInUse(usage, (long) mFreeHeap - (long) ESP.getFreeHeap());
+  return usage;
+}
+
+#endif
+
+}
+}
+
+#if defined(EPOXY_DUINO)
+
+namespace {
+
+// Each block starts with a header which holds the size requested by the
+// caller, padded to keep the alignment guaranteed by malloc().
+const size_t kHeaderSize = alignof(max_align_t);
+
+void* allocate(size_t size) {
+  uint8_t* block = static_cast<uint8_t*>(malloc(kHeaderSize + size));
+  if (block == nullptr) return nullptr;
+  *reinterpret_cast<size_t*>(block) = size;
+  aunit::internal::HeapTracker::recordAlloc(size);
+  return block + kHeaderSize;
+}
+
+void* allocateOrDie(size_t size) {
+  void* p = allocate(size);
+  if (p == nullptr) {
+  #if defined(__cpp_exceptions)
+    throw std::bad_alloc();
+  #else
+    abort();
+  #endif
+  }
+  return p;
+}
+
+void deallocate(void* p) {
+  if (p == nullptr) return;
+  uint8_t* block = static_cast<uint8_t*>(p) - kHeaderSize;
+  aunit::internal::HeapTracker::recordFree(
+      *reinterpret_cast<size_t*>(block));
+  free(block);
+}
+
+}
+
+// The aligned variants of the standard library do not call these, so the
+// blocks of over-aligned types are not recorded.
+
+void* operator new(size_t size) { return allocateOrDie(size); }
+
+void* operator new[](size_t size) { return allocateOrDie(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void* p) noexcept { deallocate(p); }
+
+void operator delete[](void* p) noexcept { deallocate(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  deallocate(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+
+void operator delete(void* p, size_t) noexcept { deallocate(p); }
+
+void operator delete[](void* p, size_t) noexcept { deallocate(p); }
+
+#endif
+
+#endif
+
+#endif
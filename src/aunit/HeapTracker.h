@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_HEAP_TRACKER_H
+#define AUNIT_HEAP_TRACKER_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include "Config.h"
+#include "Test.h"
+
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+#if !defined(EPOXY_DUINO) && !defined(ESP8266) && !defined(ESP32)
+  #error AUNIT_ENABLE_HEAP_TRACKING requires EpoxyDuino, ESP8266 or ESP32
+#endif
+
+namespace aunit {
+namespace internal {
+
+/**
+ * Records the heap memory allocated by the current thread into the
+ * Test::HeapUsage of a test, while an instance of this class is in scope. The
+ * TestRunner creates one around each call to the setup(), loop() and
+ * teardown() methods of a test. A tracker with a nullptr usage suspends the
+ * recording, to hide the allocations made by the TestRunner itself on behalf
+ * of the test (e.g. the buffer of its output).
+ *
+ * On EpoxyDuino, the global operator new and operator delete defined in
+ * HeapTracker.cpp record every allocation. The size of each block is stored
+ * in front of it, so that operator delete knows how many bytes are freed.
+ * Memory obtained directly with malloc() is not recorded. On the ESP8266 and
+ * ESP32, the free heap is sampled when the tracker is created and destroyed,
+ * so only the memory in use and its peak at the end of each call are known.
+ */
+class HeapTracker {
+  public:
+    /** Start recording into 'usage', or suspend the recording if nullptr. */
+    explicit HeapTracker(Test::HeapUsage* usage);
+
+    /** Restore the previous tracker of the current thread. */
+    ~HeapTracker();
+
+    /** Return the tracker of the current thread, or nullptr if none. */
+    static const HeapTracker* getCurrent() { return sCurrent; }
+
+    /**
+     * Return the usage recorded so far, including the current call of the
+     * test. All zeros if the recording is suspended.
+     */
+    Test::HeapUsage getUsage() const;
+
+  #if defined(EPOXY_DUINO)
+    /** Record an allocation of 'size' bytes. Called by operator new. */
+    static void recordAlloc(size_t size);
+
+    /** Record that 'size' bytes were freed. Called by operator delete. */
+    static void recordFree(size_t size);
+  #endif
+
+  private:
+    // Disable copy-constructor and assignment operator
+    HeapTracker(const HeapTracker&) = delete;
+    HeapTracker& operator=(const HeapTracker&) = delete;
+
+    Test::HeapUsage* const mUsage;
+    HeapTracker* const mPrevious;
+  #if !defined(EPOXY_DUINO)
+    const uint32_t mFreeHeap;
+  #endif
+
+    static AUNIT_THREAD_LOCAL HeapTracker* sCurrent;
+};
+
+}
+}
+
+#endif
+
+#endif
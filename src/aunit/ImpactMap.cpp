@@ -0,0 +1,247 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#if EPOXY_DUINO
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm> // std::sort()
+#include "FCString.h"
+#include "Test.h"
+#include "ImpactTracker.h"
+#include "ImpactMap.h"
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+/** Return the name of the test as a normal string. */
+const char* getCName(const FCString& name) {
+  if (name.getType() == FCString::kFStringType) {
+    // Flash strings are normal strings on EpoxyDuino.
+    return (const char*) name.getFString();
+  }
+  return name.getCString();
+}
+
+/** Remove the trailing newline and spaces of the line. */
+void trimLine(char* line) {
+  size_t length = strlen(line);
+  while (length > 0 && strchr(" \t\r\n", line[length - 1])) length--;
+  line[length] = '\0';
+}
+
+/**
+ * Remove the "." components of the path, and the ".." components which
+ * follow a normal one, e.g. "tests/Foo/../../src/a.cpp" becomes "src/a.cpp".
+ */
+std::string normalizePath(const std::string& path) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  while (start <= path.size()) {
+    size_t slash = path.find('/', start);
+    if (slash == std::string::npos) slash = path.size();
+    std::string part = path.substr(start, slash - start);
+    if (part == "..") {
+      if (!parts.empty() && parts.back() != ".." && !parts.back().empty()) {
+        parts.pop_back();
+      } else {
+        parts.push_back(part);
+      }
+    } else if (part != "." && (!part.empty() || parts.empty())) {
+      // An empty first part is the root of an absolute path.
+      parts.push_back(part);
+    }
+    start = slash + 1;
+  }
+
+  std::string normalized;
+  for (size_t i = 0; i < parts.size(); i++) {
+    if (i > 0) normalized += '/';
+    normalized += parts[i];
+  }
+  return normalized;
+}
+
+/** Return true if 'path' ends with "/suffix". */
+bool endsWithPath(const std::string& path, const std::string& suffix) {
+  return path.size() > suffix.size()
+      && path[path.size() - suffix.size() - 1] == '/'
+      && path.compare(path.size() - suffix.size(), suffix.size(), suffix)
+          == 0;
+}
+
+bool isSameFile(const std::string& a, const std::string& b) {
+  return a == b || endsWithPath(a, b) || endsWithPath(b, a);
+}
+
+}
+
+ImpactMap::Entry& ImpactMap::findOrAdd(const std::string& name) {
+  auto it = mIndex.find(name);
+  if (it != mIndex.end()) return mEntries[it->second];
+  mIndex[name] = mEntries.size();
+  mEntries.push_back(Entry());
+  mEntries.back().name = name;
+  return mEntries.back();
+}
+
+// A line is the name of the test, a space, and one of its files, which may
+// contain spaces itself.
+bool ImpactMap::load(const char* fileName) {
+  mFileName = fileName;
+  FILE* file = fopen(fileName, "r");
+  if (file == nullptr) return true;
+
+  char line[1024];
+  while (fgets(line, sizeof(line), file)) {
+    trimLine(line);
+    if (line[0] == '\0' || line[0] == '#') continue;
+    char* space = strchr(line, ' ');
+    if (space == nullptr) continue;
+    *space = '\0';
+    findOrAdd(line).files.push_back(space + 1);
+  }
+  bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+bool ImpactMap::loadChangedFiles(const char* fileName) {
+  FILE* file = fopen(fileName, "r");
+  if (file == nullptr) return false;
+
+  char line[1024];
+  while (fgets(line, sizeof(line), file)) {
+    trimLine(line);
+    if (line[0] == '\0' || line[0] == '#') continue;
+    mChangedFiles.push_back(normalizePath(line));
+  }
+  bool ok = !ferror(file);
+  fclose(file);
+  mHasChangedFiles = true;
+  return ok;
+}
+
+void ImpactMap::record(const Test& test) {
+#if AUNIT_ENABLE_IMPACT_TRACKING
+  std::vector<uintptr_t> addresses;
+  ImpactTracker::takeFootprint(&test, addresses);
+  if (!hasFile() || addresses.empty()) return;
+
+  Entry& entry = findOrAdd(getCName(test.getName()));
+  entry.files.clear();
+  entry.addresses.swap(addresses);
+  mIsRecorded = true;
+#else
+  (void) test;
+#endif
+}
+
+bool ImpactMap::isChanged(const Entry& entry) const {
+  for (const std::string& file : entry.files) {
+    for (const std::string& changed : mChangedFiles) {
+      if (isSameFile(file, changed)) return true;
+    }
+  }
+  return false;
+}
+
+void ImpactMap::select(Test** root) const {
+  for (Test* test = *root; test != nullptr; test = *test->getNext()) {
+    if (test->getLifeCycle() != Test::LifeCycle::New) continue;
+    auto it = mIndex.find(getCName(test->getName()));
+    if (it == mIndex.end()) continue;
+    if (!isChanged(mEntries[it->second])) {
+      test->setLifeCycle(Test::LifeCycle::Excluded);
+    }
+  }
+}
+
+// All the addresses are resolved by a single call to addr2line.
+bool ImpactMap::resolveAddresses() {
+#if AUNIT_ENABLE_IMPACT_TRACKING
+  std::vector<uintptr_t> addresses;
+  std::unordered_map<uintptr_t, size_t> indexes;
+  for (const Entry& entry : mEntries) {
+    for (uintptr_t address : entry.addresses) {
+      if (indexes.emplace(address, addresses.size()).second) {
+        addresses.push_back(address);
+      }
+    }
+  }
+  if (addresses.empty()) return true;
+
+  std::vector<std::string> files;
+  if (!ImpactTracker::resolveFiles(addresses, files)) {
+    fprintf(stderr, "Unable to resolve the source files with addr2line\n");
+    return false;
+  }
+  for (Entry& entry : mEntries) {
+    for (uintptr_t address : entry.addresses) {
+      const std::string& file = files[indexes[address]];
+      if (!file.empty()) entry.files.push_back(normalizePath(file));
+    }
+    entry.addresses.clear();
+    std::sort(entry.files.begin(), entry.files.end());
+    entry.files.erase(std::unique(entry.files.begin(), entry.files.end()),
+        entry.files.end());
+  }
+#endif
+  return true;
+}
+
+bool ImpactMap::save() {
+  if (!mIsRecorded) return true;
+  if (!resolveAddresses()) return false;
+
+  std::string tmpFile = mFileName + ".tmp";
+  FILE* file = fopen(tmpFile.c_str(), "w");
+  bool ok = (file != nullptr);
+  if (ok) {
+    for (const Entry& entry : mEntries) {
+      for (const std::string& name : entry.files) {
+        fprintf(file, "%s %s\n", entry.name.c_str(), name.c_str());
+      }
+    }
+    ok = !ferror(file);
+    ok = (fclose(file) == 0) && ok;
+  }
+  if (ok) {
+    ok = (rename(tmpFile.c_str(), mFileName.c_str()) == 0);
+  }
+  if (!ok) {
+    fprintf(stderr, "Unable to write impact map file '%s'\n",
+        mFileName.c_str());
+    remove(tmpFile.c_str());
+  }
+  return ok;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_IMPACT_MAP_H
+#define AUNIT_IMPACT_MAP_H
+
+#if EPOXY_DUINO
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+/**
+ * The source files executed by each test in the previous runs, persisted in a
+ * text file on EpoxyDuino with one "name file" line per file of each test.
+ * The files are recorded by the ImpactTracker if AUNIT_ENABLE_IMPACT_TRACKING
+ * is set. The TestRunner uses the map to run only the tests whose files
+ * match a list of changed files, and the tests which are not in the map.
+ * Tests which did not run keep their previous entry.
+ */
+class ImpactMap {
+  public:
+    /**
+     * Read the map from the given file, which becomes the destination of
+     * save(). A missing file is treated as empty. Return false if the file
+     * exists but cannot be read.
+     */
+    bool load(const char* fileName);
+
+    /** Return true if a file was given by load(). */
+    bool hasFile() const { return !mFileName.empty(); }
+
+    /**
+     * Read the changed files, one per line, for example the output of 'git
+     * diff --name-only'. Empty lines and lines starting with '#' are ignored.
+     * Return false if the file cannot be read.
+     */
+    bool loadChangedFiles(const char* fileName);
+
+    /** Return true if the changed files were given by loadChangedFiles(). */
+    bool hasChangedFiles() const { return mHasChangedFiles; }
+
+    /**
+     * Record the footprint of a resolved test, if it is not empty. The
+     * footprint is taken from the ImpactTracker even if there is no file, to
+     * release its memory.
+     */
+    void record(const Test& test);
+
+    /**
+     * Exclude the tests of the list at 'root' which are in the map, but none
+     * of whose files matches a changed file. A recorded file matches a changed
+     * file if one ends with the other, on a '/' boundary, so that the
+     * absolute paths of the compiler match the relative paths of git.
+     */
+    void select(Test** root) const;
+
+    /**
+     * Write the map to the file given by load(), through a temporary file
+     * which replaces the original, if a test was recorded. Return false on
+     * error.
+     */
+    bool save();
+
+  private:
+    struct Entry {
+      std::string name;
+      std::vector<std::string> files;
+
+      /** Addresses recorded in this run, resolved into 'files' by save(). */
+      std::vector<uintptr_t> addresses;
+    };
+
+    /** Return the entry of the given test name, appending it if new. */
+    Entry& findOrAdd(const std::string& name);
+
+    /** Resolve the addresses of all the entries into their files. */
+    bool resolveAddresses();
+
+    /** Return true if one of the files of the entry has changed. */
+    bool isChanged(const Entry& entry) const;
+
+    std::vector<Entry> mEntries;
+    std::unordered_map<std::string, size_t> mIndex;
+    std::string mFileName;
+    std::vector<std::string> mChangedFiles;
+    bool mHasChangedFiles = false;
+    bool mIsRecorded = false;
+};
+
+}
+}
+
+#endif
+
+#endif
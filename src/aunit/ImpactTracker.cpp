@@ -0,0 +1,225 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ImpactTracker.h"
+
+#if AUNIT_ENABLE_IMPACT_TRACKING
+
+#include <link.h> // dl_iterate_phdr()
+#include <stdio.h>
+#include <stdlib.h> // mkstemp()
+#include <string.h>
+#include <unistd.h> // readlink(), close()
+#include <algorithm> // std::all_of()
+#include <mutex>
+#include <unordered_map>
+#include "HeapTracker.h"
+
+namespace aunit {
+namespace internal {
+
+AUNIT_THREAD_LOCAL ImpactTracker* ImpactTracker::sCurrent = nullptr;
+
+namespace {
+
+// The footprints of the tests which ran since their last takeFootprint().
+// The elements of an unordered_map are never moved, so a tracker can keep a
+// pointer to the footprint of its test while the other threads add theirs.
+std::unordered_map<const Test*, std::unordered_set<uintptr_t>> footprints;
+std::mutex footprintsMutex;
+
+// Set while the hook records a call, so that the functions of the standard
+// library which it calls, if they are instrumented too, are not recorded.
+AUNIT_THREAD_LOCAL bool isRecording = false;
+
+/** Return the footprint of the test, created empty if needed. */
+std::unordered_set<uintptr_t>* findFootprint(const Test* test) {
+  std::lock_guard<std::mutex> lock(footprintsMutex);
+  return &footprints[test];
+}
+
+/** The address range of a loaded segment of the executable. */
+struct Segment {
+  uintptr_t start;
+  uintptr_t end;
+};
+
+/** The load bias and the segments of the executable itself. */
+struct Executable {
+  uintptr_t bias;
+  std::vector<Segment> segments;
+};
+
+// The executable is the first object reported by dl_iterate_phdr().
+int findExecutable(struct dl_phdr_info* info, size_t /*size*/, void* data) {
+  Executable* executable = (Executable*) data;
+  executable->bias = info->dlpi_addr;
+  for (int i = 0; i < info->dlpi_phnum; i++) {
+    const ElfW(Phdr)& header = info->dlpi_phdr[i];
+    if (header.p_type != PT_LOAD) continue;
+    uintptr_t start = info->dlpi_addr + header.p_vaddr;
+    executable->segments.push_back({start, start + header.p_memsz});
+  }
+  return 1;
+}
+
+bool isInSegments(const std::vector<Segment>& segments, uintptr_t address) {
+  for (const Segment& segment : segments) {
+    if (address >= segment.start && address < segment.end) return true;
+  }
+  return false;
+}
+
+/**
+ * Return the file of a "file:line" line of addr2line, which may also end
+ * with " (discriminator N)", or an empty string if the file is unknown.
+ */
+std::string parseFile(const char* line) {
+  std::string location(line);
+  size_t end = location.find(" (");
+  if (end != std::string::npos) location.resize(end);
+  size_t colon = location.rfind(':');
+  if (colon != std::string::npos) location.resize(colon);
+  if (location.empty() || location.compare(0, 2, "??") == 0) return "";
+  return location;
+}
+
+}
+
+ImpactTracker::ImpactTracker(const Test* test):
+    mFootprint(findFootprint(test)),
+    mPrevious(sCurrent) {
+  sCurrent = this;
+}
+
+ImpactTracker::~ImpactTracker() {
+  sCurrent = mPrevious;
+}
+
+void ImpactTracker::takeFootprint(const Test* test,
+    std::vector<uintptr_t>& addresses) {
+  std::lock_guard<std::mutex> lock(footprintsMutex);
+  auto it = footprints.find(test);
+  if (it == footprints.end()) return;
+  addresses.insert(addresses.end(), it->second.begin(), it->second.end());
+  footprints.erase(it);
+}
+
+__attribute__((no_instrument_function))
+void ImpactTracker::recordCall(void* fn) {
+  if (sCurrent == nullptr || isRecording) return;
+  isRecording = true;
+  std::unordered_set<uintptr_t>& footprint = *sCurrent->mFootprint;
+  uintptr_t address = (uintptr_t) fn;
+  if (footprint.find(address) == footprint.end()) {
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    // Not an allocation of the test.
+    HeapTracker untracked(nullptr);
+  #endif
+    footprint.insert(address);
+  }
+  isRecording = false;
+}
+
+// The addresses are written to a temporary file which is the input of a
+// single addr2line process, which prints one "file:line" line per address.
+bool ImpactTracker::resolveFiles(const std::vector<uintptr_t>& addresses,
+    std::vector<std::string>& files) {
+  files.clear();
+  Executable executable;
+  dl_iterate_phdr(findExecutable, &executable);
+
+  char exePath[1024];
+  ssize_t length = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+  if (length <= 0) return false;
+  exePath[length] = '\0';
+
+  char tmpFile[] = "/tmp/aunit-impact-XXXXXX";
+  int fd = mkstemp(tmpFile);
+  if (fd < 0) return false;
+  FILE* input = fdopen(fd, "w");
+  if (input == nullptr) {
+    close(fd);
+    remove(tmpFile);
+    return false;
+  }
+  bool isAnyInExecutable = false;
+  for (uintptr_t address : addresses) {
+    // Address 0 is unknown, which keeps one output line per address.
+    unsigned long offset = isInSegments(executable.segments, address)
+        ? (unsigned long) (address - executable.bias)
+        : 0;
+    if (offset != 0) isAnyInExecutable = true;
+    fprintf(input, "%lx\n", offset);
+  }
+  bool ok = !ferror(input);
+  ok = (fclose(input) == 0) && ok;
+
+  std::string command = std::string("addr2line -e '") + exePath + "' < "
+      + tmpFile;
+  FILE* output = ok ? popen(command.c_str(), "r") : nullptr;
+  if (output != nullptr) {
+    char line[1024];
+    while (files.size() < addresses.size()
+        && fgets(line, sizeof(line), output)) {
+      line[strcspn(line, "\r\n")] = '\0';
+      files.push_back(parseFile(line));
+    }
+    ok = (pclose(output) == 0) && files.size() == addresses.size();
+  } else {
+    ok = false;
+  }
+  remove(tmpFile);
+
+  // addr2line prints "??:?" for every address of a program without debug
+  // information, which would silently give an empty map.
+  if (ok && isAnyInExecutable && std::all_of(files.begin(), files.end(),
+      [](const std::string& file) { return file.empty(); })) {
+    fprintf(stderr, "No debug information in '%s', "
+        "build with -g to map the functions to their source files\n",
+        exePath);
+    ok = false;
+  }
+  return ok;
+}
+
+}
+}
+
+extern "C" {
+
+// The hooks of '-finstrument-functions'. They are not instrumented
+// themselves, otherwise they would call themselves recursively.
+__attribute__((no_instrument_function))
+void __cyg_profile_func_enter(void* fn, void* /*callSite*/) {
+  aunit::internal::ImpactTracker::recordCall(fn);
+}
+
+__attribute__((no_instrument_function))
+void __cyg_profile_func_exit(void* /*fn*/, void* /*callSite*/) {}
+
+}
+
+#endif
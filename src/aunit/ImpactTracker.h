@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_IMPACT_TRACKER_H
+#define AUNIT_IMPACT_TRACKER_H
+
+#include "Config.h"
+
+#if AUNIT_ENABLE_IMPACT_TRACKING
+
+#if !defined(EPOXY_DUINO) || !defined(__linux__)
+  #error AUNIT_ENABLE_IMPACT_TRACKING requires EpoxyDuino on Linux
+#endif
+
+#include <stdint.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+/**
+ * Records the functions executed by a test into its footprint, while an
+ * instance of this class is in scope. The TestRunner creates one around each
+ * call to the setup(), loop() and teardown() methods of a test, like the
+ * HeapTracker.
+ *
+ * The functions are reported by the __cyg_profile_func_enter() hook which GCC
+ * and Clang call on the entry of every function compiled with the
+ * '-finstrument-functions' flag, so only the code compiled with that flag is
+ * seen. The addresses are mapped to their source files by resolveFiles(),
+ * using the debug information of the program ('-g').
+ */
+class ImpactTracker {
+  public:
+    /** Start recording into the footprint of 'test'. */
+    explicit ImpactTracker(const Test* test);
+
+    /** Restore the previous tracker of the current thread. */
+    ~ImpactTracker();
+
+    /**
+     * Move the addresses of the functions executed by 'test' so far into
+     * 'addresses', and forget them.
+     */
+    static void takeFootprint(const Test* test,
+        std::vector<uintptr_t>& addresses);
+
+    /**
+     * Set 'files' to the source files of the functions at 'addresses', in
+     * the same order, by running the 'addr2line' program of binutils on the
+     * executable. The file is empty for an address without debug information
+     * or outside of the executable. Return false if addr2line failed, or if
+     * none of the addresses has debug information, i.e. the program was not
+     * compiled with '-g', which is reported on stderr.
+     */
+    static bool resolveFiles(const std::vector<uintptr_t>& addresses,
+        std::vector<std::string>& files);
+
+    /** Record the entry of the function at 'fn'. Called by the hook. */
+    static void recordCall(void* fn);
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ImpactTracker(const ImpactTracker&) = delete;
+    ImpactTracker& operator=(const ImpactTracker&) = delete;
+
+    std::unordered_set<uintptr_t>* const mFootprint;
+    ImpactTracker* const mPrevious;
+
+    static AUNIT_THREAD_LOCAL ImpactTracker* sCurrent;
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,188 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print, F()
+#include "Config.h"
+#include "Printer.h"
+#include "Test.h"
+#include "print_util.h"
+#include "JUnitReporter.h"
+
+namespace aunit {
+
+namespace {
+
+/**
+ * A Print which captures the latest message of a test into a fixed buffer,
+ * truncating anything which does not fit. The latest message is kept because
+ * a failed assertion terminates the test, so its message is normally the last
+ * one.
+ */
+class MessageBuffer: public Print {
+  public:
+    void begin(const Test* test) {
+      mTest = test;
+      mLength = 0;
+    }
+
+    /**
+     * Return the length of the message captured for the test, without the
+     * trailing newline.
+     */
+    uint8_t length(const Test& test) const {
+      if (&test != mTest) return 0;
+      uint8_t length = mLength;
+      while (length > 0
+          && (mBuffer[length - 1] == '\n' || mBuffer[length - 1] == '\r')) {
+        length--;
+      }
+      return length;
+    }
+
+    const char* data() const { return mBuffer; }
+
+    /** Release the buffer if it holds the messages of the test. */
+    void clear(const Test& test) {
+      if (&test != mTest) return;
+      mTest = nullptr;
+      mLength = 0;
+    }
+
+    size_t write(uint8_t c) override {
+      if (mLength >= JUnitReporter::kMaxMessageSize) return 0;
+      mBuffer[mLength++] = c;
+      return 1;
+    }
+
+  private:
+    char mBuffer[JUnitReporter::kMaxMessageSize];
+    const Test* mTest = nullptr;
+    uint8_t mLength = 0;
+};
+
+AUNIT_THREAD_LOCAL MessageBuffer messageBuffer;
+
+/**
+ * Print the characters as XML character data or attribute value. Stop at the
+ * first newline if 'isFirstLine' is true.
+ */
+void printEscaped(Print* printer, const char* s, uint8_t length,
+    bool isFirstLine) {
+  for (uint8_t i = 0; i < length; i++) {
+    char c = s[i];
+    switch (c) {
+      case '<':
+        printer->print(F("&lt;"));
+        break;
+      case '>':
+        printer->print(F("&gt;"));
+        break;
+      case '&':
+        printer->print(F("&amp;"));
+        break;
+      case '"':
+        printer->print(F("&quot;"));
+        break;
+      case '\r':
+        break;
+      case '\n':
+        if (isFirstLine) return;
+        printer->print(c);
+        break;
+      default:
+        printer->print(c);
+        break;
+    }
+  }
+}
+
+}
+
+void JUnitReporter::beginRun(uint16_t numTests, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->println(F("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
+  printer->print(F("<testsuite name=\"AUnit\" tests=\""));
+  printer->print(numTests);
+  printer->println(F("\">"));
+}
+
+Print* JUnitReporter::beginMessage(const Test* test) {
+  messageBuffer.begin(test);
+  return &messageBuffer;
+}
+
+void JUnitReporter::printLocation(Print* printer, const char* file,
+    uint16_t line) {
+  internal::printPathLocation(printer, file, line);
+}
+
+// Test names are C++ identifiers, so they do not need to be escaped.
+void JUnitReporter::endTest(const Test& test, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("  <testcase classname=\"AUnit\" name=\""));
+  test.getName().print(printer);
+#if AUNIT_ENABLE_TIMING
+  printer->print(F("\" time=\""));
+  internal::printSeconds(printer, test.getTiming().totalMicros() / 1000);
+#endif
+  printer->print('"');
+
+  const char* message = messageBuffer.data();
+  uint8_t length = messageBuffer.length(test);
+  switch (test.getStatus()) {
+    case Test::Status::Failed:
+      printer->print(F("><failure message=\""));
+      printEscaped(printer, message, length, true /*isFirstLine*/);
+      printer->print(F("\">"));
+      printEscaped(printer, message, length, false /*isFirstLine*/);
+      printer->println(F("</failure></testcase>"));
+      break;
+    case Test::Status::Expired:
+      printer->print(F("><failure type=\"timeout\" message=\"timed out\">"));
+      printEscaped(printer, message, length, false /*isFirstLine*/);
+      printer->println(F("</failure></testcase>"));
+      break;
+    case Test::Status::Skipped:
+      printer->println(F("><skipped/></testcase>"));
+      break;
+    default:
+      if (length > 0) {
+        printer->print(F("><system-out>"));
+        printEscaped(printer, message, length, false /*isFirstLine*/);
+        printer->println(F("</system-out></testcase>"));
+      } else {
+        printer->println(F("/>"));
+      }
+      break;
+  }
+
+  messageBuffer.clear(test);
+}
+
+void JUnitReporter::endRun(const RunSummary& /*summary*/,
+    Verbosity /*verbosity*/) {
+  Printer::getBufferedPrinter()->println(F("</testsuite>"));
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_JUNIT_REPORTER_H
+#define AUNIT_JUNIT_REPORTER_H
+
+#include "Reporter.h"
+
+namespace aunit {
+
+/**
+ * A Reporter which writes a JUnit XML document, with a <testcase> element for
+ * each test inside a single <testsuite>. The elements are streamed as the
+ * tests are resolved, so the number of failures is not known in advance and
+ * only the 'tests' attribute is written on the <testsuite>.
+ *
+ * The latest message of a test (usually the failed assertion) is captured in a
+ * fixed buffer of kMaxMessageSize bytes (one per thread on EpoxyDuino) and is
+ * written as the body of the <failure> element, or of a <system-out> element
+ * if the test did not fail. Longer messages are truncated. The messages keep
+ * the full path of their file with AUNIT_INTERN_FILE_NAMES, since they are
+ * captured on their own.
+ */
+class JUnitReporter: public Reporter {
+  public:
+    /** Size of the buffer holding the latest message of a test. */
+    static const uint8_t kMaxMessageSize = 128;
+
+    /** Constructor. */
+    JUnitReporter() {}
+
+    void beginRun(uint16_t numTests, Verbosity verbosity) override;
+
+    Print* beginMessage(const Test* test) override;
+
+    void printLocation(Print* printer, const char* file, uint16_t line)
+        override;
+
+    void endTest(const Test& test, Verbosity verbosity) override;
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,237 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print, F()
+#include "Config.h"
+#include "Printer.h"
+#include "Test.h"
+#include "print_util.h"
+#include "JsonLinesReporter.h"
+
+namespace aunit {
+
+namespace {
+
+/**
+ * A Print which forwards to the Printer, escaping the characters written to
+ * it as the content of a JSON string. The trailing newline of a message is
+ * dropped instead of being escaped, by deferring each newline until the next
+ * character arrives. Carriage returns are dropped.
+ */
+class JsonStringPrint: public Print {
+  public:
+    void begin(Print* printer) {
+      mPrinter = printer;
+      mHasNewline = false;
+    }
+
+    size_t write(uint8_t c) override {
+      if (c == '\r') return 1;
+      if (mHasNewline) {
+        mPrinter->print(F("\\n"));
+        mHasNewline = false;
+      }
+      switch (c) {
+        case '\n':
+          mHasNewline = true;
+          break;
+        case '"':
+          mPrinter->print(F("\\\""));
+          break;
+        case '\\':
+          mPrinter->print(F("\\\\"));
+          break;
+        case '\t':
+          mPrinter->print(F("\\t"));
+          break;
+        default:
+          if (c < 0x20) {
+            mPrinter->print(F("\\u00"));
+            mPrinter->print(kHexDigits[c >> 4]);
+            mPrinter->print(kHexDigits[c & 0xF]);
+          } else {
+            mPrinter->write(c);
+          }
+          break;
+      }
+      return 1;
+    }
+
+  private:
+    static const char kHexDigits[];
+
+    Print* mPrinter = nullptr;
+    bool mHasNewline = false;
+};
+
+const char JsonStringPrint::kHexDigits[] = "0123456789abcdef";
+
+AUNIT_THREAD_LOCAL JsonStringPrint jsonStringPrint;
+
+/** Print the name of the test as a quoted JSON string. */
+void printName(Print* printer, const Test& test) {
+  printer->print('"');
+  jsonStringPrint.begin(printer);
+  test.getName().print(&jsonStringPrint);
+  printer->print('"');
+}
+
+const __FlashStringHelper* statusName(Test::Status status) {
+  switch (status) {
+    case Test::Status::Passed:
+      return F("passed");
+    case Test::Status::Failed:
+      return F("failed");
+    case Test::Status::Skipped:
+      return F("skipped");
+    case Test::Status::Expired:
+      return F("expired");
+    default:
+      return F("unknown");
+  }
+}
+
+}
+
+void JsonLinesReporter::beginRun(uint16_t numTests, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("{\"event\":\"start\",\"tests\":"));
+  printer->print(numTests);
+  printer->println('}');
+}
+
+Print* JsonLinesReporter::beginMessage(const Test* test) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("{\"event\":\"message\","));
+  if (test) {
+    printer->print(F("\"test\":"));
+    printName(printer, *test);
+    printer->print(',');
+  }
+  printer->print(F("\"text\":\""));
+  jsonStringPrint.begin(printer);
+  return &jsonStringPrint;
+}
+
+void JsonLinesReporter::endMessage() {
+  Printer::getBufferedPrinter()->println(F("\"}"));
+}
+
+void JsonLinesReporter::printLocation(Print* printer, const char* file,
+    uint16_t line) {
+  internal::printPathLocation(printer, file, line);
+}
+
+void JsonLinesReporter::endTest(const Test& test, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("{\"event\":\"test\",\"name\":"));
+  printName(printer, test);
+  printer->print(F(",\"status\":\""));
+  printer->print(statusName(test.getStatus()));
+  printer->print('"');
+  if (test.isTestTimeout()) {
+    printer->print(F(",\"testTimeout\":true"));
+  }
+#if AUNIT_ENABLE_TIMING
+  if (test.isStarted()) {
+    printer->print(F(",\"micros\":"));
+    printer->print(test.getTiming().totalMicros());
+  }
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+  if (test.isStarted()) {
+    const Test::HeapUsage& usage = test.getHeapUsage();
+    printer->print(F(",\"heap\":{\"allocs\":"));
+    printer->print(usage.allocCount);
+    printer->print(F(",\"bytes\":"));
+    printer->print(usage.allocBytes);
+    printer->print(F(",\"peak\":"));
+    printer->print(usage.peakBytes);
+    printer->print(F(",\"inUse\":"));
+    printer->print(usage.inUseBytes);
+    printer->print('}');
+  }
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+  if (test.isStarted()) {
+    printer->print(F(",\"stack\":"));
+    printer->print(test.getStackUsage());
+  }
+#endif
+  printer->println('}');
+}
+
+void JsonLinesReporter::endRun(const RunSummary& summary,
+    Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("{\"event\":\"end\",\"tests\":"));
+  printer->print(summary.count);
+  printer->print(F(",\"passed\":"));
+  printer->print(summary.passedCount);
+  printer->print(F(",\"failed\":"));
+  printer->print(summary.failedCount);
+  printer->print(F(",\"skipped\":"));
+  printer->print(summary.skippedCount);
+  printer->print(F(",\"expired\":"));
+  printer->print(summary.expiredCount);
+  printer->print(F(",\"testTimeouts\":"));
+  printer->print(summary.testTimeoutCount);
+  printer->print(F(",\"millis\":"));
+  printer->print(summary.durationMillis);
+  printer->println('}');
+}
+
+// The per-test counts are reported only for the tests which failed at least
+// once, to keep the line short.
+void JsonLinesReporter::endRepeat(const RepeatSummary& summary,
+    Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("{\"event\":\"repeat\",\"iterations\":"));
+  printer->print(summary.iterationCount);
+  printer->print(F(",\"failed\":"));
+  printer->print(summary.failedIterationCount);
+  printer->print(F(",\"millis\":"));
+  printer->print(summary.durationMillis);
+#if AUNIT_ENABLE_REPEAT_STATS
+  printer->print(F(",\"tests\":["));
+  bool isFirst = true;
+  for (Test* test = summary.tests; test != nullptr; test = *test->getNext()) {
+    const Test::RepeatStats& stats = test->getRepeatStats();
+    if (stats.failedCount == 0) continue;
+    if (!isFirst) printer->print(',');
+    isFirst = false;
+    printer->print(F("{\"name\":"));
+    printName(printer, *test);
+    printer->print(F(",\"passed\":"));
+    printer->print(stats.passedCount);
+    printer->print(F(",\"failed\":"));
+    printer->print(stats.failedCount);
+    printer->print('}');
+  }
+  printer->print(']');
+#endif
+  printer->println('}');
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_JSON_LINES_REPORTER_H
+#define AUNIT_JSON_LINES_REPORTER_H
+
+#include "Reporter.h"
+
+namespace aunit {
+
+/**
+ * A Reporter which writes one JSON object per line (JSON Lines). Every line
+ * is a complete event with an "event" field of "start", "message", "test" or
+ * "end", followed by a "repeat" event when the TestRunner repeats the run.
+ * Each line is streamed to the Printer as it is generated, so nothing
+ * is accumulated in memory. For example:
+ *
+ * @verbatim
+ * {"event":"start","tests":2}
+ * {"event":"message","test":"bad","text":"Test.ino:3: Assertion failed: ..."}
+ * {"event":"test","name":"bad","status":"failed","micros":120}
+ * {"event":"test","name":"good","status":"passed","micros":42}
+ * {"event":"end","tests":2,"passed":1,"failed":1,"skipped":0,"expired":0,...}
+ * @endverbatim
+ *
+ * The "micros" field is present only if AUNIT_ENABLE_TIMING is set, and a
+ * test which exceeded its own timeout has a "testTimeout":true field. If
+ * AUNIT_ENABLE_HEAP_TRACKING is set, a started test also has a
+ * "heap":{"allocs":N,"bytes":N,"peak":N,"inUse":N} field, and a "stack":N
+ * field if AUNIT_ENABLE_STACK_TRACKING is set. The "repeat" event has the
+ * "iterations", "failed" and "millis" fields, and a "tests" array with the
+ * "name", "passed" and "failed" counts of the tests which failed at least
+ * once if AUNIT_ENABLE_REPEAT_STATS is set. The "text" of a message keeps the
+ * full path of its file with AUNIT_INTERN_FILE_NAMES, so that each event can
+ * be read on its own.
+ */
+class JsonLinesReporter: public Reporter {
+  public:
+    /** Constructor. */
+    JsonLinesReporter() {}
+
+    void beginRun(uint16_t numTests, Verbosity verbosity) override;
+
+    Print* beginMessage(const Test* test) override;
+
+    void endMessage() override;
+
+    void printLocation(Print* printer, const char* file, uint16_t line)
+        override;
+
+    void endTest(const Test& test, Verbosity verbosity) override;
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override;
+
+    void endRepeat(const RepeatSummary& summary, Verbosity verbosity)
+        override;
+};
+
+}
+
+#endif
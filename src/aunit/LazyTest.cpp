@@ -0,0 +1,71 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "LazyTest.h"
+
+namespace aunit {
+
+// Each call to the fixture object is bracketed by setting sMessageOwner, so
+// that the messages of its assertions are attributed to the descriptor by the
+// Reporter, which identifies the tests by their address (e.g. JUnitReporter).
+
+void LazyTest::setup() {
+  Test::setup();
+  mTest = mCreate();
+  mTest->enableVerbosity(getVerbosity());
+
+  sMessageOwner = this;
+  mTest->setup();
+  sMessageOwner = nullptr;
+  copyStatus();
+}
+
+void LazyTest::loop() {
+  sMessageOwner = this;
+  mTest->loop();
+  sMessageOwner = nullptr;
+  copyStatus();
+}
+
+void LazyTest::teardown() {
+  if (mTest != nullptr) {
+    sMessageOwner = this;
+    mTest->teardown();
+    sMessageOwner = nullptr;
+    mDestroy(mTest);
+    mTest = nullptr;
+  }
+  Test::teardown();
+}
+
+void LazyTest::copyStatus() {
+  if (mTest->isTestTimeout()) {
+    expireTestTimeout();
+  } else if (mTest->isDone()) {
+    setStatus(mTest->getStatus());
+  }
+}
+
+}
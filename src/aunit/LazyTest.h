@@ -0,0 +1,95 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_LAZY_TEST_H
+#define AUNIT_LAZY_TEST_H
+
+#include "Test.h"
+
+class __FlashStringHelper;
+
+namespace aunit {
+
+/**
+ * A lightweight descriptor of a test, created by the lazyTestF() and
+ * lazyTestingF() macros, which holds only the name of the test and the
+ * functions which create and destroy the actual test object. The fixture
+ * object is constructed on the heap when the TestRunner calls setup(), and
+ * destroyed after its teardown(), so the constructors of the fixtures of the
+ * tests which are excluded by the filters are never run, and only the
+ * fixtures of the tests which are running use memory.
+ *
+ * The descriptor is the test seen by the TestRunner, the Reporter and the
+ * meta assertions. The status of the fixture object is copied to the
+ * descriptor after each call, and the messages of its assertions are reported
+ * under the name of the descriptor.
+ *
+ * The fixture object is a separate instance for each test, so the static
+ * setupSuite() and teardownSuite() methods of the fixture are not called.
+ */
+class LazyTest: public Test {
+  public:
+    /** Function which creates the fixture object on the heap. */
+    typedef Test* (*Create)();
+
+    /** Function which deletes the fixture object created by Create. */
+    typedef void (*Destroy)(Test* test);
+
+    /** Constructor with the name of the test in flash memory. */
+    LazyTest(const __FlashStringHelper* name, Create create,
+        Destroy destroy):
+        mCreate(create),
+        mDestroy(destroy) {
+      init(name);
+    }
+
+    /** Create the fixture object and call its setup(). */
+    void setup() override;
+
+    /** Call the loop() of the fixture object. */
+    void loop() override;
+
+    /** Call the teardown() of the fixture object, then destroy it. */
+    void teardown() override;
+
+    /** Return the fixture object, or nullptr if it does not exist. */
+    Test* getTest() const { return mTest; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    LazyTest(const LazyTest&) = delete;
+    LazyTest& operator=(const LazyTest&) = delete;
+
+    /** Copy the status of the fixture object, if it has been asserted. */
+    void copyStatus();
+
+    Create mCreate;
+    Destroy mDestroy;
+    Test* mTest = nullptr;
+};
+
+}
+
+#endif
@@ -374,4 +374,40 @@ SOFTWARE.
   return;\
 } while (false)
 
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+/**
+ * Assert that all the heap memory allocated by the current test so far has
+ * been freed. Requires AUNIT_ENABLE_HEAP_TRACKING.
+ */
+#define assertNoLeaks() do {\
+  if (!assertionNoLeaks(__FILE__, __LINE__))\
+    return;\
+} while (false)
+
+/**
+ * Assert that the peak heap memory used by the current test so far is at most
+ * 'maxBytes'. Requires AUNIT_ENABLE_HEAP_TRACKING.
+ */
+#define assertMaxHeap(maxBytes) do {\
+  if (!assertionMaxHeap(__FILE__, __LINE__, (maxBytes)))\
+    return;\
+} while (false)
+
+#endif
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+/**
+ * Assert that the stack used by the current test so far, including the call
+ * to this assertion, is at most 'maxBytes'. Requires
+ * AUNIT_ENABLE_STACK_TRACKING.
+ */
+#define assertMaxStack(maxBytes) do {\
+  if (!assertionMaxStack(__FILE__, __LINE__, (maxBytes)))\
+    return;\
+} while (false)
+
+#endif
+
 #endif
@@ -24,14 +24,18 @@ SOFTWARE.
 
 #include <Arduino.h>  // definition of Print
 #include "Flash.h"
-#include "Printer.h"
 #include "Verbosity.h"
 #include "Compare.h"
 #include "TestRunner.h"
+#include "HeapTracker.h"
+#include "StackTracker.h"
 #include "MetaAssertion.h"
+#include "print_util.h"
 
 namespace aunit {
 
+using internal::printLocation;
+
 // Moving these strings into PROGMEM saves 162 bytes of flash memory (from
 // elimination of a function) and 130 bytes of static memory,
 const char MetaAssertion::kMessageDone[] PROGMEM = "done";
@@ -49,16 +53,13 @@ namespace {
 
 // Print an assertion message describing whether the given 'testName' has passed
 // or failed
-void printAssertionTestStatusMessage(
+void printAssertionTestStatusMessage(Print* printer,
     bool ok, const char* file, uint16_t line,
     const char* testName, const __FlashStringHelper* statusMessage) {
   // Many of the following strings are duplicated in Assertion.cpp and
   // the compiler/linker will dedupe them.
-  Print* printer = Printer::getPrinter();
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(": Assertion ");
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
   printer->print(ok ? "passed" : "failed");
   printer->print(F(": Test "));
   printer->print(testName);
@@ -73,7 +74,9 @@ bool MetaAssertion::assertionTestStatus(const char* file, uint16_t line,
     const char* testName, const __FlashStringHelper* statusMessage, bool ok) {
   if (isDone()) return false;
   if (isOutputEnabled(ok)) {
-    printAssertionTestStatusMessage(ok, file, line, testName, statusMessage);
+    printAssertionTestStatusMessage(beginMessage(), ok, file, line, testName,
+        statusMessage);
+    endMessage();
   }
   setPassOrFail(ok);
   return ok;
@@ -83,15 +86,12 @@ namespace {
 
 // Print message for failNow() macro.
 // "{file}:{line}: Status failed."
-void printStatusNowMessage(const char* file, uint16_t line,
+void printStatusNowMessage(Print* printer, const char* file, uint16_t line,
     const __FlashStringHelper* statusString) {
   // Many of these strings are duplicated in Assertion.cpp and will be deduped
   // by the compiler/linker.
-  Print* printer = Printer::getPrinter();
-  printer->print(file);
-  printer->print(':');
-  printer->print(line);
-  printer->print(F(": Status "));
+  printLocation(printer, file, line);
+  printer->print(F("Status "));
   printer->print(statusString);
   printer->println('.');
 }
@@ -109,9 +109,98 @@ void MetaAssertion::setStatusNow(const char* file, uint16_t line,
     Status status, const __FlashStringHelper* statusString) {
   if (isDone()) return;
   if (isOutputEnabledForStatus(status)) {
-    printStatusNowMessage(file, line, statusString);
+    printStatusNowMessage(beginMessage(), file, line, statusString);
+    endMessage();
   }
   setStatus(status);
 }
 
+#if AUNIT_ENABLE_HEAP_TRACKING || AUNIT_ENABLE_STACK_TRACKING
+
+namespace {
+
+// Print message for assertNoLeaks(), assertMaxHeap() and assertMaxStack().
+// "{file}:{line}: Assertion failed: {what} is {bytes} bytes, should be
+// {op}{limit}."
+void printAssertionMemoryMessage(Print* printer, bool ok, const char* file,
+    uint16_t line, const __FlashStringHelper* what, long bytes,
+    const __FlashStringHelper* op, unsigned long limit) {
+  printLocation(printer, file, line);
+  printer->print("Assertion ");
+  printer->print(ok ? "passed" : "failed");
+  printer->print(F(": "));
+  printer->print(what);
+  printer->print(" is ");
+  printer->print(bytes);
+  printer->print(F(" bytes, should be "));
+  printer->print(op);
+  printer->print(limit);
+  printer->println('.');
+}
+
+}
+
+#endif
+
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+namespace {
+
+// Return the heap usage of the test running on the current thread.
+Test::HeapUsage currentHeapUsage() {
+  const internal::HeapTracker* tracker = internal::HeapTracker::getCurrent();
+  return tracker ? tracker->getUsage() : Test::HeapUsage();
+}
+
+}
+
+bool MetaAssertion::assertionNoLeaks(const char* file, uint16_t line) {
+  if (isDone()) return false;
+  long inUse = currentHeapUsage().inUseBytes;
+  bool ok = inUse <= 0;
+  if (isOutputEnabled(ok)) {
+    printAssertionMemoryMessage(beginMessage(), ok, file, line,
+        F("Heap in use"), inUse, F(""), 0);
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+bool MetaAssertion::assertionMaxHeap(const char* file, uint16_t line,
+    unsigned long maxBytes) {
+  if (isDone()) return false;
+  unsigned long peak = currentHeapUsage().peakBytes;
+  bool ok = peak <= maxBytes;
+  if (isOutputEnabled(ok)) {
+    printAssertionMemoryMessage(beginMessage(), ok, file, line,
+        F("Heap peak"), (long) peak, F("<= "), maxBytes);
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+#endif
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+bool MetaAssertion::assertionMaxStack(const char* file, uint16_t line,
+    unsigned long maxBytes) {
+  if (isDone()) return false;
+  const internal::StackTracker* tracker =
+      internal::StackTracker::getCurrent();
+  uint16_t used = tracker ? tracker->getUsage() : 0;
+  bool ok = used <= maxBytes;
+  if (isOutputEnabled(ok)) {
+    printAssertionMemoryMessage(beginMessage(), ok, file, line,
+        F("Stack usage"), used, F("<= "), maxBytes);
+    endMessage();
+  }
+  setPassOrFail(ok);
+  return ok;
+}
+
+#endif
+
 }
@@ -73,6 +73,32 @@ class MetaAssertion: public Assertion {
     void setStatusNow(const char* file, uint16_t line, Status status,
         const __FlashStringHelper* statusString);
 
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    /**
+     * Set the status of the current test to Failed if some of the heap memory
+     * that it allocated is still in use, and print the assertion message if
+     * requested.
+     */
+    bool assertionNoLeaks(const char* file, uint16_t line);
+
+    /**
+     * Set the status of the current test to Failed if its peak heap memory is
+     * greater than 'maxBytes', and print the assertion message if requested.
+     */
+    bool assertionMaxHeap(const char* file, uint16_t line,
+        unsigned long maxBytes);
+  #endif
+
+  #if AUNIT_ENABLE_STACK_TRACKING
+    /**
+     * Set the status of the current test to Failed if its stack usage so far
+     * is greater than 'maxBytes', and print the assertion message if
+     * requested.
+     */
+    bool assertionMaxStack(const char* file, uint16_t line,
+        unsigned long maxBytes);
+  #endif
+
   private:
     // Disable copy-constructor and assignment operator
     MetaAssertion(const MetaAssertion&) = delete;
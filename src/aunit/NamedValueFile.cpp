@@ -0,0 +1,130 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#if EPOXY_DUINO
+
+#include <stdio.h>
+#include <stdlib.h> // strtoul()
+#include <string.h>
+#include "FCString.h"
+#include "NamedValueFile.h"
+
+namespace aunit {
+namespace internal {
+
+bool NamedValueFile::load(const char* fileName) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mFileName = fileName;
+  FILE* file = fopen(fileName, "r");
+  if (file == nullptr) return true;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    char* name = strtok(line, " \t\r\n");
+    char* value = strtok(nullptr, " \t\r\n");
+    if (name == nullptr || value == nullptr || name[0] == '#') continue;
+    mEntries.emplace_back(name, strtoul(value, nullptr, 10));
+  }
+  bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+bool NamedValueFile::isEmpty() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.empty();
+}
+
+NamedValueFile::Entry::Entry(const char* name, uint32_t value) :
+    name(name),
+    hash(FCString::hash(name, strlen(name))),
+    value(value) {}
+
+size_t NamedValueFile::findIndex(const FCString& name) const {
+  uint16_t hash = name.getHash();
+  size_t length = name.length();
+  size_t i = 0;
+  for (; i < mEntries.size(); i++) {
+    const Entry& entry = mEntries[i];
+    // Compare the characters only if the length and hash match.
+    if (entry.hash == hash && entry.name.size() == length
+        && name.compareTo(FCString(entry.name.c_str())) == 0) {
+      break;
+    }
+  }
+  return i;
+}
+
+bool NamedValueFile::find(const FCString& name, uint32_t& value) const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t i = findIndex(name);
+  if (i == mEntries.size()) return false;
+  value = mEntries[i].value;
+  return true;
+}
+
+void NamedValueFile::record(const FCString& name, uint32_t value) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t i = findIndex(name);
+  if (i < mEntries.size()) {
+    mEntries[i].value = value;
+    return;
+  }
+
+  const char* cname = name.getCString();
+  if (name.getType() == FCString::kFStringType) {
+    // Flash strings are normal strings on EpoxyDuino.
+    cname = (const char*) name.getFString();
+  }
+  mEntries.emplace_back(cname, value);
+}
+
+bool NamedValueFile::save(const char* kind) const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::string tmpFile = mFileName + ".tmp";
+  FILE* file = fopen(tmpFile.c_str(), "w");
+  bool ok = (file != nullptr);
+  if (ok) {
+    for (const auto& entry : mEntries) {
+      fprintf(file, "%s %lu\n", entry.name.c_str(),
+          (unsigned long) entry.value);
+    }
+    ok = !ferror(file);
+    ok = (fclose(file) == 0) && ok;
+  }
+  if (ok) {
+    ok = (rename(tmpFile.c_str(), mFileName.c_str()) == 0);
+  }
+  if (!ok) {
+    fprintf(stderr, "Unable to write %s file '%s'\n", kind, mFileName.c_str());
+    remove(tmpFile.c_str());
+  }
+  return ok;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_NAMED_VALUE_FILE_H
+#define AUNIT_NAMED_VALUE_FILE_H
+
+#if EPOXY_DUINO
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace aunit {
+namespace internal {
+
+class FCString;
+
+/**
+ * A text file of "name value" pairs, one per line, kept in memory in file
+ * order. New names are appended. Lines starting with '#' are ignored. Used
+ * for the benchmark baselines and the recorded test durations on EpoxyDuino.
+ * The methods are thread-safe, because tests may run on worker threads (see
+ * TestRunner::setParallelism()).
+ */
+class NamedValueFile {
+  public:
+    /**
+     * Read the entries from the given file, which becomes the destination of
+     * save(). A missing file is treated as empty. Return false if the file
+     * exists but cannot be read.
+     */
+    bool load(const char* fileName);
+
+    /** Return true if a file was given by load(). */
+    bool hasFile() const { return !mFileName.empty(); }
+
+    /** Return true if there is at least one entry. */
+    bool isEmpty() const;
+
+    /** Find the value of the given name. Return true if found. */
+    bool find(const FCString& name, uint32_t& value) const;
+
+    /** Set the value of the given name, appending it if new. */
+    void record(const FCString& name, uint32_t value);
+
+    /**
+     * Write the entries to the file given by load(), through a temporary file
+     * which replaces the original. On error, print a message using 'kind' as
+     * the description of the file, and return false.
+     */
+    bool save(const char* kind) const;
+
+  private:
+    struct Entry {
+      Entry(const char* name, uint32_t value);
+
+      std::string name;
+      uint16_t hash; // same as FCString::getHash() of the name
+      uint32_t value;
+    };
+
+    /** Return the index of the given name, or mEntries.size() if missing. */
+    size_t findIndex(const FCString& name) const;
+
+    std::vector<Entry> mEntries;
+    std::string mFileName;
+    mutable std::mutex mMutex;
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -28,6 +28,11 @@ SOFTWARE.
 
 namespace aunit {
 
-Print* Printer::sPrinter = nullptr;
+#if AUNIT_PRINTER_BUFFER_SIZE > 0
+AUNIT_THREAD_LOCAL internal::BufferedPrint<AUNIT_PRINTER_BUFFER_SIZE>
+    Printer::sBuffer;
+#else
+AUNIT_THREAD_LOCAL Print* Printer::sPrinter = nullptr;
+#endif
 
 }
@@ -25,6 +25,14 @@ SOFTWARE.
 #ifndef AUNIT_PRINTER_H
 #define AUNIT_PRINTER_H
 
+#include "Config.h"
+#if AUNIT_PRINTER_BUFFER_SIZE > 0
+#include "BufferedPrint.h"
+#endif
+#if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+#include "FdPrint.h"
+#endif
+
 class Print;
 
 namespace aunit {
@@ -45,17 +53,86 @@ class Printer {
      * TestRunner. The default is the predefined Serial object. Can be changed
      * using the setPrinter() method.
      */
+  #if AUNIT_PRINTER_BUFFER_SIZE > 0
+    static Print* getPrinter() { return sBuffer.getTarget(); }
+
+    /** Set the printer, after flushing the output buffered for the old one. */
+    static void setPrinter(Print* printer) { sBuffer.setTarget(printer); }
+
+    /**
+     * Return the Print used for the messages of AUnit itself. This is a line
+     * buffer of AUNIT_PRINTER_BUFFER_SIZE bytes in front of getPrinter(),
+     * which writes each complete line to the printer in one call. Returns
+     * nullptr if the printer is not set.
+     */
+    static Print* getBufferedPrinter() {
+      Print* target = sBuffer.getTarget();
+    #if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+      // Already buffered, a line buffer would only copy the characters twice.
+      if (target == internal::FdPrint::getInstance()) return target;
+    #endif
+      return target ? &sBuffer : nullptr;
+    }
+
+    /**
+     * Write any incomplete line held by getBufferedPrinter(), and the buffer
+     * of the native output if it is the printer of this thread.
+     */
+    static void flush() {
+      sBuffer.flushBuffer();
+      flushNativeOutput();
+    }
+  #else
     static Print* getPrinter() { return sPrinter; }
 
     /** Set the printer. */
     static void setPrinter(Print* printer) { sPrinter = printer; }
 
+    /** Same as getPrinter() when AUNIT_PRINTER_BUFFER_SIZE is 0. */
+    static Print* getBufferedPrinter() { return sPrinter; }
+
+    /** Write the buffer of the native output if it is the printer. */
+    static void flush() { flushNativeOutput(); }
+  #endif
+
+    /**
+     * Called by the TestRunner before the code of a test runs, which may also
+     * write to Serial. Flushes the native output if it goes to the same
+     * stdout. No-op unless the native output is the printer.
+     */
+    static void sync() {
+    #if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+      internal::FdPrint* output = internal::FdPrint::getInstance();
+      if (getPrinter() == output) {
+      #if AUNIT_PRINTER_BUFFER_SIZE > 0
+        sBuffer.flushBuffer();
+      #endif
+        output->sync();
+      }
+    #endif
+    }
+
   private:
+    static void flushNativeOutput() {
+    #if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+      internal::FdPrint* output = internal::FdPrint::getInstance();
+      if (getPrinter() == output) output->flushBuffer();
+    #endif
+    }
+
     // Disable copy-constructor and assignment operator
     Printer(const Printer&) = delete;
     Printer& operator=(const Printer&) = delete;
 
-    static Print* sPrinter;
+    // Each worker thread of a parallel run (see TestRunner::setParallelism())
+    // captures the output of its tests into its own buffer, so the printer is
+    // per thread.
+  #if AUNIT_PRINTER_BUFFER_SIZE > 0
+    static AUNIT_THREAD_LOCAL
+        internal::BufferedPrint<AUNIT_PRINTER_BUFFER_SIZE> sBuffer;
+  #else
+    static AUNIT_THREAD_LOCAL Print* sPrinter;
+  #endif
 };
 
 }
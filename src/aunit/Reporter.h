@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_REPORTER_H
+#define AUNIT_REPORTER_H
+
+#include <stdint.h>
+#include "Config.h"
+#include "Verbosity.h"
+
+class Print;
+
+namespace aunit {
+
+class Test;
+
+/** The results of the entire run, passed to Reporter::endRun(). */
+struct RunSummary {
+  /** Total number of tests. */
+  uint16_t count;
+
+  uint16_t passedCount;
+  uint16_t failedCount;
+  uint16_t skippedCount;
+  uint16_t expiredCount;
+
+  /** Number of expired tests which exceeded their own timeout. */
+  uint16_t testTimeoutCount;
+
+  /** Duration of the run in milliseconds. */
+  unsigned long durationMillis;
+
+#if AUNIT_ENABLE_TIMING
+  /** The slowest tests, sorted by decreasing total time. */
+  Test* const* slowest;
+
+  /** Number of entries in 'slowest'. */
+  uint8_t numSlowest;
+#endif
+};
+
+/**
+ * The results of all the iterations of TestRunner::setRepeat() or
+ * TestRunner::setUntilFail(), passed to Reporter::endRepeat().
+ */
+struct RepeatSummary {
+  /** Number of iterations of the run. */
+  unsigned long iterationCount;
+
+  /** Number of iterations in which a test failed or expired. */
+  unsigned long failedIterationCount;
+
+  /** Duration of all the iterations in milliseconds. */
+  unsigned long durationMillis;
+
+#if AUNIT_ENABLE_REPEAT_STATS
+  /**
+   * The tests of the last iteration, linked by Test::getNext(), with their
+   * Test::getRepeatStats().
+   */
+  Test* tests;
+#endif
+};
+
+/**
+ * Receives the events of a run from the TestRunner, the tests and the
+ * assertions, and writes them to the Printer in some format. The events are
+ * streamed as they happen, so that a Reporter needs only a constant amount of
+ * memory regardless of the number of tests.
+ *
+ * A Reporter decides by itself how the Verbosity applies. The default
+ * TextReporter follows it exactly. The machine-readable reporters always
+ * report every test and the summary, so that their output remains valid.
+ *
+ * NOTE: Like Test, this class does not have a virtual destructor. Reporters
+ * are expected to be statically allocated.
+ */
+class Reporter {
+  public:
+    /** Return the current reporter. The default is a TextReporter. */
+    static Reporter* getReporter();
+
+    /** Set the reporter. Set to nullptr to restore the default. */
+    static void setReporter(Reporter* reporter) { sReporter = reporter; }
+
+    /** Called once before the first test runs. */
+    virtual void beginRun(uint16_t numTests, Verbosity verbosity) = 0;
+
+    /**
+     * Start a free-form message, such as an assertion message, belonging to
+     * 'test' (or to the TestRunner if nullptr). Return the Print where the
+     * message is written, which is valid until endMessage(). A message
+     * normally ends with a newline.
+     */
+    virtual Print* beginMessage(const Test* test) = 0;
+
+    /** Terminate the message started by beginMessage(). */
+    virtual void endMessage() {}
+
+    /**
+     * Print the "{file}:{line}: " location which starts an assertion message
+     * to the 'printer' returned by beginMessage(). The default prints it as
+     * text, see AUNIT_INTERN_FILE_NAMES.
+     */
+    virtual void printLocation(Print* printer, const char* file,
+        uint16_t line);
+
+    /**
+     * Called when a test is resolved. The 'verbosity' is that of the test,
+     * inherited from the TestRunner.
+     */
+    virtual void endTest(const Test& test, Verbosity verbosity) = 0;
+
+    /** Called once after the last test. */
+    virtual void endRun(const RunSummary& summary, Verbosity verbosity) = 0;
+
+    /**
+     * Called once after the last iteration when the TestRunner repeats the
+     * run, after the endRun() of that iteration. Does nothing by default.
+     */
+    virtual void endRepeat(const RepeatSummary& /*summary*/,
+        Verbosity /*verbosity*/) {}
+
+  protected:
+    /** Constructor. */
+    Reporter() {}
+
+  private:
+    // Disable copy-constructor and assignment operator
+    Reporter(const Reporter&) = delete;
+    Reporter& operator=(const Reporter&) = delete;
+
+    static Reporter* sReporter;
+};
+
+}
+
+#endif
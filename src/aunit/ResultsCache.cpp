@@ -0,0 +1,186 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#if EPOXY_DUINO
+
+#include <stdio.h> // getline()
+#include <stdlib.h> // strtoul(), free()
+#include <string.h>
+#include <algorithm> // std::stable_sort()
+#include <initializer_list>
+#include "FCString.h"
+#include "Test.h"
+#include "ResultsCache.h"
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+const char* const kStatusNames[] = {
+  "unknown", "passed", "failed", "skipped", "expired",
+};
+
+const size_t kNumStatusNames = sizeof(kStatusNames) / sizeof(kStatusNames[0]);
+
+/** Return the name of the test as a normal string. */
+const char* getCName(const FCString& name) {
+  if (name.getType() == FCString::kFStringType) {
+    // Flash strings are normal strings on EpoxyDuino.
+    return (const char*) name.getFString();
+  }
+  return name.getCString();
+}
+
+bool isFailure(uint8_t status) {
+  return status == static_cast<uint8_t>(Test::Status::Failed)
+      || status == static_cast<uint8_t>(Test::Status::Expired);
+}
+
+}
+
+bool ResultsCache::load(const char* fileName) {
+  mFileName = fileName;
+  FILE* file = fopen(fileName, "r");
+  if (file == nullptr) return true;
+
+  // getline() reads the whole line, however long the name of the test, e.g.
+  // a testF() with a long fixture name.
+  char* line = nullptr;
+  size_t capacity = 0;
+  while (getline(&line, &capacity, file) >= 0) {
+    char* name = strtok(line, " \t\r\n");
+    char* status = strtok(nullptr, " \t\r\n");
+    char* micros = strtok(nullptr, " \t\r\n");
+    if (name == nullptr || status == nullptr || name[0] == '#') continue;
+
+    Entry entry = {name, 0, 0};
+    if (micros != nullptr) entry.micros = strtoul(micros, nullptr, 10);
+    for (size_t i = 0; i < kNumStatusNames; i++) {
+      if (strcmp(status, kStatusNames[i]) == 0) entry.status = i;
+    }
+    auto it = mIndex.find(entry.name);
+    if (it != mIndex.end()) {
+      mEntries[it->second] = entry;
+    } else {
+      mIndex[entry.name] = mEntries.size();
+      mEntries.push_back(entry);
+    }
+  }
+  free(line);
+  bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+const ResultsCache::Entry* ResultsCache::find(const char* name) const {
+  auto it = mIndex.find(name);
+  return (it == mIndex.end()) ? nullptr : &mEntries[it->second];
+}
+
+void ResultsCache::record(const Test& test) {
+  Entry entry = {getCName(test.getName()),
+      static_cast<uint8_t>(test.getStatus()), 0};
+#if AUNIT_ENABLE_TIMING
+  entry.micros = test.getTiming().totalMicros();
+#endif
+  auto it = mIndex.find(entry.name);
+  if (it != mIndex.end()) {
+    mEntries[it->second] = entry;
+  } else {
+    mIndex[entry.name] = mEntries.size();
+    mEntries.push_back(entry);
+  }
+}
+
+void ResultsCache::reorder(Test** root, bool isOnlyFailed) const {
+  std::vector<Test*> failed;
+  std::vector<Test*> unknown;
+  std::vector<Test*> others;
+  for (Test* test = *root; test != nullptr; test = *test->getNext()) {
+    const Entry* entry = find(getCName(test->getName()));
+    if (entry == nullptr) {
+      unknown.push_back(test);
+    } else if (isFailure(entry->status)) {
+      failed.push_back(test);
+    } else {
+      others.push_back(test);
+    }
+  }
+
+  std::stable_sort(failed.begin(), failed.end(),
+      [this](Test* a, Test* b) {
+        return find(getCName(a->getName()))->micros
+            < find(getCName(b->getName()))->micros;
+      });
+
+  if (isOnlyFailed && !failed.empty()) {
+    for (Test* test : others) {
+      if (test->getLifeCycle() == Test::LifeCycle::New) {
+        test->setLifeCycle(Test::LifeCycle::Excluded);
+      }
+    }
+  }
+
+  // Relink the list in the new order.
+  Test** tail = root;
+  for (const std::vector<Test*>* group : {&failed, &unknown, &others}) {
+    for (Test* test : *group) {
+      *tail = test;
+      tail = test->getNext();
+    }
+  }
+  *tail = nullptr;
+}
+
+bool ResultsCache::save() const {
+  std::string tmpFile = mFileName + ".tmp";
+  FILE* file = fopen(tmpFile.c_str(), "w");
+  bool ok = (file != nullptr);
+  if (ok) {
+    for (const Entry& entry : mEntries) {
+      const char* status = (entry.status < kNumStatusNames)
+          ? kStatusNames[entry.status]
+          : kStatusNames[0];
+      fprintf(file, "%s %s %lu\n", entry.name.c_str(), status,
+          (unsigned long) entry.micros);
+    }
+    ok = !ferror(file);
+    ok = (fclose(file) == 0) && ok;
+  }
+  if (ok) {
+    ok = (rename(tmpFile.c_str(), mFileName.c_str()) == 0);
+  }
+  if (!ok) {
+    fprintf(stderr, "Unable to write cache file '%s'\n", mFileName.c_str());
+    remove(tmpFile.c_str());
+  }
+  return ok;
+}
+
+}
+}
+
+#endif
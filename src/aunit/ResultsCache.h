@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_RESULTS_CACHE_H
+#define AUNIT_RESULTS_CACHE_H
+
+#if EPOXY_DUINO
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+/**
+ * The outcome and the duration of each test in the previous runs, persisted
+ * in a text file on EpoxyDuino with one "name status micros" line per test,
+ * where the status is one of "passed", "failed", "skipped" or "expired". The
+ * TestRunner uses it to run the tests which failed the last time first, or
+ * only those. Tests which did not run keep their previous entry.
+ */
+class ResultsCache {
+  public:
+    /**
+     * Read the cache from the given file, which becomes the destination of
+     * save(). A missing file is treated as empty. Return false if the file
+     * exists but cannot be read.
+     */
+    bool load(const char* fileName);
+
+    /** Return true if a file was given by load(). */
+    bool hasFile() const { return !mFileName.empty(); }
+
+    /** Record the outcome of a resolved test. */
+    void record(const Test& test);
+
+    /**
+     * Move the tests which failed or expired in the previous run to the front
+     * of the list at 'root', the fastest first, followed by the tests which
+     * are not in the cache, followed by the others. The order within the last
+     * two groups is unchanged. If 'isOnlyFailed', the tests of the last group
+     * are excluded instead, unless there were no failed tests at all.
+     */
+    void reorder(Test** root, bool isOnlyFailed) const;
+
+    /**
+     * Write the cache to the file given by load(), through a temporary file
+     * which replaces the original. Return false on error.
+     */
+    bool save() const;
+
+  private:
+    struct Entry {
+      std::string name;
+      uint8_t status; // Test::Status
+      uint32_t micros;
+    };
+
+    /** Return the entry of the given test name, or nullptr. */
+    const Entry* find(const char* name) const;
+
+    std::vector<Entry> mEntries;
+    std::unordered_map<std::string, size_t> mIndex;
+    std::string mFileName;
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#if EPOXY_DUINO
+#include <algorithm> // std::stable_sort()
+#include <vector>
+#endif
+#include "Test.h"
+#include "Shard.h"
+#if EPOXY_DUINO
+#include "NamedValueFile.h"
+#endif
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+/**
+ * Mark the test at 'p' as skipped and finished, and take it out of the list.
+ * 'p' then points to the next test.
+ */
+void dropTest(Test** p) {
+  Test* test = *p;
+  test->setStatus(Test::Status::Skipped);
+  test->setLifeCycle(Test::LifeCycle::Finished);
+  *p = *test->getNext();
+}
+
+}
+
+void selectShard(Test** root, uint16_t index, uint16_t count) {
+  uint16_t position = 0;
+  for (Test** p = root; *p != nullptr; ) {
+    if (position == index) {
+      p = (*p)->getNext();
+    } else {
+      dropTest(p);
+    }
+    if (++position == count) position = 0;
+  }
+}
+
+#if EPOXY_DUINO
+
+void selectShard(Test** root, uint16_t index, uint16_t count,
+    const NamedValueFile& durations) {
+  struct Weight {
+    uint32_t micros;
+    bool isKnown;
+  };
+
+  // Collect the weights in list order.
+  std::vector<Weight> weights;
+  uint64_t knownMicros = 0;
+  size_t numKnown = 0;
+  for (Test** p = root; *p != nullptr; p = (*p)->getNext()) {
+    Weight weight = {0, true};
+    if ((*p)->getLifeCycle() != Test::LifeCycle::Excluded) {
+      weight.isKnown = durations.find((*p)->getName(), weight.micros);
+      if (weight.isKnown) {
+        knownMicros += weight.micros;
+        numKnown++;
+      }
+    }
+    weights.push_back(weight);
+  }
+  uint32_t defaultMicros = (numKnown > 0) ? knownMicros / numKnown : 1;
+  for (Weight& weight : weights) {
+    if (!weight.isKnown) weight.micros = defaultMicros;
+  }
+
+  // Longest first, keeping the list order on ties.
+  std::vector<size_t> order(weights.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+      [&weights](size_t a, size_t b) {
+        return weights[a].micros > weights[b].micros;
+      });
+
+  std::vector<uint64_t> loads(count, 0);
+  std::vector<uint16_t> shards(weights.size());
+  for (size_t i : order) {
+    uint16_t lightest = 0;
+    for (uint16_t shard = 1; shard < count; shard++) {
+      if (loads[shard] < loads[lightest]) lightest = shard;
+    }
+    shards[i] = lightest;
+    loads[lightest] += weights[i].micros;
+  }
+
+  size_t position = 0;
+  for (Test** p = root; *p != nullptr; position++) {
+    if (shards[position] == index) {
+      p = (*p)->getNext();
+    } else {
+      dropTest(p);
+    }
+  }
+}
+
+#endif
+
+}
+}
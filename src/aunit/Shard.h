@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_SHARD_H
+#define AUNIT_SHARD_H
+
+#include <stdint.h>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+class NamedValueFile;
+
+/**
+ * Keep only the tests of shard 'index' out of 'count' shards in the linked
+ * list at 'root', which must already be sorted. The tests are assigned round
+ * robin, so the k-th test goes to shard (k % count), and every process or
+ * device given the same binary and the same 'count' agrees on the
+ * partition. The other tests are marked as skipped and finished, so that the
+ * meta assertions which wait for them do not hang, and are removed from the
+ * list without being reported.
+ */
+void selectShard(Test** root, uint16_t index, uint16_t count);
+
+#if EPOXY_DUINO
+/**
+ * Same as selectShard(), but assign the tests to the shards by their
+ * recorded 'durations' in micros, the longest first, each to the shard with
+ * the least total duration so far, the lowest index on ties. Tests without a
+ * recorded duration weigh the mean of the known ones. Excluded tests weigh
+ * nothing. The assignment depends only on the list and the durations, so it
+ * is just as deterministic.
+ */
+void selectShard(Test** root, uint16_t index, uint16_t count,
+    const NamedValueFile& durations);
+#endif
+
+}
+}
+
+#endif
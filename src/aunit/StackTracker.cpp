@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "StackTracker.h"
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+#if defined(ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h> // pxTaskGetStackStart()
+#endif
+
+#if defined(ARDUINO_ARCH_AVR)
+// Defined by avr-libc. The heap grows up from __heap_start to __brkval.
+extern "C" {
+  extern char __heap_start;
+  extern char* __brkval;
+}
+#endif
+
+namespace aunit {
+namespace internal {
+
+AUNIT_THREAD_LOCAL StackTracker* StackTracker::sCurrent = nullptr;
+
+namespace {
+
+const uint8_t kPattern = 0xA5;
+
+// Number of bytes below the local variable of the constructor which are not
+// painted, because they hold the rest of its frame (and the 128-byte red zone
+// of the x86-64 ABI on EpoxyDuino).
+#if defined(EPOXY_DUINO)
+const uintptr_t kMargin = 512;
+#else
+const uintptr_t kMargin = 32;
+#endif
+
+// Return the lowest address of the stack which may be painted.
+uintptr_t stackLimit() {
+#if defined(ARDUINO_ARCH_AVR)
+  return reinterpret_cast<uintptr_t>(
+      __brkval ? __brkval : &__heap_start);
+#elif defined(ESP32)
+  // Stay clear of the watchpoint at the end of the stack of the task.
+  return reinterpret_cast<uintptr_t>(pxTaskGetStackStart(nullptr)) + 64;
+#else
+  return 0;
+#endif
+}
+
+}
+
+// Never inlined (e.g. by LTO), so that the frame of the caller stays above
+// the local variable which marks the top of the painted region.
+__attribute__((noinline))
+StackTracker::StackTracker(uint16_t& maxUsage):
+    mMaxUsage(maxUsage),
+    mPrevious(sCurrent) {
+  volatile uint8_t marker = 0;
+  mFrame = reinterpret_cast<uintptr_t>(&marker);
+  mTop = mFrame - kMargin;
+  mBottom = mTop - AUNIT_STACK_PAINT_SIZE;
+  uintptr_t limit = stackLimit();
+  if (mBottom < limit || mBottom > mTop) mBottom = limit;
+  if (mBottom > mTop) mBottom = mTop;
+
+  for (uintptr_t p = mBottom; p < mTop; p++) {
+    *reinterpret_cast<volatile uint8_t*>(p) = kPattern;
+  }
+  sCurrent = this;
+}
+
+StackTracker::~StackTracker() {
+  uint16_t used = measure();
+  if (used > mMaxUsage) mMaxUsage = used;
+  sCurrent = mPrevious;
+}
+
+uint16_t StackTracker::getUsage() const {
+  uint16_t used = measure();
+  return (used > mMaxUsage) ? used : mMaxUsage;
+}
+
+uint16_t StackTracker::measure() const {
+  uintptr_t p = mBottom;
+  while (p < mTop
+      && *reinterpret_cast<const volatile uint8_t*>(p) == kPattern) {
+    p++;
+  }
+  if (p == mTop) return 0;
+  uintptr_t used = mFrame - p;
+  return (used > 0xFFFF) ? 0xFFFF : used;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_STACK_TRACKER_H
+#define AUNIT_STACK_TRACKER_H
+
+#include <stdint.h>
+#include "Config.h"
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+#if !defined(EPOXY_DUINO) && !defined(ARDUINO_ARCH_AVR) && !defined(ESP32)
+  #error AUNIT_ENABLE_STACK_TRACKING requires AVR, ESP32 or EpoxyDuino
+#endif
+
+namespace aunit {
+namespace internal {
+
+/**
+ * Measures the stack used by one call to the setup(), loop() or teardown()
+ * method of a test. The constructor fills the free stack below its caller
+ * with a canary pattern, up to AUNIT_STACK_PAINT_SIZE bytes. The destructor
+ * scans the painted region from its lowest address for the first byte which
+ * was overwritten, and raises the stack usage of the test to the distance
+ * between that byte and the frame of the constructor.
+ *
+ * The stack is painted again before every call, because the stack unwinds
+ * between the calls to the loop() of a testing() test, and the other tests
+ * run in between. A byte which happens to be written with the value of the
+ * pattern is not seen, and the interrupts which occur during the call are
+ * counted as part of it. On AVR, a heap which grows into the painted region
+ * during the call is also counted as stack.
+ */
+class StackTracker {
+  public:
+    /** Paint the stack, and record the usage into 'maxUsage' when done. */
+    explicit StackTracker(uint16_t& maxUsage);
+
+    /** Raise 'maxUsage' to the stack used during the lifetime of this. */
+    ~StackTracker();
+
+    /** Return the tracker of the current thread, or nullptr if none. */
+    static const StackTracker* getCurrent() { return sCurrent; }
+
+    /**
+     * Return the highest stack usage of the test, including the current call
+     * so far. Called from within the test, the result includes the stack
+     * used by the caller itself.
+     */
+    uint16_t getUsage() const;
+
+  private:
+    // Disable copy-constructor and assignment operator
+    StackTracker(const StackTracker&) = delete;
+    StackTracker& operator=(const StackTracker&) = delete;
+
+    /** Return the stack used since the constructor, in bytes. */
+    uint16_t measure() const;
+
+    uint16_t& mMaxUsage;
+    uintptr_t mFrame; // address of a local variable of the constructor
+    uintptr_t mBottom; // lowest painted address
+    uintptr_t mTop; // one past the highest painted address
+    StackTracker* const mPrevious;
+
+    static AUNIT_THREAD_LOCAL StackTracker* sCurrent;
+};
+
+}
+}
+
+#endif
+
+#endif
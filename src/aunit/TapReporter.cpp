@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print, F()
+#include "Config.h"
+#include "Printer.h"
+#include "Test.h"
+#include "print_util.h"
+#include "TapReporter.h"
+
+namespace aunit {
+
+namespace {
+
+/**
+ * A Print which forwards to the Printer, inserting "# " at the start of each
+ * line, so that multi-line messages become TAP comments.
+ */
+class CommentPrint: public Print {
+  public:
+    void begin(Print* printer) {
+      mPrinter = printer;
+      mIsLineStart = true;
+    }
+
+    /** Terminate the last line if the message did not. */
+    void end() {
+      if (!mIsLineStart) mPrinter->println();
+    }
+
+    size_t write(uint8_t c) override {
+      if (mIsLineStart && c != '\n' && c != '\r') {
+        mPrinter->print(F("# "));
+      }
+      mIsLineStart = (c == '\n');
+      return mPrinter->write(c);
+    }
+
+  private:
+    Print* mPrinter = nullptr;
+    bool mIsLineStart = true;
+};
+
+AUNIT_THREAD_LOCAL CommentPrint commentPrint;
+
+}
+
+void TapReporter::beginRun(uint16_t numTests, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->println(F("TAP version 13"));
+  printer->print(F("1.."));
+  printer->println(numTests);
+}
+
+Print* TapReporter::beginMessage(const Test* /*test*/) {
+  commentPrint.begin(Printer::getBufferedPrinter());
+  return &commentPrint;
+}
+
+void TapReporter::endMessage() {
+  commentPrint.end();
+}
+
+void TapReporter::endTest(const Test& test, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  Test::Status status = test.getStatus();
+  bool ok = (status == Test::Status::Passed
+      || status == Test::Status::Skipped);
+  printer->print(ok ? F("ok - ") : F("not ok - "));
+  test.getName().print(printer);
+  if (status == Test::Status::Skipped) {
+    printer->print(F(" # SKIP"));
+  } else if (status == Test::Status::Expired) {
+    printer->print(F(" # timed out"));
+  }
+  printer->println();
+}
+
+void TapReporter::endRun(const RunSummary& summary, Verbosity /*verbosity*/) {
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("# "));
+  printer->print(summary.passedCount);
+  printer->print(F(" passed, "));
+  printer->print(summary.failedCount);
+  printer->print(F(" failed, "));
+  printer->print(summary.skippedCount);
+  printer->print(F(" skipped, "));
+  printer->print(summary.expiredCount);
+  printer->print(F(" timed out, in "));
+  internal::printSeconds(printer, summary.durationMillis);
+  printer->println(F(" seconds"));
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_TAP_REPORTER_H
+#define AUNIT_TAP_REPORTER_H
+
+#include "Reporter.h"
+
+namespace aunit {
+
+/**
+ * A Reporter which writes the Test Anything Protocol (TAP) version 13. Each
+ * test produces an "ok - name" or "not ok - name" line, with a "# SKIP"
+ * directive for skipped tests and a "# timed out" comment for expired tests.
+ * Messages are written as "# " comment lines. The test points are not
+ * numbered, so that the output remains valid when the tests run in parallel.
+ */
+class TapReporter: public Reporter {
+  public:
+    /** Constructor. */
+    TapReporter() {}
+
+    void beginRun(uint16_t numTests, Verbosity verbosity) override;
+
+    Print* beginMessage(const Test* test) override;
+
+    void endMessage() override;
+
+    void endTest(const Test& test, Verbosity verbosity) override;
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override;
+};
+
+}
+
+#endif
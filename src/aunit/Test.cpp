@@ -25,7 +25,7 @@ SOFTWARE.
 #include <Arduino.h>  // for declaration of 'Serial' on Teensy and others
 #include "Flash.h"
 #include "Verbosity.h"
-#include "Printer.h"
+#include "Reporter.h"
 #include "Compare.h"
 #include "Test.h"
 
@@ -33,6 +33,8 @@ namespace aunit {
 
 size_t Test::maxLength = 0;
 
+AUNIT_THREAD_LOCAL const Test* Test::sMessageOwner = nullptr;
+
 // Use a static variable inside a function to solve the static initialization
 // ordering problem.
 Test** Test::getRoot() {
@@ -41,10 +43,21 @@ Test** Test::getRoot() {
 }
 
 Test::Test():
-  mLifeCycle(LifeCycle::New),
-  mStatus(Status::Unknown),
   mVerbosity(Verbosity::kNone),
   mNext(nullptr) {
+  resetState();
+#if AUNIT_ENABLE_TIMING
+  mTiming = Timing();
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+  mHeapUsage = HeapUsage();
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+  mStackUsage = 0;
+#endif
+#if AUNIT_ENABLE_REPEAT_STATS
+  mRepeatStats = RepeatStats();
+#endif
 }
 
 // Resolve the status as Failed only if ok == false. Otherwise, keep the
@@ -55,61 +68,96 @@ void Test::setPassOrFail(bool ok) {
   }
 }
 
-// Insert the current test case into the singly linked list, sorted by
-// getName(). This is an O(N^2) algorithm, but should be good enough for
-// small N ~= 100. If N becomes bigger than that, it's probably better to insert
-// using an O(N) algorithm, then sort the elements later in TestRunner::run().
-// Also, we don't increment a static counter here, because that would introduce
-// another static initialization ordering problem.
+// Prepend the current test case to the singly linked list in O(1). Sorting the
+// list at this point would require an O(N^2) sorted insertion, which becomes
+// noticeable during static initialization for large N, especially on AVR where
+// every comparison reads the names from flash. Instead, the list is sorted once
+// with an O(N log N) merge sort in sortTests(), called from
+// TestRunner::setupRunner(). Also, we don't increment a static counter here,
+// because that would introduce another static initialization ordering problem.
 void Test::insert() {
-  // Find the element p whose p->next sorts after the current test
-  Test** p = getRoot();
-  while (*p != nullptr) {
-    if (getName().compareTo((*p)->getName()) < 0) break;
-    p = &(*p)->mNext;
-  }
-  mNext = *p;
-  *p = this;
+  Test** root = getRoot();
+  mNext = *root;
+  *root = this;
 }
 
-void Test::resolve() {
-  std::string result;
-
-  if (!isVerbosity(Verbosity::kTestAll)) return;
-
-  Print* printer = Printer::getPrinter();
-  switch (mStatus)
-  {
-    case Test::Status::Passed:
-      if (isVerbosity(Verbosity::kTestPassed)) result = "\033[32m passed\033[37m.";
-      break;
-    case Test::Status::Failed:
-      if (isVerbosity(Verbosity::kTestFailed)) result = "\033[31m failed\033[37m.";
-      break;
-    case Test::Status::Skipped:
-      if (isVerbosity(Verbosity::kTestSkipped)) result = " skipped.";
-      break;
-    case Test::Status::Expired:
-       if (isVerbosity(Verbosity::kTestExpired)) result = "\033[33m failed\033[37m.";
-       break;
-    case Test::Status::Unknown:
-       break;
+// Bottom-up merge sort of the singly linked list (see
+// https://www.chiark.greenend.org.uk/~sgtatham/algorithms/listsort.html). It
+// uses O(1) extra memory and no recursion, which keeps the stack usage small on
+// 8-bit processors. The list is reversed first to restore the registration
+// order, and the merge is stable, so tests with identical names are kept in
+// the same order as the previous sorted insertion algorithm.
+void Test::sortTests() {
+  Test** root = getRoot();
+
+  Test* reversed = nullptr;
+  for (Test* p = *root; p != nullptr; ) {
+    Test* next = p->mNext;
+    p->mNext = reversed;
+    reversed = p;
+    p = next;
   }
-
-  if (result.length())
-  {
-    // printer->print(F("Test"));
-    int spc = maxLength - mName.length() + 1;
-
-    while(spc > 0)
-    {
-      printer->print(' ');
-      spc--;
+  Test* list = reversed;
+
+  for (size_t width = 1; ; width *= 2) {
+    Test* p = list;
+    Test* tail = nullptr;
+    list = nullptr;
+    size_t merges = 0;
+
+    while (p != nullptr) {
+      merges++;
+
+      // Step 'width' places along from p to find the start of the right run.
+      Test* q = p;
+      size_t psize = 0;
+      while (psize < width && q != nullptr) {
+        psize++;
+        q = q->mNext;
+      }
+      size_t qsize = width;
+
+      // Merge the two runs, taking from the left run on ties for stability.
+      while (psize > 0 || (qsize > 0 && q != nullptr)) {
+        Test* e;
+        if (psize == 0) {
+          e = q; q = q->mNext; qsize--;
+        } else if (qsize == 0 || q == nullptr) {
+          e = p; p = p->mNext; psize--;
+        } else if (p->getName().compareTo(q->getName()) <= 0) {
+          e = p; p = p->mNext; psize--;
+        } else {
+          e = q; q = q->mNext; qsize--;
+        }
+
+        if (tail != nullptr) {
+          tail->mNext = e;
+        } else {
+          list = e;
+        }
+        tail = e;
+      }
+      p = q;
     }
+    if (tail != nullptr) tail->mNext = nullptr;
 
-    mName.print(printer);
-    printer->println(result.c_str());
+    if (merges <= 1) break;
   }
+
+  *root = list;
+}
+
+void Test::resolve() {
+  Reporter::getReporter()->endTest(*this, mVerbosity);
+}
+
+Print* Test::beginMessage() const {
+  return Reporter::getReporter()->beginMessage(
+      (sMessageOwner != nullptr) ? sMessageOwner : this);
+}
+
+void Test::endMessage() const {
+  Reporter::getReporter()->endMessage();
 }
 
 }
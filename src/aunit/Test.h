@@ -28,11 +28,15 @@ SOFTWARE.
 #ifndef AUNIT_TEST_H
 #define AUNIT_TEST_H
 
-#include <algorithm>
 #include <stdint.h>
+#include <string.h> // strlen()
+#include "Config.h"
 #include "FCString.h"
+#include "FixtureSuite.h"
 #include "Verbosity.h"
 
+class Print;
+
 namespace aunit {
 
 /**
@@ -123,6 +127,76 @@ class Test {
      */
     static Test** getRoot();
 
+    /**
+     * Sort the linked list of tests by getName(). Tests are prepended to the
+     * list in O(1) during static initialization, then sorted once by the
+     * TestRunner before the first test is run. Tests with identical names keep
+     * the order in which they were registered.
+     */
+    static void sortTests();
+
+  #if AUNIT_ENABLE_TIMING
+    /**
+     * Time spent in the various methods of the test, in microseconds, as
+     * measured by the TestRunner. Enabled by AUNIT_ENABLE_TIMING.
+     */
+    struct Timing {
+      /** Time spent in setup(). */
+      unsigned long setupMicros;
+
+      /** Total time spent in all calls to loop(). */
+      unsigned long loopMicros;
+
+      /** Time spent in teardown(). */
+      unsigned long teardownMicros;
+
+      /** Number of calls to loop(). */
+      unsigned long loopCount;
+
+      /** Total time spent in the test. */
+      unsigned long totalMicros() const {
+        return setupMicros + loopMicros + teardownMicros;
+      }
+    };
+  #endif
+
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    /**
+     * Heap memory allocated by the setup(), loop() and teardown() methods of
+     * the test, as recorded by internal::HeapTracker. Enabled by
+     * AUNIT_ENABLE_HEAP_TRACKING. The allocation counts are always 0 on the
+     * platforms which only sample the free heap.
+     */
+    struct HeapUsage {
+      /** Number of allocations. */
+      unsigned long allocCount;
+
+      /** Total number of bytes allocated. */
+      unsigned long allocBytes;
+
+      /** Highest number of bytes in use at the same time. */
+      unsigned long peakBytes;
+
+      /**
+       * Number of bytes still in use, i.e. allocated but not freed. Negative
+       * if the test freed memory allocated before it started.
+       */
+      long inUseBytes;
+    };
+  #endif
+
+  #if AUNIT_ENABLE_REPEAT_STATS
+    /**
+     * Number of iterations of TestRunner::setRepeat() in which the test
+     * passed or failed. An expired test counts as failed. The counts stop at
+     * 65535.
+     */
+    struct RepeatStats {
+      uint16_t passedCount;
+      uint16_t failedCount;
+    };
+  #endif
+
     /** Empty constructor. The name will be set later. */
     Test();
 
@@ -160,19 +234,36 @@ class Test {
      */
     virtual void loop() = 0;
 
-    /** Print out the summary of the current test. */
+    /** Report the result of the current test to the Reporter. */
     void resolve();
 
     /** Get the name of the test. */
     const internal::FCString& getName() const { return mName; }
 
     /** Get the life cycle state of the test. */
+  #if AUNIT_COMPACT_TEST
+    LifeCycle getLifeCycle() const {
+      return static_cast<LifeCycle>(mLifeCycle);
+    }
+
+    void setLifeCycle(LifeCycle state) {
+      mLifeCycle = static_cast<uint8_t>(state);
+    }
+
+    /** Get the status of the test. */
+    Status getStatus() const {
+      return (mStatus == kStatusTestTimeout)
+          ? Status::Expired
+          : static_cast<Status>(mStatus);
+    }
+  #else
     LifeCycle getLifeCycle() const { return mLifeCycle; }
 
     void setLifeCycle(LifeCycle state) { mLifeCycle = state; }
 
     /** Get the status of the test. */
     Status getStatus() const { return mStatus; }
+  #endif
 
     /**
      * Set the status of the test. All changes to getStatus() should happen
@@ -183,7 +274,11 @@ class Test {
       if (status != Status::Unknown) {
         setLifeCycle(LifeCycle::Asserted);
       }
+    #if AUNIT_COMPACT_TEST
+      mStatus = static_cast<uint8_t>(status);
+    #else
       mStatus = status;
+    #endif
     }
 
     /** Set the status to Passed or Failed depending on ok. */
@@ -202,31 +297,31 @@ class Test {
      * from ArduinoUnit and might have been named isAsserted() if this library
      * had been built from scratch.
      */
-    bool isDone() const { return mStatus != Status::Unknown; }
+    bool isDone() const { return getStatus() != Status::Unknown; }
 
     /** Return true if test is not has been asserted. */
     bool isNotDone() const { return !isDone(); }
 
     /** Return true if test is passed. */
-    bool isPassed() const { return mStatus == Status::Passed; }
+    bool isPassed() const { return getStatus() == Status::Passed; }
 
     /** Return true if test is not passed. */
     bool isNotPassed() const { return !isPassed(); }
 
     /** Return true if test is failed. */
-    bool isFailed() const { return mStatus == Status::Failed; }
+    bool isFailed() const { return getStatus() == Status::Failed; }
 
     /** Return true if test is not failed. */
     bool isNotFailed() const { return !isFailed(); }
 
     /** Return true if test is skipped. */
-    bool isSkipped() const { return mStatus == Status::Skipped; }
+    bool isSkipped() const { return getStatus() == Status::Skipped; }
 
     /** Return true if test is not skipped. */
     bool isNotSkipped() const { return !isSkipped(); }
 
     /** Return true if test is expired. */
-    bool isExpired() const { return mStatus == Status::Expired; }
+    bool isExpired() const { return getStatus() == Status::Expired; }
 
     /** Return true if test is not expired. */
     bool isNotExpired() const { return !isExpired(); }
@@ -243,6 +338,112 @@ class Test {
      */
     void expire() { setStatus(Status::Expired); }
 
+    /**
+     * Mark the test as expired because its own timeout elapsed (see
+     * TestAgain::setTimeout()), as opposed to the global timeout of the
+     * TestRunner. The TestRunner reports these tests separately.
+     */
+    void expireTestTimeout() {
+    #if AUNIT_COMPACT_TEST
+      expire();
+      mStatus = kStatusTestTimeout;
+    #else
+      mFlags |= kFlagTestTimeout;
+      expire();
+    #endif
+    }
+
+    /** Return true if the test was expired by its own timeout. */
+    bool isTestTimeout() const {
+    #if AUNIT_COMPACT_TEST
+      return mStatus == kStatusTestTimeout;
+    #else
+      return (mFlags & kFlagTestTimeout) != 0;
+    #endif
+    }
+
+    /**
+     * Return true if the TestRunner has called setup(), i.e. the test was not
+     * excluded.
+     */
+  #if AUNIT_COMPACT_TEST
+    bool isStarted() const { return mIsStarted; }
+  #else
+    bool isStarted() const { return (mFlags & kFlagStarted) != 0; }
+  #endif
+
+    /** Mark the test as started. Called by the TestRunner before setup(). */
+  #if AUNIT_COMPACT_TEST
+    void setStarted() { mIsStarted = 1; }
+  #else
+    void setStarted() { mFlags |= kFlagStarted; }
+  #endif
+
+    /**
+     * Restore the LifeCycle, the Status and the statistics of the test before
+     * it ran, so that the TestRunner can run it again. The name, the suite,
+     * the verbosity, the serial flag and the getRepeatStats() are kept. The
+     * state of the subclasses, such as TestAgain, is reset by their setup().
+     */
+    void reset() {
+    #if AUNIT_COMPACT_TEST
+      mLifeCycle = static_cast<uint8_t>(LifeCycle::New);
+      mStatus = static_cast<uint8_t>(Status::Unknown);
+      mIsStarted = 0;
+    #else
+      mLifeCycle = LifeCycle::New;
+      mStatus = Status::Unknown;
+      mFlags &= kFlagSerial;
+    #endif
+    #if AUNIT_ENABLE_TIMING
+      mTiming = Timing();
+    #endif
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      mHeapUsage = HeapUsage();
+    #endif
+    #if AUNIT_ENABLE_STACK_TRACKING
+      mStackUsage = 0;
+    #endif
+    }
+
+  #if AUNIT_ENABLE_TIMING
+    /** Return the timing statistics of the test. */
+    const Timing& getTiming() const { return mTiming; }
+
+    /** Return the mutable timing statistics, updated by the TestRunner. */
+    Timing& getTiming() { return mTiming; }
+  #endif
+
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    /** Return the heap usage of the test. */
+    const HeapUsage& getHeapUsage() const { return mHeapUsage; }
+
+    /** Return the mutable heap usage, updated by the TestRunner. */
+    HeapUsage& getHeapUsage() { return mHeapUsage; }
+  #endif
+
+  #if AUNIT_ENABLE_STACK_TRACKING
+    /**
+     * Return the highest number of bytes of stack used by a call to the
+     * setup(), loop() or teardown() method of the test.
+     */
+    uint16_t getStackUsage() const { return mStackUsage; }
+
+    /** Return the mutable stack usage, updated by the TestRunner. */
+    uint16_t& getStackUsage() { return mStackUsage; }
+  #endif
+
+  #if AUNIT_ENABLE_REPEAT_STATS
+    /**
+     * Return the results of the test over the iterations of the TestRunner.
+     * They are kept by reset().
+     */
+    const RepeatStats& getRepeatStats() const { return mRepeatStats; }
+
+    /** Return the mutable results, updated by the TestRunner. */
+    RepeatStats& getRepeatStats() { return mRepeatStats; }
+  #endif
+
     /** Enable the given verbosity of the current test. */
     void enableVerbosity(Verbosity verbosity) { mVerbosity |= verbosity; }
 
@@ -251,7 +452,87 @@ class Test {
 
     static void displayMinPosition(size_t pos) { maxLength = pos; }
 
+    /**
+     * Return the column used to right-align the names of the tests, which is
+     * the length of the longest test name unless set by displayMinPosition().
+     */
+    static size_t getDisplayMinPosition() { return maxLength; }
+
+    /**
+     * Return true if the test must run on the main thread, after all the
+     * tests that can run in parallel. See TestRunner::setParallelism().
+     */
+  #if AUNIT_COMPACT_TEST
+    bool isSerial() const { return mIsSerial; }
+  #else
+    bool isSerial() const { return (mFlags & kFlagSerial) != 0; }
+  #endif
+
+    /**
+     * Mark the test as one that cannot run concurrently with other tests,
+     * usually because it touches shared state. The serialTest() and
+     * serialTesting() macros call this automatically.
+     */
+  #if AUNIT_COMPACT_TEST
+    void setSerial() { mIsSerial = 1; }
+  #else
+    void setSerial() { mFlags |= kFlagSerial; }
+  #endif
+
+    /**
+     * Return the suite shared by the tests of the same fixture class, or
+     * nullptr if the fixture does not define setupSuite() or teardownSuite().
+     * Overridden only by the tests of the fixture macros (see findSuite()),
+     * so that the other tests do not pay for a pointer to a suite.
+     */
+    virtual internal::FixtureSuite* getSuite() const { return nullptr; }
+
   protected:
+    /**
+     * Optional static method of a fixture class, called once before the
+     * setup() of the first testF() or testingF() test of the fixture, and
+     * shared by all its tests. Define a static method with the same name in
+     * the fixture class to hide this one. Useful for state which is expensive
+     * to initialize, which must then be stored in static members.
+     */
+    static void setupSuite() {}
+
+    /**
+     * Optional static method of a fixture class, called once after the
+     * teardown() of the last test of the fixture. See setupSuite().
+     */
+    static void teardownSuite() {}
+
+    /**
+     * Return the suite of the fixture class T, shared by all its tests, with
+     * the setupSuite() and teardownSuite() methods visible from the test, which
+     * are passed in by the getSuite() of the fixture macros because they may
+     * be protected. Returns nullptr if the fixture defines neither method.
+     * The suite is created by the first call, from the thread of the
+     * TestRunner.
+     */
+    template <typename T>
+    static internal::FixtureSuite* findSuite(
+        internal::FixtureSuite::Hook setupHook,
+        internal::FixtureSuite::Hook teardownHook) {
+      if (setupHook == &Test::setupSuite
+          && teardownHook == &Test::teardownSuite) {
+        return nullptr;
+      }
+      static internal::FixtureSuite suite(setupHook, teardownHook);
+      return &suite;
+    }
+
+    /**
+     * Start a message of this test, such as the message of an assertion, and
+     * return the Print where it should be written. Must be followed by
+     * endMessage(). See Reporter::beginMessage().
+     */
+    Print* beginMessage() const;
+
+    /** Terminate the message started by beginMessage(). */
+    void endMessage() const;
+
     /**
      * Mark the test as failed. Use the failTestNow() macro in a unit test to
      * print a diagnostic message and exit immediately.
@@ -266,18 +547,10 @@ class Test {
      */
     void pass() { setStatus(Status::Passed); }
 
-    void init(const char* name) {
-      maxLength = std::max(maxLength, strlen(name));
-      mName = internal::FCString(name);
-      mLifeCycle = LifeCycle::New;
-      mStatus = Status::Unknown;
-      mVerbosity = Verbosity::kNone;
-      insert();
-    }
+    void init(const char* name) { init(internal::FCString(name)); }
 
     void init(const __FlashStringHelper* name) {
-      mName = internal::FCString(name);
-      init(mName.getCString());
+      init(internal::FCString(name));
     }
 
     /** Determine if any of the given verbosity is enabled. */
@@ -286,19 +559,103 @@ class Test {
     /** Get the verbosity. */
     Verbosity  getVerbosity() const { return mVerbosity; }
 
+    /**
+     * If not nullptr, the test under whose name the messages of the test
+     * being run are reported, instead of the test itself. Set by LazyTest
+     * while its fixture object is running.
+     */
+    static AUNIT_THREAD_LOCAL const Test* sMessageOwner;
+
   private:
+  #if AUNIT_COMPACT_TEST
+    /**
+     * Value of mStatus for a test expired by its own timeout, reported as
+     * Status::Expired by getStatus(). Replaces the kFlagTestTimeout flag.
+     */
+    static const uint8_t kStatusTestTimeout = 7;
+  #else
+    /** Bit flag in mFlags, set if the test must not run in parallel. */
+    static const uint8_t kFlagSerial = 0x01;
+
+    /** Bit flag in mFlags, set if the test has exceeded its own timeout. */
+    static const uint8_t kFlagTestTimeout = 0x02;
+
+    /** Bit flag in mFlags, set when the TestRunner has started the test. */
+    static const uint8_t kFlagStarted = 0x04;
+  #endif
+
     // Disable copy-constructor and assignment operator
     Test(const Test&) = delete;
     Test& operator=(const Test&) = delete;
 
-    /** Insert into the linked list. */
+    /**
+     * Common part of the init() methods. The length of the name is computed
+     * once, for both c-strings and flash strings.
+     */
+    void init(const internal::FCString& name) {
+      mName = name;
+      size_t length = mName.length();
+      if (length > maxLength) maxLength = length;
+      resetState();
+      mVerbosity = Verbosity::kNone;
+    #if AUNIT_ENABLE_TIMING
+      mTiming = Timing();
+    #endif
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      mHeapUsage = HeapUsage();
+    #endif
+    #if AUNIT_ENABLE_STACK_TRACKING
+      mStackUsage = 0;
+    #endif
+    #if AUNIT_ENABLE_REPEAT_STATS
+      mRepeatStats = RepeatStats();
+    #endif
+      insert();
+    }
+
+    /** Reset the LifeCycle, the Status and the flags of a new test. */
+    void resetState() {
+    #if AUNIT_COMPACT_TEST
+      mLifeCycle = static_cast<uint8_t>(LifeCycle::New);
+      mStatus = static_cast<uint8_t>(Status::Unknown);
+      mIsSerial = 0;
+      mIsStarted = 0;
+    #else
+      mLifeCycle = LifeCycle::New;
+      mStatus = Status::Unknown;
+      mFlags = 0;
+    #endif
+    }
+
+    /** Insert into the linked list. The list is sorted later by sortTests(). */
     void insert();
 
     internal::FCString mName;
+  #if AUNIT_COMPACT_TEST
+    // The LifeCycle, the Status and the flags share a single byte.
+    uint8_t mLifeCycle : 3;
+    uint8_t mStatus : 3;
+    uint8_t mIsSerial : 1;
+    uint8_t mIsStarted : 1;
+  #else
     LifeCycle mLifeCycle;
     Status mStatus;
+    uint8_t mFlags;
+  #endif
     Verbosity mVerbosity;
     Test* mNext;
+  #if AUNIT_ENABLE_TIMING
+    Timing mTiming;
+  #endif
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    HeapUsage mHeapUsage;
+  #endif
+  #if AUNIT_ENABLE_STACK_TRACKING
+    uint16_t mStackUsage;
+  #endif
+  #if AUNIT_ENABLE_REPEAT_STATS
+    RepeatStats mRepeatStats;
+  #endif
     static size_t maxLength;
 };
 
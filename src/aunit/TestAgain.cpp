@@ -22,11 +22,52 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <Arduino.h> // millis()
 #include "TestAgain.h"
 
 namespace aunit {
 
+#if AUNIT_ENABLE_TEST_TIMERS
+
+AUNIT_THREAD_LOCAL bool TestAgain::sIsSleeping = false;
+AUNIT_THREAD_LOCAL unsigned long TestAgain::sWakeMillis = 0;
+
+void TestAgain::setup() {
+  MetaAssertion::setup();
+  mIsTimerStarted = false;
+  mIsAsleep = false;
+}
+
+#endif
+
 void TestAgain::loop() {
+#if AUNIT_ENABLE_TEST_TIMERS
+  if (mTimeoutMillis > 0) {
+    unsigned long now = millis();
+    if (!mIsTimerStarted) {
+      mDeadline = now + mTimeoutMillis;
+      mIsTimerStarted = true;
+    } else if ((long) (now - mDeadline) >= 0) {
+      // Signed difference so that the deadline survives the rollover of
+      // millis() every 49.7 days.
+      expireTestTimeout();
+      return;
+    }
+  }
+
+  if (mIsAsleep) {
+    if ((long) (millis() - mWakeMillis) < 0) {
+      // Report the deadline instead if it comes first, so that the TestRunner
+      // does not idle past it.
+      sIsSleeping = true;
+      sWakeMillis = (mIsTimerStarted && (long) (mDeadline - mWakeMillis) < 0)
+          ? mDeadline : mWakeMillis;
+      return;
+    }
+    mIsAsleep = false;
+  }
+#endif
+
   again();
 }
 
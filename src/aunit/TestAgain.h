@@ -26,6 +26,7 @@ SOFTWARE.
 #define AUNIT_TEST_AGAIN_H
 
 #include <stdint.h>
+#include "Config.h"
 #include "FCString.h"
 #include "MetaAssertion.h"
 
@@ -39,6 +40,14 @@ class TestAgain: public MetaAssertion {
     /** Constructor. */
     TestAgain() {}
 
+  #if AUNIT_ENABLE_TEST_TIMERS
+    /**
+     * Restart the timer of setTimeout() and clear sleepUntil(), for a test
+     * which is run again by the TestRunner (e.g. '--serve').
+     */
+    void setup() override;
+  #endif
+
     /**
      * Calls the user-provided again() method multiple times until the user
      * code explicitly resolves the test using pass(), fail(), skip() or
@@ -49,10 +58,63 @@ class TestAgain: public MetaAssertion {
     /** User-provided test case. */
     virtual void again() = 0;
 
+  #if AUNIT_ENABLE_TEST_TIMERS
+    /**
+     * Set the timeout of this test, in milliseconds, measured from the first
+     * call to loop(). The test is expired if it is not resolved within that
+     * time, independently of TestRunner::setTimeout(). The default of 0 means
+     * that only the TestRunner timeout applies. Normally set through the
+     * testingWithTimeout() macro, or in the setup() of a testingF() fixture.
+     */
+    void setTimeout(unsigned long timeoutMillis) {
+      mTimeoutMillis = timeoutMillis;
+    }
+
+    /**
+     * Do not call again() until millis() reaches 'wakeMillis', for a test
+     * which is only waiting for a timer. When all the active tests are
+     * asleep, the TestRunner idles until the earliest wake time instead of
+     * spinning (see TestRunner::setIdleSleep()). The timeout of the test
+     * still applies while it is asleep, and the TestRunner does not idle past
+     * it.
+     */
+    void sleepUntil(unsigned long wakeMillis) {
+      mWakeMillis = wakeMillis;
+      mIsAsleep = true;
+    }
+
+    /**
+     * Return true if the last loop() on this thread did not call again()
+     * because the test was asleep, and set 'wakeMillis' to its wake time, or
+     * to the deadline of its setTimeout() if that comes first. Clears the
+     * flag. Used by the TestRunner.
+     */
+    static bool consumeSleep(unsigned long& wakeMillis) {
+      if (!sIsSleeping) return false;
+      sIsSleeping = false;
+      wakeMillis = sWakeMillis;
+      return true;
+    }
+  #else
+    /** Always false, since a test cannot sleep without the timers. */
+    static bool consumeSleep(unsigned long& /*wakeMillis*/) { return false; }
+  #endif
+
   private:
     // Disable copy-constructor and assignment operator
     TestAgain(const TestAgain&) = delete;
     TestAgain& operator=(const TestAgain&) = delete;
+
+  #if AUNIT_ENABLE_TEST_TIMERS
+    unsigned long mTimeoutMillis = 0;
+    unsigned long mDeadline = 0;
+    unsigned long mWakeMillis = 0;
+    bool mIsTimerStarted = false;
+    bool mIsAsleep = false;
+
+    static AUNIT_THREAD_LOCAL bool sIsSleeping;
+    static AUNIT_THREAD_LOCAL unsigned long sWakeMillis;
+  #endif
 };
 
 }
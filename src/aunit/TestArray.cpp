@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "FCString.h"
+#include "Test.h"
+#include "TestArray.h"
+
+namespace aunit {
+namespace internal {
+
+void TestArray::build(Test** root) {
+  uint16_t count = 0;
+  for (Test* test = *root; test != nullptr; test = *test->getNext()) {
+    count++;
+  }
+
+  delete[] mTests;
+  mTests = new Test*[count > 0 ? count : 1];
+  mSize = count;
+  for (Test* test = *root; test != nullptr; test = *test->getNext()) {
+    mTests[--count] = test;
+  }
+}
+
+// Bottom-up merge sort, alternating between the array and a temporary buffer
+// of the same size, which is released at the end. Taking from the left run on
+// ties keeps the sort stable.
+void TestArray::sort() {
+  if (mSize < 2) return;
+
+  Test** buffer = new Test*[mSize];
+  Test** src = mTests;
+  Test** dst = buffer;
+  for (uint32_t width = 1; width < mSize; width *= 2) {
+    for (uint32_t left = 0; left < mSize; left += 2 * width) {
+      uint32_t mid = left + width;
+      if (mid > mSize) mid = mSize;
+      uint32_t right = mid + width;
+      if (right > mSize) right = mSize;
+
+      uint32_t i = left;
+      uint32_t j = mid;
+      uint32_t k = left;
+      while (i < mid && j < right) {
+        if (src[j]->getName().compareTo(src[i]->getName()) < 0) {
+          dst[k++] = src[j++];
+        } else {
+          dst[k++] = src[i++];
+        }
+      }
+      while (i < mid) dst[k++] = src[i++];
+      while (j < right) dst[k++] = src[j++];
+    }
+    Test** swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != mTests) {
+    for (uint16_t i = 0; i < mSize; i++) mTests[i] = src[i];
+  }
+  delete[] buffer;
+}
+
+uint16_t TestArray::relink(Test** root) const {
+  uint16_t count = 0;
+  Test** tail = root;
+  for (Test* test : *this) {
+    if (test->getLifeCycle() == Test::LifeCycle::Finished) continue;
+    *tail = test;
+    tail = test->getNext();
+    count++;
+  }
+  *tail = nullptr;
+  return count;
+}
+
+}
+}
@@ -0,0 +1,98 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef AUNIT_TEST_ARRAY_H
+#define AUNIT_TEST_ARRAY_H
+
+#include <stdint.h>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+/**
+ * A contiguous array of pointers to all the registered tests, built once from
+ * the linked list when the TestRunner starts, and used instead of the list by
+ * the passes which visit every test (sorting, filtering, counting and
+ * indexing). Walking the list needs a dependent load of the mNext pointer of
+ * each test, scattered across the static memory, before the next test can be
+ * reached. The array exposes all the pointers up front, so the processor can
+ * fetch several tests at once. The linked list is still the list of active
+ * tests used by the TestRunner, which is relinked in the order of the array
+ * after sort(). The array costs one pointer per test on the heap.
+ */
+class TestArray {
+  public:
+    TestArray() = default;
+
+    ~TestArray() { delete[] mTests; }
+
+    /** Return true if build() has been called. */
+    bool isBuilt() const { return mTests != nullptr; }
+
+    /**
+     * Collect the tests of the linked list at 'root' in the order of their
+     * registration, i.e. the reverse of the list, which is built by
+     * prepending.
+     */
+    void build(Test** root);
+
+    /**
+     * Sort the tests by name with a stable merge sort, so that tests with
+     * identical names keep their order of registration, the same order as
+     * Test::sortTests().
+     */
+    void sort();
+
+    /**
+     * Rebuild the linked list at 'root' with the tests which are not Finished,
+     * in the order of the array. Return the number of tests in the list.
+     */
+    uint16_t relink(Test** root) const;
+
+    /** Return the number of tests. */
+    uint16_t size() const { return mSize; }
+
+    /** Return the first test pointer, for range-based for loops. */
+    Test* const* begin() const { return mTests; }
+
+    /** Return one past the last test pointer. */
+    Test* const* end() const { return mTests + mSize; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    TestArray(const TestArray&) = delete;
+    TestArray& operator=(const TestArray&) = delete;
+
+    Test** mTests = nullptr;
+    uint16_t mSize = 0;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "FCString.h"
+#include "Test.h"
+#include "TestIndex.h"
+
+namespace aunit {
+namespace internal {
+
+void TestIndex::build(Test* root) {
+  uint16_t count = 0;
+  for (Test* test = root; test != nullptr; test = *test->getNext()) {
+    count++;
+  }
+  allocate(count);
+  for (Test* test = root; test != nullptr; test = *test->getNext()) {
+    insert(test);
+  }
+}
+
+void TestIndex::build(Test* const* begin, Test* const* end) {
+  allocate(end - begin);
+  for (Test* const* p = begin; p != end; p++) {
+    insert(*p);
+  }
+}
+
+void TestIndex::allocate(uint16_t count) {
+  // At least twice as many slots as tests, so that the probe sequences stay
+  // short, and always at least one empty slot to terminate them.
+  uint32_t size = 2;
+  while (size < 2UL * count && size < 0x10000UL) size *= 2;
+  delete[] mSlots;
+  mSlots = new Test*[size]();
+  mMask = size - 1;
+}
+
+void TestIndex::insert(Test* test) {
+  uint16_t i = test->getName().getHash() & mMask;
+  while (mSlots[i] != nullptr) i = (i + 1) & mMask;
+  mSlots[i] = test;
+}
+
+Test* TestIndex::find(const FCString& name) const {
+  if (mSlots == nullptr) return nullptr;
+  for (uint16_t i = name.getHash() & mMask; mSlots[i] != nullptr;
+      i = (i + 1) & mMask) {
+    if (mSlots[i]->getName().equals(name)) return mSlots[i];
+  }
+  return nullptr;
+}
+
+}
+}
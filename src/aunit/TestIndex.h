@@ -0,0 +1,82 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_TEST_INDEX_H
+#define AUNIT_TEST_INDEX_H
+
+#include <stdint.h>
+
+namespace aunit {
+
+class Test;
+
+namespace internal {
+
+class FCString;
+
+/**
+ * A hash table of the tests by name, built once from the linked list of all
+ * registered tests, used by TestRunner::find(). The table uses open
+ * addressing with linear probing on the hash cached in the name of each test
+ * (FCString::getHash()), and is at most half full, so that a lookup usually
+ * compares the characters of a single name. The table costs 2 pointers per
+ * test, and is allocated only if find() is used.
+ */
+class TestIndex {
+  public:
+    TestIndex() = default;
+
+    ~TestIndex() { delete[] mSlots; }
+
+    /** Return true if build() has been called. */
+    bool isBuilt() const { return mSlots != nullptr; }
+
+    /** Index all the tests of the linked list starting at 'root'. */
+    void build(Test* root);
+
+    /** Index all the tests of the array [begin, end). */
+    void build(Test* const* begin, Test* const* end);
+
+    /** Return the test with the given name, or nullptr if not found. */
+    Test* find(const FCString& name) const;
+
+  private:
+    // Disable copy-constructor and assignment operator
+    TestIndex(const TestIndex&) = delete;
+    TestIndex& operator=(const TestIndex&) = delete;
+
+    /** Allocate the empty slots for 'count' tests. */
+    void allocate(uint16_t count);
+
+    /** Insert the test into its slot. */
+    void insert(Test* test);
+
+    Test** mSlots = nullptr;
+    uint16_t mMask = 0; // number of slots - 1, a power of 2 minus 1
+};
+
+}
+}
+
+#endif
@@ -29,8 +29,10 @@ SOFTWARE.
  * @file TestMacros.h
  *
  * Various macros (test(), testF(), testing(), testingF(), externTest(),
- * externTestF(), externTesting(), externTestingF()) are defined in this
- * header.
+ * externTestF(), externTesting(), externTestingF(), testingWithTimeout(),
+ * asyncTest(), asyncTestF(), benchmark(), benchmarkF(), serialTest(),
+ * serialTestF(), serialTesting(), serialTestingF(), lazyTestF(),
+ * lazyTestingF(), testTable()) are defined in this header.
  */
 
 #ifndef AUNIT_TEST_MACROS_H
@@ -42,6 +44,22 @@ SOFTWARE.
 #include "FCString.h"
 #include "TestOnce.h"
 #include "TestAgain.h"
+#include "TestTable.h"
+#include "LazyTest.h"
+#include "AsyncTest.h"
+#include "CompileFilter.h"
+
+/**
+ * Override Test::getSuite() in the class generated by a fixture macro, to
+ * return the suite of the setupSuite() and teardownSuite() methods of
+ * 'testClass'. The plain test() and testing() tests keep the default, so they
+ * do not store a pointer to a suite.
+ */
+#define AUNIT_FIXTURE_SUITE(testClass) \
+  aunit::internal::FixtureSuite* getSuite() const override {\
+    return findSuite<testClass>(\
+        &testClass::setupSuite, &testClass::teardownSuite);\
+  }
 
 /**
  * Macro to define a test that will be run only once.
@@ -60,7 +78,8 @@ class test_##name : public aunit::TestOnce {\
 public:\
   test_##name();\
   void once() override;\
-} test_##name##_instance;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
 test_##name :: test_##name() {\
   init(AUNIT_F(#name)); \
 }\
@@ -71,7 +90,9 @@ class suiteName##_##name : public aunit::TestOnce {\
 public:\
   suiteName##_##name();\
   void once() override;\
-} suiteName##_##name##_instance;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
 suiteName##_##name :: suiteName##_##name() {\
   init(AUNIT_F(#suiteName "_" #name)); \
 }\
@@ -96,7 +117,8 @@ class test_##name : public aunit::TestAgain {\
 public:\
   test_##name();\
   void again() override;\
-} test_##name##_instance;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
 test_##name :: test_##name() {\
   init(AUNIT_F(#name));\
 }\
@@ -107,7 +129,9 @@ class suiteName##_##name : public aunit::TestAgain {\
 public:\
   suiteName##_##name();\
   void again() override;\
-} suiteName##_##name##_instance;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
 suiteName##_##name :: suiteName##_##name() {\
   init(AUNIT_F(#suiteName "_" #name));\
 }\
@@ -133,7 +157,7 @@ public:\
   test_##name();\
   void once();\
 };\
-extern test_##name test_##name##_instance
+extern AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance
 
 #define EXTERN_TEST2(suiteName, name) \
 class suiteName##_##name : public aunit::TestOnce {\
@@ -141,7 +165,8 @@ public:\
   suiteName##_##name();\
   void once();\
 };\
-extern suiteName##_##name suiteName##_##name##_instance
+extern AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance
 
 /**
  * Create an extern reference to a testing() test case object defined
@@ -163,7 +188,7 @@ public:\
   test_ ## name();\
   void again();\
 };\
-extern test_##name test_##name##_instance
+extern AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance
 
 #define EXTERN_TESTING2(suiteName, name) \
 class suiteName##_ ## name : public aunit::TestAgain {\
@@ -171,7 +196,8 @@ public:\
   suiteName##_ ## name();\
   void again();\
 };\
-extern suiteName##_##name suiteName##_##name##_instance
+extern AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance
 
 /**
  * Create a test that is derived from a custom TestOnce class.
@@ -183,7 +209,10 @@ class testClass ## _ ## name : public testClass {\
 public:\
   testClass ## _ ## name();\
   void once() override;\
-} testClass ## _ ## name ## _instance;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
 testClass ## _ ## name :: testClass ## _ ## name() {\
   init(AUNIT_F(#testClass "_" #name));\
 }\
@@ -202,12 +231,390 @@ class testClass ## _ ## name : public testClass {\
 public:\
   testClass ## _ ## name();\
   void again() override;\
-} testClass ## _ ## name ## _instance;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
 testClass ## _ ## name :: testClass ## _ ## name() {\
   init(AUNIT_F(#testClass "_" #name));\
 }\
 void testClass ## _ ## name :: again()
 
+#if AUNIT_ENABLE_TEST_TIMERS
+
+/**
+ * Same as testing(), but the test is expired if it is not resolved within
+ * 'timeoutMillis' milliseconds, independently of TestRunner::setTimeout().
+ * Requires AUNIT_ENABLE_TEST_TIMERS.
+ *
+ * Two versions are supported: testingWithTimeout(name, timeoutMillis) and
+ * testingWithTimeout(suiteName, name, timeoutMillis), with the same naming
+ * rules as testing().
+ */
+#define testingWithTimeout(...) \
+    GET_TESTING_WITH_TIMEOUT(__VA_ARGS__, TESTING_WITH_TIMEOUT3,\
+        TESTING_WITH_TIMEOUT2)(__VA_ARGS__)
+
+#define GET_TESTING_WITH_TIMEOUT(_1, _2, _3, NAME, ...) NAME
+
+#define TESTING_WITH_TIMEOUT2(name, timeoutMillis) \
+class test_##name : public aunit::TestAgain {\
+public:\
+  test_##name();\
+  void again() override;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() {\
+  init(AUNIT_F(#name));\
+  setTimeout(timeoutMillis);\
+}\
+void test_##name :: again()
+
+#define TESTING_WITH_TIMEOUT3(suiteName, name, timeoutMillis) \
+class suiteName##_##name : public aunit::TestAgain {\
+public:\
+  suiteName##_##name();\
+  void again() override;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() {\
+  init(AUNIT_F(#suiteName "_" #name));\
+  setTimeout(timeoutMillis);\
+}\
+void suiteName##_##name :: again()
+
+#endif
+
+/**
+ * Macro to define a test whose body is a stackless coroutine, which can wait
+ * for a condition with AUNIT_AWAIT() or for some time with AUNIT_SLEEP()
+ * without blocking the other tests. The body must start with
+ * AUNIT_ASYNC_BEGIN() and end with AUNIT_ASYNC_END(). See AsyncTest.
+ *
+ * Two versions are supported: asyncTest(name) and asyncTest(suiteName, name),
+ * with the same naming rules as testing().
+ */
+#define asyncTest(...) \
+    GET_ASYNC_TEST(__VA_ARGS__, ASYNC_TEST2, ASYNC_TEST1)(__VA_ARGS__)
+
+#define GET_ASYNC_TEST(_1, _2, NAME, ...) NAME
+
+#define ASYNC_TEST1(name) \
+class test_##name : public aunit::AsyncTest {\
+public:\
+  test_##name();\
+  void run() override;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() {\
+  init(AUNIT_F(#name));\
+}\
+void test_##name :: run()
+
+#define ASYNC_TEST2(suiteName, name) \
+class suiteName##_##name : public aunit::AsyncTest {\
+public:\
+  suiteName##_##name();\
+  void run() override;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() {\
+  init(AUNIT_F(#suiteName "_" #name));\
+}\
+void suiteName##_##name :: run()
+
+/**
+ * Create an asyncTest() that is derived from a custom AsyncTest class, with
+ * the same naming rules as testingF().
+ */
+#define asyncTestF(testClass, name) \
+class testClass ## _ ## name : public testClass {\
+public:\
+  testClass ## _ ## name();\
+  void run() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
+testClass ## _ ## name :: testClass ## _ ## name() {\
+  init(AUNIT_F(#testClass "_" #name));\
+}\
+void testClass ## _ ## name :: run()
+
+/**
+ * Create a benchmark which measures the time taken by the code in the '{}'
+ * block that follows the macro. The code is executed many times, and the min,
+ * median and p99 times per iteration are printed. See aunit::Benchmark.
+ * Benchmarks are filtered by TestRunner::include() and exclude() like tests.
+ *
+ * Two versions are supported: benchmark(name) and benchmark(suiteName,
+ * name), with the same naming rules as test(), so that the meta assertions
+ * (e.g. assertTestDone()) also work on benchmarks.
+ */
+#define benchmark(...) \
+    GET_BENCHMARK(__VA_ARGS__, BENCHMARK2, BENCHMARK1)(__VA_ARGS__)
+
+#define GET_BENCHMARK(_1, _2, NAME, ...) NAME
+
+#define BENCHMARK1(name) \
+class test_##name : public aunit::Benchmark {\
+public:\
+  test_##name();\
+  void iterate() override;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() {\
+  init(AUNIT_F(#name));\
+}\
+void test_##name :: iterate()
+
+#define BENCHMARK2(suiteName, name) \
+class suiteName##_##name : public aunit::Benchmark {\
+public:\
+  suiteName##_##name();\
+  void iterate() override;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() {\
+  init(AUNIT_F(#suiteName "_" #name));\
+}\
+void suiteName##_##name :: iterate()
+
+/**
+ * Create a benchmark that is derived from a custom Benchmark class. The
+ * setup() and teardown() of the fixture are called once, around the entire
+ * benchmark, not around each iteration.
+ */
+#define benchmarkF(testClass, name) \
+class testClass ## _ ## name : public testClass {\
+public:\
+  testClass ## _ ## name();\
+  void iterate() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
+testClass ## _ ## name :: testClass ## _ ## name() {\
+  init(AUNIT_F(#testClass "_" #name));\
+}\
+void testClass ## _ ## name :: iterate()
+
+/**
+ * Same as test(), but the test is never run concurrently with other tests when
+ * TestRunner::setParallelism() is active. Use this for tests which touch
+ * shared state, such as global variables, hardware, or other tests through the
+ * assertTestXxx() and checkTestXxx() meta assertions.
+ *
+ * Two versions are supported: serialTest(name) and serialTest(suiteName,
+ * name), with the same naming rules as test().
+ */
+#define serialTest(...) \
+    GET_SERIAL_TEST(__VA_ARGS__, SERIAL_TEST2, SERIAL_TEST1)(__VA_ARGS__)
+
+#define GET_SERIAL_TEST(_1, _2, NAME, ...) NAME
+
+#define SERIAL_TEST1(name) \
+class test_##name : public aunit::TestOnce {\
+public:\
+  test_##name();\
+  void once() override;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() {\
+  init(AUNIT_F(#name)); \
+  setSerial();\
+}\
+void test_##name :: once()
+
+#define SERIAL_TEST2(suiteName, name) \
+class suiteName##_##name : public aunit::TestOnce {\
+public:\
+  suiteName##_##name();\
+  void once() override;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() {\
+  init(AUNIT_F(#suiteName "_" #name)); \
+  setSerial();\
+}\
+void suiteName##_##name :: once()
+
+/**
+ * Same as testing(), but the test is never run concurrently with other tests
+ * when TestRunner::setParallelism() is active. See serialTest().
+ */
+#define serialTesting(...) \
+    GET_SERIAL_TESTING(__VA_ARGS__, SERIAL_TESTING2, SERIAL_TESTING1)\
+        (__VA_ARGS__)
+
+#define GET_SERIAL_TESTING(_1, _2, NAME, ...) NAME
+
+#define SERIAL_TESTING1(name) \
+class test_##name : public aunit::TestAgain {\
+public:\
+  test_##name();\
+  void again() override;\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() {\
+  init(AUNIT_F(#name));\
+  setSerial();\
+}\
+void test_##name :: again()
+
+#define SERIAL_TESTING2(suiteName, name) \
+class suiteName##_##name : public aunit::TestAgain {\
+public:\
+  suiteName##_##name();\
+  void again() override;\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() {\
+  init(AUNIT_F(#suiteName "_" #name));\
+  setSerial();\
+}\
+void suiteName##_##name :: again()
+
+/**
+ * Same as testF(), but the test is never run concurrently with other tests
+ * when TestRunner::setParallelism() is active. See serialTest().
+ */
+#define serialTestF(testClass, name) \
+class testClass ## _ ## name : public testClass {\
+public:\
+  testClass ## _ ## name();\
+  void once() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
+testClass ## _ ## name :: testClass ## _ ## name() {\
+  init(AUNIT_F(#testClass "_" #name));\
+  setSerial();\
+}\
+void testClass ## _ ## name :: once()
+
+/**
+ * Same as testingF(), but the test is never run concurrently with other tests
+ * when TestRunner::setParallelism() is active. See serialTest().
+ */
+#define serialTestingF(testClass, name) \
+class testClass ## _ ## name : public testClass {\
+public:\
+  testClass ## _ ## name();\
+  void again() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
+};\
+AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance;\
+testClass ## _ ## name :: testClass ## _ ## name() {\
+  init(AUNIT_F(#testClass "_" #name));\
+  setSerial();\
+}\
+void testClass ## _ ## name :: again()
+
+/**
+ * Same as testF(), but the fixture object is constructed on the heap only
+ * when the test is run, and destroyed after its teardown(). Only a LazyTest
+ * descriptor, named '{testClass}_{name}_instance' like the object of testF(),
+ * is created during static initialization. See LazyTest.
+ */
+#define lazyTestF(testClass, name) \
+class testClass ## _ ## name final : public testClass {\
+public:\
+  void once() override;\
+  static aunit::Test* create() { return new testClass ## _ ## name(); }\
+  static void destroy(aunit::Test* test) {\
+    delete static_cast<testClass ## _ ## name*>(test);\
+  }\
+};\
+static const char testClass ## _ ## name ## _name[] PROGMEM =\
+    #testClass "_" #name;\
+AUNIT_TEST_TYPE(aunit::LazyTest, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance(\
+    AUNIT_FPSTR(testClass ## _ ## name ## _name),\
+    &testClass ## _ ## name::create, &testClass ## _ ## name::destroy);\
+void testClass ## _ ## name :: once()
+
+/**
+ * Same as testingF(), but the fixture object is constructed on the heap only
+ * when the test is run. See lazyTestF().
+ */
+#define lazyTestingF(testClass, name) \
+class testClass ## _ ## name final : public testClass {\
+public:\
+  void again() override;\
+  static aunit::Test* create() { return new testClass ## _ ## name(); }\
+  static void destroy(aunit::Test* test) {\
+    delete static_cast<testClass ## _ ## name*>(test);\
+  }\
+};\
+static const char testClass ## _ ## name ## _name[] PROGMEM =\
+    #testClass "_" #name;\
+AUNIT_TEST_TYPE(aunit::LazyTest, #testClass "_" #name)\
+    testClass ## _ ## name ## _instance(\
+    AUNIT_FPSTR(testClass ## _ ## name ## _name),\
+    &testClass ## _ ## name::create, &testClass ## _ ## name::destroy);\
+void testClass ## _ ## name :: again()
+
+/**
+ * Macro to define a table-driven test, which runs the following body once for
+ * each element of the 'rows' array of type 'Row', stored in flash memory with
+ * PROGMEM. Each row is copied into a local variable named 'row' before the
+ * body is called, so 'Row' must be a trivially copyable struct. All rows share
+ * a single TestTable instance. See TestTable for how the rows are reported.
+ *
+ * Two versions are supported: testTable(name, Row, rows) and
+ * testTable(suiteName, name, Row, rows). The 4-argument version is identical
+ * to testTable(suiteName_name, Row, rows).
+ */
+#define testTable(...) \
+    GET_TEST_TABLE(__VA_ARGS__, TEST_TABLE4, TEST_TABLE3)(__VA_ARGS__)
+
+#define GET_TEST_TABLE(_1, _2, _3, _4, NAME, ...) NAME
+
+#define TEST_TABLE3(name, Row, rows) \
+class test_##name : public aunit::TestTable {\
+public:\
+  test_##name();\
+  void runRow(uint16_t index) override {\
+    Row row;\
+    memcpy_P(&row, &rows[index], sizeof(Row));\
+    testRow(row);\
+  }\
+  void testRow(const Row& row);\
+};\
+AUNIT_TEST_TYPE(test_##name, #name) test_##name##_instance;\
+test_##name :: test_##name() :\
+    aunit::TestTable(sizeof(rows) / sizeof(rows[0])) {\
+  init(AUNIT_F(#name));\
+}\
+void test_##name :: testRow(const Row& row)
+
+#define TEST_TABLE4(suiteName, name, Row, rows) \
+class suiteName##_##name : public aunit::TestTable {\
+public:\
+  suiteName##_##name();\
+  void runRow(uint16_t index) override {\
+    Row row;\
+    memcpy_P(&row, &rows[index], sizeof(Row));\
+    testRow(row);\
+  }\
+  void testRow(const Row& row);\
+};\
+AUNIT_TEST_TYPE(suiteName##_##name, #suiteName "_" #name)\
+    suiteName##_##name##_instance;\
+suiteName##_##name :: suiteName##_##name() :\
+    aunit::TestTable(sizeof(rows) / sizeof(rows[0])) {\
+  init(AUNIT_F(#suiteName "_" #name));\
+}\
+void suiteName##_##name :: testRow(const Row& row)
+
 /**
  * Create an extern reference to a testF() test case object defined elsewhere.
  * This is only necessary if you use assertTestXxx() or checkTestXxx() when the
@@ -218,8 +625,10 @@ class testClass ## _ ## name : public testClass {\
 public:\
   testClass ## _ ## name();\
   void once() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
 };\
-extern testClass ## _ ## name testClass##_##name##_instance
+extern AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass##_##name##_instance
 
 /**
  * Create an extern reference to a testingF() test case object defined
@@ -232,7 +641,9 @@ class testClass ## _ ## name : public testClass {\
 public:\
   testClass ## _ ## name();\
   void again() override;\
+  AUNIT_FIXTURE_SUITE(testClass)\
 };\
-extern testClass ## _ ## name testClass##_##name##_instance
+extern AUNIT_TEST_TYPE(testClass ## _ ## name, #testClass "_" #name)\
+    testClass##_##name##_instance
 
 #endif
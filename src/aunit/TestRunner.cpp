@@ -23,21 +23,71 @@ SOFTWARE.
 */
 
 #if EPOXY_DUINO
+#include <errno.h>
+#include <fcntl.h> // open()
+#include <limits.h> // INT_MAX
+#include <poll.h>
+#include <signal.h>
 #include <stdio.h>
+#include <stdlib.h> // atoi()
+#include <sys/wait.h>
+#include <unistd.h> // fork(), pipe()
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/sleep.h>
 #endif
 #include <Arduino.h>  // 'Serial' or SERIAL_PORT_MONITOR
 #include <string.h>
 #include <stdint.h>
 #include "FCString.h"
+#include "Filter.h"
 #include "Compare.h"
 #include "Printer.h"
+#include "Reporter.h"
+#include "TextReporter.h"
+#include "TapReporter.h"
+#include "JsonLinesReporter.h"
+#include "JUnitReporter.h"
+#include "BinaryReporter.h"
+#include "Shard.h"
+#if EPOXY_DUINO
+#include "Baselines.h"
+#include "NamedValueFile.h"
+#include "ResultsCache.h"
+#include "ImpactMap.h"
+#endif
 #include "Verbosity.h"
 #include "Test.h"
 #include "TestRunner.h"
-#include "string_util.h"
 
 namespace aunit {
 
+using internal::FilterRule;
+
+#if EPOXY_DUINO
+namespace {
+
+/** Recorded test durations in micros, given by the '--durations' flag. */
+internal::NamedValueFile durationsFile;
+bool isUpdatingDurations = false;
+
+/** Outcomes of the previous runs, given by the '--cache' flag. */
+internal::ResultsCache resultsCache;
+bool isFailedFirst = false;
+bool isOnlyFailed = false;
+
+/** Files executed by each test, given by the '--impact-map' flag. */
+internal::ImpactMap impactMap;
+
+}
+#endif
+
 // Use a function static singleton to avoid the static initialization ordering
 // problem. It's probably not an issue right now, since TestRunner is expected
 // to be called only after all static initialization, but future refactoring
@@ -51,135 +101,265 @@ void TestRunner::setPrinter(Print* printer) {
   Printer::setPrinter(printer);
 }
 
+void TestRunner::setReporter(Reporter* reporter) {
+  Reporter::setReporter(reporter);
+}
+
 void TestRunner::setLifeCycleMatchingPattern(const char* pattern,
     Test::LifeCycle lifeCycle) {
-  // Do an implicit excludeAll() if the first filter is an include().
-  if (!hasBeenFiltered && lifeCycle == Test::LifeCycle::New) {
-    excludeAll();
-  }
+  FilterRule rule = FilterRule::compile(nullptr, pattern, strlen(pattern),
+      false /*isSubstring*/, lifeCycle == Test::LifeCycle::New);
+  applyFilters(&rule, 1);
+}
+
+// The name of the test must be the join of testClass and pattern with a '_'
+// delimiter. This must match the algorithm used by testF() and testingF().
+// The FilterRule matches the two parts separately, so unlike a joined copy,
+// there is no limit on the length of the pattern.
+void TestRunner::setLifeCycleMatchingPattern(const char* testClass,
+    const char* pattern, Test::LifeCycle lifeCycle) {
+  FilterRule rule = FilterRule::compile(testClass, pattern, strlen(pattern),
+      false /*isSubstring*/, lifeCycle == Test::LifeCycle::New);
+  applyFilters(&rule, 1);
+}
+
+void TestRunner::setLifeCycleMatchingSubstring(
+    const char* substring, Test::LifeCycle lifeCycle) {
+  FilterRule rule = FilterRule::compile(nullptr, substring, strlen(substring),
+      true /*isSubstring*/, lifeCycle == Test::LifeCycle::New);
+  applyFilters(&rule, 1);
+}
+
+void TestRunner::applyFilters(const FilterRule* rules, size_t numRules) {
+  if (numRules == 0) return;
+
+  // Exclude all the other tests if the first filter is an include().
+  bool isExcludedByDefault = !hasBeenFiltered && rules[0].isInclude();
   hasBeenFiltered = true;
 
-  size_t length = strlen(pattern);
-  if (length > 0 && pattern[length - 1] == '*') {
-    // prefix match
-    length--;
-  } else {
-    // exact match
-    length++;
+#if AUNIT_ENABLE_TEST_ARRAY
+  // Once the tests are running, the finished ones are only in the array, and
+  // must not be changed.
+  if (mTests.isBuilt() && !mIsRunning) {
+    internal::applyFilters(mTests.begin(), mTests.end(), rules, numRules,
+        isExcludedByDefault);
+    return;
   }
+#endif
+  internal::applyFilters(Test::getRoot(), rules, numRules,
+      isExcludedByDefault);
+}
 
-  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
-    if ((*p)->getName().compareToN(pattern, length) == 0) {
-      (*p)->setLifeCycle(lifeCycle);
+// Count the number of tests in TestRunner instead of Test::insert() to avoid
+// another C++ static initialization ordering problem.
+uint16_t TestRunner::countTests() const {
+  uint16_t count = 0;
+#if AUNIT_ENABLE_TEST_ARRAY
+  // The tests dropped by the shard are Finished, and no longer in the list.
+  if (mTests.isBuilt()) {
+    for (Test* test : mTests) {
+      if (test->getLifeCycle() != Test::LifeCycle::Finished) count++;
     }
+    return count;
+  }
+#endif
+  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
+    count++;
   }
+  return count;
 }
 
-void TestRunner::setLifeCycleMatchingPattern(const char* testClass,
-    const char* pattern, Test::LifeCycle lifeCycle) {
+void TestRunner::applyShard() {
+  if (mShardCount <= 1 || mShardIndex >= mShardCount) return;
 
-  // Do an implicit excludeAll() if the first filter is an include().
-  if (!hasBeenFiltered && lifeCycle == Test::LifeCycle::New) {
-    excludeAll();
+#if EPOXY_DUINO
+  if (!durationsFile.isEmpty()) {
+    internal::selectShard(Test::getRoot(), mShardIndex, mShardCount,
+        durationsFile);
+    return;
   }
-  hasBeenFiltered = true;
+#endif
+  internal::selectShard(Test::getRoot(), mShardIndex, mShardCount);
+}
 
-  // The effective pattern is the join of testClass and pattern with a '_'
-  // delimiter. This must match the algorithm used by testF() and testingF().
-  // We use string_join() instead of String so that AUnit can avoid a direct
-  // dependency on the String class. AUnit thus avoids allocating any memory on
-  // the heap.
-  char fullPattern[kMaxPatternLength];
-  bool status = internal::string_join(fullPattern, kMaxPatternLength, '_',
-      testClass, pattern);
-  if (!status) return;
+void TestRunner::printStartRunner() const {
+  Reporter::getReporter()->beginRun(mCount, mVerbosity);
+}
 
-  setLifeCycleMatchingPattern(fullPattern, lifeCycle);
+void TestRunner::resolveRun() const {
+  RunSummary summary;
+  summary.count = mCount;
+  summary.passedCount = mPassedCount;
+  summary.failedCount = mFailedCount;
+  summary.skippedCount = mSkippedCount;
+  summary.expiredCount = mExpiredCount;
+  summary.testTimeoutCount = mTestTimeoutCount;
+  summary.durationMillis = mEndTime - mStartTime;
+#if AUNIT_ENABLE_TIMING
+  summary.slowest = mSlowest;
+  summary.numSlowest = mNumSlowest;
+#endif
+  Reporter::getReporter()->endRun(summary, mVerbosity);
+  Printer::flush();
 }
 
-void TestRunner::setLifeCycleMatchingSubstring(
-    const char* substring, Test::LifeCycle lifeCycle) {
+void TestRunner::resolveRepeat() const {
+  RepeatSummary summary;
+  summary.iterationCount = mIterationCount;
+  summary.failedIterationCount = mFailedIterationCount;
+  summary.durationMillis = mEndTime - mRepeatStartTime;
+#if AUNIT_ENABLE_REPEAT_STATS
+  summary.tests = mDone;
+#endif
+  Reporter::getReporter()->endRepeat(summary, mVerbosity);
+  Printer::flush();
+}
 
-  // Do an implicit excludeAll() if the first filter is an include().
-  if (!hasBeenFiltered && lifeCycle == Test::LifeCycle::New) {
-    excludeAll();
-  }
-  hasBeenFiltered = true;
+#if AUNIT_ENABLE_TIMING
 
-  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
-    if ((*p)->getName().hasSubstring(substring)) {
-      (*p)->setLifeCycle(lifeCycle);
-    }
+void TestRunner::recordTiming(Test* test) {
+  unsigned long total = test->getTiming().totalMicros();
+#if EPOXY_DUINO
+  if (isUpdatingDurations) durationsFile.record(test->getName(), total);
+#endif
+
+  // Find the insertion point, keeping the earlier test first on ties.
+  uint8_t i = mNumSlowest;
+  while (i > 0 && mSlowest[i - 1]->getTiming().totalMicros() < total) {
+    i--;
   }
-}
+  if (i >= kMaxSlowestTests) return;
 
-void TestRunner::excludeAll() {
-  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
-    (*p)->setLifeCycle(Test::LifeCycle::Excluded);
+  uint8_t last = (mNumSlowest < kMaxSlowestTests)
+      ? mNumSlowest++
+      : kMaxSlowestTests - 1;
+  for (uint8_t j = last; j > i; j--) {
+    mSlowest[j] = mSlowest[j - 1];
   }
+  mSlowest[i] = test;
 }
 
-// Count the number of tests in TestRunner instead of Test::insert() to avoid
-// another C++ static initialization ordering problem.
-uint16_t TestRunner::countTests() {
-  uint16_t count = 0;
+#endif
+
+// The New tests are skipped by the state machine without calling setup() or
+// teardown(), see runStep(). The tests already in Setup are skipped, so that
+// their teardown() is still called.
+void TestRunner::skipRemainingTests() {
+  mIsSkippingRemaining = true;
   for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
-    count++;
+    if ((*p)->getLifeCycle() == Test::LifeCycle::Setup) {
+      (*p)->skip();
+    }
   }
-  return count;
 }
 
-namespace {
+// The finished tests are put back in front of the ones still in the list, and
+// relinked in the order of the first run, since the tests do not finish in the
+// order in which they start. On EpoxyDuino, that order is saved by
+// saveRunOrder(), because '--failed-first' reorders the sorted tests.
+// Elsewhere, it is the order of the sort. The tests excluded from the run
+// were never started, and those skipped by setMaxFailures() are left New by
+// runStep().
+void TestRunner::resetRun() {
+  Test** root = Test::getRoot();
+  *mDoneTail = *root;
+  *root = mDone;
+  mDone = nullptr;
+  mDoneTail = &mDone;
 
-/**
- * Print the timeMillis as floating point seconds, without using floating point
- * math. This is the equivalent of 'printer->print((float) timeMillis / 1000)',
- * but saves 1400-1600 bytes of flash memory and 12 bytes of static memory.
- */
-void printSeconds(Print* printer, unsigned long timeMillis) {
-  int s = timeMillis / 1000;
-  int ms = timeMillis % 1000;
-  printer->print(s);
-  printer->print('.');
-  if (ms < 100) printer->print('0');
-  if (ms < 10) printer->print('0');
-  printer->print(ms);
+  for (Test* test = *root; test != nullptr; test = *test->getNext()) {
+    bool isExcluded = !test->isStarted()
+        && test->getLifeCycle() != Test::LifeCycle::New;
+    test->reset();
+    if (isExcluded) test->setLifeCycle(Test::LifeCycle::Excluded);
+  }
+  // Before setupRunner(), the list is still unsorted, and sorted by it.
+  if (mIsSetup) {
+#if EPOXY_DUINO
+    Test** tail = root;
+    for (Test* test : mRunTests) {
+      *tail = test;
+      tail = test->getNext();
+    }
+    *tail = nullptr;
+#elif AUNIT_ENABLE_TEST_ARRAY
+    mTests.relink(root);
+#else
+    Test::sortTests();
+#endif
+  }
+  resetCounters();
 }
 
+void TestRunner::resetCounters() {
+  mPassedCount = 0;
+  mFailedCount = 0;
+  mSkippedCount = 0;
+  mExpiredCount = 0;
+  mStatusErrorCount = 0;
+  mTestTimeoutCount = 0;
+#if AUNIT_ENABLE_TIMING
+  mNumSlowest = 0;
+#endif
+  mIsResolved = false;
+  mIsRunning = false;
+  mIsSweepBusy = false;
+  mHasSweepWake = false;
+  mIsSkippingRemaining = false;
+  mCurrent = Test::getRoot();
+  mStartTime = millis();
 }
 
-void TestRunner::printStartRunner() const {
-  if (!isVerbosity(Verbosity::kTestRunSummary)) return;
+// The tests of a fixture are adjacent in the sorted list, so the suite stays
+// open while the next test of the same fixture is still New, instead of being
+// closed and opened again between each of its tests. A reordering by
+// --failed-first can split a fixture, which then opens its suite more than
+// once, but setupSuite() and teardownSuite() are always paired.
+void TestRunner::releaseSuite(Test* test) {
+  internal::FixtureSuite* suite = test->getSuite();
+  if (suite == nullptr || !suite->isOpen()) return;
 
-  Print* printer = Printer::getPrinter();
-  printer->print(F("TestRunner started on "));
-  printer->print(mCount);
-  printer->println(F(" test(s)."));
+  if (test->isStarted()) suite->release();
+  if (suite->getNumActive() > 0) return;
+  for (Test* next = *test->getNext();
+      next != nullptr && next->getSuite() == suite;
+      next = *next->getNext()) {
+    if (next->getLifeCycle() == Test::LifeCycle::New) return;
+  }
+  suite->close();
 }
 
-void TestRunner::resolveRun() const {
-  if (!isVerbosity(Verbosity::kTestRunSummary)) return;
-  Print* printer = Printer::getPrinter();
+void TestRunner::setRunnerTimeout(TimeoutType timeout) {
+  mTimeoutMillis = timeout * 1000UL;
+}
 
-  printer->print(F("TestRunner duration: "));
-  printSeconds(printer, ellapsedMs());
-  printer->println(" seconds.");
+void TestRunner::idle(unsigned long millis) {
+#if defined(ARDUINO_ARCH_AVR)
+  // The timer0 overflow interrupt wakes up the CPU every ~1 ms.
+  unsigned long start = ::millis();
+  while (::millis() - start < millis) {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+  }
+#else
+  // nanosleep() on EpoxyDuino, vTaskDelay() on ESP32, a busy loop elsewhere.
+  delay(millis);
+#endif
+}
 
-  printer->print(F("TestRunner summary: "));
-  printer->print(mPassedCount);
-  printer->print(F(" passed, "));
-  printer->print(mFailedCount);
-  printer->print(F(" failed, "));
-  printer->print(mSkippedCount);
-  printer->print(F(" skipped, "));
-  printer->print(mExpiredCount);
-  printer->print(F(" timed out, out of "));
-  printer->print(mCount);
-  printer->println(F(" test(s)."));
+Test* TestRunner::findTest(const internal::FCString& name) {
+  if (! mIndex.isBuilt()) buildIndex();
+  return mIndex.find(name);
 }
 
-void TestRunner::setRunnerTimeout(TimeoutType timeout) {
-  mTimeout = timeout;
+void TestRunner::buildIndex() {
+#if AUNIT_ENABLE_TEST_ARRAY
+  if (mTests.isBuilt()) {
+    mIndex.build(mTests.begin(), mTests.end());
+    return;
+  }
+#endif
+  mIndex.build(*Test::getRoot());
 }
 
 //----------------------------------------------------------------------------
@@ -202,47 +382,91 @@ static void usageAndExit(int status) {
     "Usage: %s [--help|-h]\n"
       "   [--include pattern,...] [--exclude pattern,...]\n"
       "   [--includesub substring,...] [--excludesub substring,...]\n"
+      "   [--fail-fast] [--max-failures n]\n"
+      "   [--repeat n] [--until-fail]\n"
+      "   [--jobs n] [--isolate] [--kill-timeout seconds]\n"
+      "   [--baselines file] [--update-baselines]\n"
+      "   [--format text|tap|jsonl|junit|binary] [--color|--no-color]\n"
+      "   [--output file|fd]\n"
+      "   [--shard-index i --shard-count n]\n"
+      "   [--durations file] [--update-durations]\n"
+      "   [--cache file] [--failed-first] [--only-failed]\n"
+      "   [--impact-map file] [--changed-files file]\n"
+      "   [--serve]\n"
       "   [--] [substring ...]\n",
     epoxy_argv[0]
   );
   exit(status);
 }
 
-void TestRunner::processCommaList(
-    const char* const commaList, FilterType filterType) {
+// A number is a file descriptor opened by the caller (e.g. '3>log.txt' in the
+// shell), anything else is the name of a file which is created or truncated.
+static void setOutput(const char* target) {
+#if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+  char* end;
+  long number = strtol(target, &end, 10);
+  int fd;
+  if (*target != '\0' && *end == '\0') {
+    fd = (number >= 0 && number <= INT_MAX) ? (int) number : -1;
+    if (fd < 0 || fcntl(fd, F_GETFD) < 0) {
+      fprintf(stderr, "Invalid output file descriptor '%s'\n", target);
+      exit(1);
+    }
+  } else {
+    fd = open(target, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      fprintf(stderr, "Unable to open output file '%s'\n", target);
+      exit(1);
+    }
+  }
+  internal::FdPrint::getInstance()->setFd(fd);
+  Printer::setPrinter(internal::FdPrint::getInstance());
+#else
+  (void) target;
+  fprintf(stderr, "--output requires AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0\n");
+  exit(1);
+#endif
+}
 
-  const int kArgumentSize = 64;
-  const char* list = commaList;
+// The reporters are function statics, so that only the selected one is
+// constructed. The "text" format is the default reporter, so that it keeps
+// the --no-color option.
+static Reporter* findReporter(const char* format) {
+  if (argEquals(format, "text")) {
+    return TextReporter::getDefault();
+  } else if (argEquals(format, "tap")) {
+    static TapReporter tapReporter;
+    return &tapReporter;
+  } else if (argEquals(format, "jsonl")) {
+    static JsonLinesReporter jsonLinesReporter;
+    return &jsonLinesReporter;
+  } else if (argEquals(format, "junit")) {
+    static JUnitReporter junitReporter;
+    return &junitReporter;
+  } else if (argEquals(format, "binary")) {
+    static BinaryReporter binaryReporter;
+    return &binaryReporter;
+  } else {
+    return nullptr;
+  }
+}
 
-  // Loop for each comma-separate list of words. Call the filtering command
-  // defined by the filterType.
-  char argument[kArgumentSize];
+// Each word of the comma-separated list is compiled into a FilterRule which
+// points directly into the argv string, so the words are neither copied nor
+// truncated.
+void TestRunner::processCommaList(const char* const commaList,
+    FilterType filterType, std::vector<FilterRule>& rules) {
+  bool isSubstring = (filterType == FilterType::kIncludeSub
+      || filterType == FilterType::kExcludeSub);
+  bool isInclude = (filterType == FilterType::kInclude
+      || filterType == FilterType::kIncludeSub);
+
+  const char* list = commaList;
   while (*list != '\0') {
     const char* comma = strchr(list, ',');
-    int length = (comma) ? (comma - list) : strlen(list);
-
-    // Copy each word of the comma-separated list.
-    if (length >= kArgumentSize - 1) {
-      length = kArgumentSize - 1;
-    }
-    memcpy(argument, list, length);
-    argument[length] = '\0';
-
-    switch (filterType) {
-      case FilterType::kInclude:
-        include(argument);
-        break;
-      case FilterType::kExclude:
-        exclude(argument);
-        break;
-      case FilterType::kIncludeSub:
-        includesub(argument);
-        break;
-      case FilterType::kExcludeSub:
-        excludesub(argument);
-        break;
-    }
-
+    size_t length = (comma) ? (size_t) (comma - list) : strlen(list);
+    rules.push_back(FilterRule::compile(nullptr, list, length, isSubstring,
+        isInclude));
     list += (comma) ? length + 1 : length;
   }
 }
@@ -251,26 +475,131 @@ void TestRunner::processCommaList(
  * Parse command line flags.
  * Returns the index of the first argument after the flags.
  */
-int TestRunner::parseFlags(int argc, const char* const* argv) {
+int TestRunner::parseFlags(int argc, const char* const* argv,
+    std::vector<FilterRule>& rules) {
   int argc_original = argc;
   shift(argc, argv);
   while (argc > 0) {
     if (argEquals(argv[0], "--include")) {
       shift(argc, argv);
       if (argc == 0) usageAndExit(1);
-      processCommaList(argv[0], FilterType::kInclude);
+      processCommaList(argv[0], FilterType::kInclude, rules);
     } else if (argEquals(argv[0], "--exclude")) {
       shift(argc, argv);
       if (argc == 0) usageAndExit(1);
-      processCommaList(argv[0], FilterType::kExclude);
+      processCommaList(argv[0], FilterType::kExclude, rules);
     } else if (argEquals(argv[0], "--includesub")) {
       shift(argc, argv);
       if (argc == 0) usageAndExit(1);
-      processCommaList(argv[0], FilterType::kIncludeSub);
+      processCommaList(argv[0], FilterType::kIncludeSub, rules);
     } else if (argEquals(argv[0], "--excludesub")) {
       shift(argc, argv);
       if (argc == 0) usageAndExit(1);
-      processCommaList(argv[0], FilterType::kExcludeSub);
+      processCommaList(argv[0], FilterType::kExcludeSub, rules);
+    } else if (argEquals(argv[0], "--jobs")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int jobs = atoi(argv[0]);
+      if (jobs < 0 || jobs > 255) usageAndExit(1);
+      setParallelism(jobs);
+    } else if (argEquals(argv[0], "--fail-fast")) {
+      setMaxFailures(1);
+    } else if (argEquals(argv[0], "--max-failures")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int failures = atoi(argv[0]);
+      if (failures < 0 || failures > 65535) usageAndExit(1);
+      setMaxFailures(failures);
+    } else if (argEquals(argv[0], "--repeat")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int count = atoi(argv[0]);
+      if (count < 0 || count > 65535) usageAndExit(1);
+      setRepeat(count);
+    } else if (argEquals(argv[0], "--until-fail")) {
+      setUntilFail(true);
+    } else if (argEquals(argv[0], "--isolate")) {
+      setIsolation(true);
+    } else if (argEquals(argv[0], "--kill-timeout")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int seconds = atoi(argv[0]);
+      if (seconds < 0 || seconds > 65535) usageAndExit(1);
+      setKillTimeout(seconds);
+    } else if (argEquals(argv[0], "--baselines")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      if (!Baselines::load(argv[0])) {
+        fprintf(stderr, "Unable to read baselines file '%s'\n", argv[0]);
+        exit(1);
+      }
+    } else if (argEquals(argv[0], "--update-baselines")) {
+      Baselines::setUpdating(true);
+    } else if (argEquals(argv[0], "--shard-index")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int index = atoi(argv[0]);
+      if (index < 0 || index > 65535) usageAndExit(1);
+      mShardIndex = index;
+    } else if (argEquals(argv[0], "--shard-count")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      int count = atoi(argv[0]);
+      if (count < 1 || count > 65535) usageAndExit(1);
+      mShardCount = count;
+    } else if (argEquals(argv[0], "--durations")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      if (!durationsFile.load(argv[0])) {
+        fprintf(stderr, "Unable to read durations file '%s'\n", argv[0]);
+        exit(1);
+      }
+    } else if (argEquals(argv[0], "--update-durations")) {
+      isUpdatingDurations = true;
+    } else if (argEquals(argv[0], "--cache")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      if (!resultsCache.load(argv[0])) {
+        fprintf(stderr, "Unable to read cache file '%s'\n", argv[0]);
+        exit(1);
+      }
+    } else if (argEquals(argv[0], "--failed-first")) {
+      isFailedFirst = true;
+    } else if (argEquals(argv[0], "--only-failed")) {
+      isOnlyFailed = true;
+    } else if (argEquals(argv[0], "--impact-map")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      if (!impactMap.load(argv[0])) {
+        fprintf(stderr, "Unable to read impact map file '%s'\n", argv[0]);
+        exit(1);
+      }
+    } else if (argEquals(argv[0], "--changed-files")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      if (!impactMap.loadChangedFiles(argv[0])) {
+        fprintf(stderr, "Unable to read changed files '%s'\n", argv[0]);
+        exit(1);
+      }
+    } else if (argEquals(argv[0], "--serve")) {
+      setServing(true);
+    } else if (argEquals(argv[0], "--format")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      Reporter* reporter = findReporter(argv[0]);
+      if (reporter == nullptr) {
+        fprintf(stderr, "Unknown format '%s'\n", argv[0]);
+        usageAndExit(1);
+      }
+      setReporter(reporter);
+    } else if (argEquals(argv[0], "--output")) {
+      shift(argc, argv);
+      if (argc == 0) usageAndExit(1);
+      setOutput(argv[0]);
+    } else if (argEquals(argv[0], "--color")) {
+      TextReporter::getDefault()->setColor(true);
+    } else if (argEquals(argv[0], "--no-color")) {
+      TextReporter::getDefault()->setColor(false);
     } else if (argEquals(argv[0], "--")) {
       shift(argc, argv);
       break;
@@ -289,13 +618,678 @@ int TestRunner::parseFlags(int argc, const char* const* argv) {
   return argc_original - argc;
 }
 
+// All the filters of the command line are collected first, then applied in a
+// single pass over the tests.
 void TestRunner::processCommandLine() {
-  int args = parseFlags(epoxy_argc, epoxy_argv);
+  std::vector<FilterRule> rules;
+  int args = parseFlags(epoxy_argc, epoxy_argv, rules);
+  if (Baselines::isUpdating() && !Baselines::hasFile()) {
+    fprintf(stderr, "--update-baselines requires --baselines file\n");
+    usageAndExit(1);
+  }
+  if ((isFailedFirst || isOnlyFailed) && !resultsCache.hasFile()) {
+    fprintf(stderr, "--failed-first and --only-failed require --cache file\n");
+    usageAndExit(1);
+  }
+  if (impactMap.hasChangedFiles() && !impactMap.hasFile()) {
+    fprintf(stderr, "--changed-files requires --impact-map file\n");
+    usageAndExit(1);
+  }
+  if (isUpdatingDurations && !durationsFile.hasFile()) {
+    fprintf(stderr, "--update-durations requires --durations file\n");
+    usageAndExit(1);
+  }
+  if (mShardIndex >= (mShardCount ? mShardCount : 1)) {
+    fprintf(stderr, "--shard-index must be less than --shard-count\n");
+    usageAndExit(1);
+  }
 
   // Process any remaining *space*-separated arguments using includesub().
   for (int i = args; i < epoxy_argc; i++) {
-    includesub(epoxy_argv[i]);
+    rules.push_back(FilterRule::compile(nullptr, epoxy_argv[i],
+        strlen(epoxy_argv[i]), true /*isSubstring*/, true /*isInclude*/));
+  }
+
+  applyFilters(rules.data(), rules.size());
+}
+
+bool TestRunner::saveFiles() {
+  bool ok = Baselines::save();
+  if (isUpdatingDurations) ok = durationsFile.save("durations") && ok;
+  if (resultsCache.hasFile()) ok = resultsCache.save() && ok;
+  if (impactMap.hasFile()) ok = impactMap.save() && ok;
+  return ok;
+}
+
+void TestRunner::applyImpactMap() {
+  if (impactMap.hasChangedFiles()) impactMap.select(Test::getRoot());
+}
+
+void TestRunner::applyResultsCache() {
+  if (isFailedFirst || isOnlyFailed) {
+    resultsCache.reorder(Test::getRoot(), isOnlyFailed);
+  }
+}
+
+void TestRunner::saveRunOrder() {
+  mRunTests.clear();
+  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
+    mRunTests.push_back(*p);
+  }
+}
+
+void TestRunner::recordResult(const Test& test) {
+  if (resultsCache.hasFile()) resultsCache.record(test);
+  impactMap.record(test);
+}
+
+//----------------------------------------------------------------------------
+// Serving the runs requested on stdin on EpoxyDuino
+//----------------------------------------------------------------------------
+
+void TestRunner::startServing() {
+  mServeExcluded.clear();
+  for (Test* test : mRunTests) {
+    mServeExcluded.push_back(
+        test->getLifeCycle() == Test::LifeCycle::Excluded);
+  }
+  serve();
+}
+
+// Each command is one line of space-separated words. The filter commands
+// accumulate the rules of the next run, like the flags of the command line,
+// and the rules point directly into the saved lines until the 'run'.
+void TestRunner::serve() {
+  std::list<std::string> lines;
+  std::vector<FilterRule> rules;
+  Print* printer = Printer::getBufferedPrinter();
+  char* line = nullptr;
+  size_t capacity = 0;
+
+  while (true) {
+    printer->println(F("TestRunner ready."));
+    Printer::flush();
+    if (getline(&line, &capacity, stdin) < 0) break;
+
+    lines.emplace_back(line);
+    std::vector<const char*> words;
+    char* state;
+    for (char* word = strtok_r(&lines.back()[0], " \t\r\n", &state);
+        word != nullptr;
+        word = strtok_r(nullptr, " \t\r\n", &state)) {
+      words.push_back(word);
+    }
+    if (words.empty()) continue;
+
+    const char* command = words[0];
+    if (argEquals(command, "run")) {
+      for (size_t i = 1; i < words.size(); i++) {
+        rules.push_back(FilterRule::compile(nullptr, words[i],
+            strlen(words[i]), true /*isSubstring*/, true /*isInclude*/));
+      }
+      free(line);
+      restartRun(rules);
+      return;
+    } else if (argEquals(command, "quit")) {
+      break;
+    } else if (argEquals(command, "list")) {
+      printer->print(F("TestRunner test count: "));
+      printer->println(mRunTests.size());
+      for (size_t i = 0; i < mRunTests.size(); i++) {
+        printer->print(F("Test "));
+        mRunTests[i]->getName().print(printer);
+        if (mServeExcluded[i]) printer->print(F(" (excluded)"));
+        printer->println();
+      }
+      continue;
+    }
+
+    FilterType filterType;
+    if (argEquals(command, "include")) {
+      filterType = FilterType::kInclude;
+    } else if (argEquals(command, "exclude")) {
+      filterType = FilterType::kExclude;
+    } else if (argEquals(command, "includesub")) {
+      filterType = FilterType::kIncludeSub;
+    } else if (argEquals(command, "excludesub")) {
+      filterType = FilterType::kExcludeSub;
+    } else {
+      printer->print(F("TestRunner unknown command '"));
+      printer->print(command);
+      printer->println(F("'."));
+      continue;
+    }
+    for (size_t i = 1; i < words.size(); i++) {
+      processCommaList(words[i], filterType, rules);
+    }
+  }
+
+  free(line);
+  Printer::flush();
+  exit((mFailedIterationCount > 0) ? 1 : 0);
+}
+
+// The tests are relinked in the order saved by saveRunOrder(), so the tests
+// dropped by the shard or by '--only-failed' stay out of the runs.
+void TestRunner::restartRun(const std::vector<FilterRule>& rules) {
+  Test** tail = Test::getRoot();
+  for (size_t i = 0; i < mRunTests.size(); i++) {
+    Test* test = mRunTests[i];
+    test->reset();
+    if (mServeExcluded[i]) test->setLifeCycle(Test::LifeCycle::Excluded);
+    *tail = test;
+    tail = test->getNext();
+  }
+  *tail = nullptr;
+
+  // Each run is filtered as if by a new command line.
+  if (!rules.empty()) {
+    internal::applyFilters(Test::getRoot(), rules.data(), rules.size(),
+        rules[0].isInclude());
+  }
+
+  // The iterations of setRepeat() start over with each run.
+  mDone = nullptr;
+  mDoneTail = &mDone;
+#if AUNIT_ENABLE_REPEAT_STATS
+  for (Test* test : mRunTests) {
+    test->getRepeatStats() = Test::RepeatStats();
+  }
+#endif
+  mIterationCount = 0;
+  mFailedIterationCount = 0;
+  mCount = mRunTests.size();
+  resetCounters();
+  mRepeatStartTime = mStartTime;
+}
+
+//----------------------------------------------------------------------------
+// Parallel execution on EpoxyDuino
+//----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * A Print that collects the output of a test in memory, so that it can be
+ * written to the real printer in one piece when the test is finished. The
+ * growth of the buffer is not part of the heap usage of the test.
+ */
+class StringPrint: public Print {
+  public:
+    size_t write(uint8_t c) override {
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      internal::HeapTracker untracked(nullptr);
+    #endif
+      mBuffer.push_back(c);
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      internal::HeapTracker untracked(nullptr);
+    #endif
+      mBuffer.append(reinterpret_cast<const char*>(buffer), size);
+      return size;
+    }
+
+    /** Write the collected output to the printer, then clear the buffer. */
+    void flushTo(Print* printer) {
+      printer->write(
+          reinterpret_cast<const uint8_t*>(mBuffer.data()), mBuffer.size());
+      mBuffer.clear();
+    }
+
+  private:
+    std::string mBuffer;
+};
+
+}
+
+void TestRunner::runToCompletion(Test* test) {
+  test->enableVerbosity(mVerbosity);
+  test->setStarted();
+  setupTest(test);
+  if (test->getLifeCycle() == Test::LifeCycle::New) {
+    test->setLifeCycle(Test::LifeCycle::Setup);
+  }
+
+  while (test->getLifeCycle() == Test::LifeCycle::Setup) {
+    if (isTimedOut()) {
+      test->expire();
+    } else {
+      loopTest(test);
+      unsigned long wakeMillis;
+      if (TestAgain::consumeSleep(wakeMillis)) idleUntil(wakeMillis);
+    }
+  }
+
+  teardownTest(test);
+  test->setLifeCycle(Test::LifeCycle::Finished);
+  test->resolve();
+}
+
+void TestRunner::runParallel() {
+  std::vector<Test*> tests;
+  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
+    if ((*p)->getLifeCycle() == Test::LifeCycle::New && !(*p)->isSerial()
+        && (*p)->getSuite() == nullptr) {
+      tests.push_back(*p);
+    }
+  }
+
+  // Each worker pulls the next available test, and copies the output of the
+  // test to the printer of the main thread only after the test is resolved.
+  // The main thread must not hold an incomplete line while they write to its
+  // printer directly.
+  Printer::flush();
+  Print* printer = Printer::getPrinter();
+  std::atomic<size_t> next(0);
+  std::atomic<uint16_t> numFailures(mFailedCount + mExpiredCount);
+  std::mutex printerMutex;
+  auto worker = [&]() {
+    StringPrint buffer;
+    Printer::setPrinter(&buffer);
+    for (size_t i = next++; i < tests.size(); i = next++) {
+      // Tests left New once the limit is reached are skipped by the
+      // countStatus() of removeFinishedTests().
+      if (hasReachedMaxFailures(numFailures)) break;
+      runToCompletion(tests[i]);
+      if (tests[i]->isFailed() || tests[i]->isExpired()) numFailures++;
+      Printer::flush();
+      std::lock_guard<std::mutex> lock(printerMutex);
+      buffer.flushTo(printer);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint8_t i = 0; i < mParallelism; i++) {
+    workers.emplace_back(worker);
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+
+  removeFinishedTests();
+}
+
+// Nothing else is running at this point, so only the tests executed by the
+// workers can be Finished.
+void TestRunner::removeFinishedTests() {
+  for (Test** p = Test::getRoot(); *p != nullptr; ) {
+    if ((*p)->getLifeCycle() == Test::LifeCycle::Finished) {
+      countStatus(**p);
+    #if AUNIT_ENABLE_TIMING
+      recordTiming(*p);
+    #endif
+      retireTest(p);
+    } else {
+      p = (*p)->getNext();
+    }
   }
+  mCurrent = Test::getRoot();
+}
+
+
+//----------------------------------------------------------------------------
+// Process isolation on EpoxyDuino
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Type of the frames sent by a worker process to the TestRunner. */
+enum class FrameType : uint8_t {
+  kOutput, // output of the current test, in the order it was written
+  kResult, // IsolatedResult of the current test, after it was resolved
+};
+
+struct FrameHeader {
+  FrameType type;
+  uint32_t size;
+};
+
+/** Final state of a test run by a worker process. */
+struct IsolatedResult {
+  Test::Status status;
+  bool isTestTimeout;
+#if AUNIT_ENABLE_TIMING
+  Test::Timing timing;
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+  Test::HeapUsage heapUsage;
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+  uint16_t stackUsage;
+#endif
+};
+
+/** A worker process, as seen by the TestRunner. */
+struct Worker {
+  pid_t pid = -1; // -1 if not started, or lost
+  int commandFd = -1; // receives the index of the next test
+  int resultFd = -1; // sends the frames of the current test
+  Test* test = nullptr; // current test, nullptr if idle
+  unsigned long startMillis = 0;
+  std::string output;
+};
+
+bool readFully(int fd, void* data, size_t size) {
+  uint8_t* p = static_cast<uint8_t*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, p, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeFully(int fd, const void* data, size_t size) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, p, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeFrame(int fd, FrameType type, const void* data, size_t size) {
+  FrameHeader header = {type, static_cast<uint32_t>(size)};
+  return writeFully(fd, &header, sizeof(header))
+      && writeFully(fd, data, size);
+}
+
+/**
+ * The printer of a worker process, which sends the output of the test to the
+ * TestRunner as soon as it is written, so that the messages printed before a
+ * crash are not lost. Each line is a single frame when the Printer buffer is
+ * enabled.
+ */
+class PipePrint: public Print {
+  public:
+    explicit PipePrint(int fd): mFd(fd) {}
+
+    size_t write(uint8_t c) override {
+      return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+      return writeFrame(mFd, FrameType::kOutput, buffer, size) ? size : 0;
+    }
+
+  private:
+    int mFd;
+};
+
+/** Close the pipes of the worker and wait for its exit status. */
+int reapWorker(Worker& worker) {
+  close(worker.commandFd);
+  close(worker.resultFd);
+  int status = 0;
+  while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+  worker.pid = -1;
+  worker.commandFd = -1;
+  worker.resultFd = -1;
+  return status;
+}
+
+}
+
+void TestRunner::runWorker(int commandFd, int resultFd,
+    const std::vector<Test*>& tests) {
+  PipePrint output(resultFd);
+  Printer::setPrinter(&output);
+
+  uint32_t index;
+  while (readFully(commandFd, &index, sizeof(index))) {
+    Test* test = tests[index];
+    runToCompletion(test);
+    Printer::flush();
+
+    IsolatedResult result;
+    result.status = test->getStatus();
+    result.isTestTimeout = test->isTestTimeout();
+  #if AUNIT_ENABLE_TIMING
+    result.timing = test->getTiming();
+  #endif
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    result.heapUsage = test->getHeapUsage();
+  #endif
+  #if AUNIT_ENABLE_STACK_TRACKING
+    result.stackUsage = test->getStackUsage();
+  #endif
+    if (!writeFrame(resultFd, FrameType::kResult, &result, sizeof(result))) {
+      break;
+    }
+  }
+
+  // Skip the exit handlers and the stdio buffers inherited from the parent.
+  _exit(0);
+}
+
+void TestRunner::runIsolated() {
+  std::vector<Test*> tests;
+  for (Test** p = Test::getRoot(); *p != nullptr; p = (*p)->getNext()) {
+    if ((*p)->getLifeCycle() == Test::LifeCycle::New && !(*p)->isSerial()
+        && (*p)->getSuite() == nullptr) {
+      tests.push_back(*p);
+    }
+  }
+  if (tests.empty()) return;
+
+  // Nothing may be pending in the buffers of the parent, otherwise the forked
+  // workers would write it again. A worker which dies must not kill the
+  // TestRunner with a SIGPIPE.
+  Printer::flush();
+  fflush(stdout);
+  fflush(stderr);
+  Print* printer = Printer::getPrinter();
+  void (*oldSigpipe)(int) = signal(SIGPIPE, SIG_IGN);
+
+  size_t numWorkers = (mParallelism > 1) ? mParallelism : 1;
+  uint16_t numFailures = mFailedCount + mExpiredCount;
+  if (numWorkers > tests.size()) numWorkers = tests.size();
+  std::vector<Worker> workers(numWorkers);
+
+  auto spawn = [&](Worker& worker) {
+    int commandPipe[2];
+    int resultPipe[2];
+    if (pipe(commandPipe) != 0 || pipe(resultPipe) != 0) {
+      perror("Unable to create the pipes of a worker process");
+      exit(1);
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("Unable to fork a worker process");
+      exit(1);
+    }
+    if (pid == 0) {
+      // The worker must not hold the pipes of the other workers, which would
+      // prevent them from seeing the end of their commands.
+      for (Worker& other : workers) {
+        if (other.pid < 0) continue;
+        close(other.commandFd);
+        close(other.resultFd);
+      }
+      close(commandPipe[1]);
+      close(resultPipe[0]);
+      runWorker(commandPipe[0], resultPipe[1], tests);
+    }
+    close(commandPipe[0]);
+    close(resultPipe[1]);
+    worker.pid = pid;
+    worker.commandFd = commandPipe[1];
+    worker.resultFd = resultPipe[0];
+  };
+
+  // Copy the output of the test, then mark it Finished. The worker has already
+  // resolved the test, so only the state of the test is updated here, for the
+  // benefit of the serial tests and the summary.
+  auto finish = [&](Worker& worker, const IsolatedResult& result) {
+    Test* test = worker.test;
+    test->setStarted();
+    if (result.isTestTimeout) {
+      test->expireTestTimeout();
+    } else {
+      test->setStatus(result.status);
+    }
+  #if AUNIT_ENABLE_TIMING
+    test->getTiming() = result.timing;
+  #endif
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    test->getHeapUsage() = result.heapUsage;
+  #endif
+  #if AUNIT_ENABLE_STACK_TRACKING
+    test->getStackUsage() = result.stackUsage;
+  #endif
+    test->setLifeCycle(Test::LifeCycle::Finished);
+    if (test->isFailed() || test->isExpired()) numFailures++;
+    printer->write(reinterpret_cast<const uint8_t*>(worker.output.data()),
+        worker.output.size());
+    worker.output.clear();
+    worker.test = nullptr;
+  };
+
+  // Resolve the test of a worker which was lost, after the output it sent.
+  auto abandon = [&](Worker& worker, bool isKilled) {
+    Test* test = worker.test;
+    unsigned long elapsedMillis = millis() - worker.startMillis;
+    if (isKilled) kill(worker.pid, SIGKILL);
+    int status = reapWorker(worker);
+
+    test->enableVerbosity(mVerbosity);
+    test->setStarted();
+    if (isKilled) {
+      test->expireTestTimeout();
+    } else {
+      test->setStatus(Test::Status::Failed);
+    }
+  #if AUNIT_ENABLE_TIMING
+    test->getTiming().loopMicros = elapsedMillis * 1000;
+  #endif
+    printer->write(reinterpret_cast<const uint8_t*>(worker.output.data()),
+        worker.output.size());
+    worker.output.clear();
+
+    Reporter* reporter = Reporter::getReporter();
+    Print* message = reporter->beginMessage(test);
+    message->print(F("Test "));
+    test->getName().print(message);
+    if (isKilled) {
+      message->print(F(" killed after "));
+      message->print(elapsedMillis / 1000);
+      message->println(F(" seconds."));
+    } else if (WIFSIGNALED(status)) {
+      message->print(F(" crashed with signal "));
+      message->print(WTERMSIG(status));
+      message->print(F(" ("));
+      message->print(strsignal(WTERMSIG(status)));
+      message->println(F(")."));
+    } else {
+      message->print(F(" exited with status "));
+      message->print(WEXITSTATUS(status));
+      message->println('.');
+    }
+    reporter->endMessage();
+    test->setLifeCycle(Test::LifeCycle::Finished);
+    test->resolve();
+    Printer::flush();
+    numFailures++;
+    worker.test = nullptr;
+  };
+
+  // Once the limit of setMaxFailures() is reached, no more tests are handed
+  // out, and the ones left New are skipped by removeFinishedTests().
+  size_t next = 0;
+  size_t numDone = 0;
+  std::vector<pollfd> fds;
+  std::vector<Worker*> busy;
+  while (numDone < next
+      || (next < tests.size() && !hasReachedMaxFailures(numFailures))) {
+    // Hand out the next tests to the idle workers, replacing the lost ones.
+    for (Worker& worker : workers) {
+      if (worker.test != nullptr || next >= tests.size()) continue;
+      if (hasReachedMaxFailures(numFailures)) break;
+      if (worker.pid < 0) spawn(worker);
+      uint32_t index = next;
+      if (!writeFully(worker.commandFd, &index, sizeof(index))) {
+        // Died while idle. Try again with a new worker on the next pass.
+        reapWorker(worker);
+        continue;
+      }
+      worker.test = tests[next++];
+      worker.startMillis = millis();
+    }
+
+    // Wait for a frame, or for the earliest kill deadline.
+    fds.clear();
+    busy.clear();
+    int timeoutMillis = -1;
+    unsigned long now = millis();
+    for (Worker& worker : workers) {
+      if (worker.test == nullptr) continue;
+      if (mKillTimeoutMillis > 0) {
+        unsigned long elapsed = now - worker.startMillis;
+        int remaining = (elapsed >= mKillTimeoutMillis)
+            ? 0
+            : static_cast<int>(mKillTimeoutMillis - elapsed);
+        if (timeoutMillis < 0 || remaining < timeoutMillis) {
+          timeoutMillis = remaining;
+        }
+      }
+      fds.push_back({worker.resultFd, POLLIN, 0});
+      busy.push_back(&worker);
+    }
+    if (poll(fds.data(), fds.size(), timeoutMillis) < 0 && errno != EINTR) {
+      perror("Unable to poll the worker processes");
+      exit(1);
+    }
+
+    for (size_t i = 0; i < fds.size(); i++) {
+      Worker& worker = *busy[i];
+      if (fds[i].revents != 0) {
+        FrameHeader header;
+        bool ok = readFully(worker.resultFd, &header, sizeof(header));
+        if (ok && header.type == FrameType::kOutput) {
+          size_t size = worker.output.size();
+          worker.output.resize(size + header.size);
+          ok = readFully(worker.resultFd, &worker.output[size], header.size);
+        } else if (ok && header.type == FrameType::kResult
+            && header.size == sizeof(IsolatedResult)) {
+          IsolatedResult result;
+          ok = readFully(worker.resultFd, &result, sizeof(result));
+          if (ok) {
+            finish(worker, result);
+            numDone++;
+            continue;
+          }
+        } else {
+          ok = false;
+        }
+        if (!ok) {
+          abandon(worker, false /*isKilled*/);
+          numDone++;
+          continue;
+        }
+      }
+      if (mKillTimeoutMillis > 0
+          && millis() - worker.startMillis >= mKillTimeoutMillis) {
+        abandon(worker, true /*isKilled*/);
+        numDone++;
+      }
+    }
+  }
+
+  // Closing the command pipes tells the idle workers to exit.
+  for (Worker& worker : workers) {
+    if (worker.pid >= 0) reapWorker(worker);
+  }
+  signal(SIGPIPE, oldSigpipe);
+
+  removeFinishedTests();
 }
 
 #endif
@@ -27,11 +27,21 @@ SOFTWARE.
 
 #if defined(EPOXY_DUINO)
 #include <stdlib.h> // exit()
+#include <vector>
 #endif
 #include <stdint.h>
 #include <Arduino.h> // SERIAL_PORT_MONITOR, F(), Print
+#include "Printer.h"
 #include "Test.h"
-#include <chrono>
+#include "TestAgain.h"
+#include "Filter.h"
+#include "TestArray.h"
+#include "TestIndex.h"
+#include "HeapTracker.h"
+#include "StackTracker.h"
+#include "ImpactTracker.h"
+#include "Reporter.h"
+#include "print_util.h"
 
 // ESP32 does not defined SERIAL_PORT_MONITOR
 #ifndef SERIAL_PORT_MONITOR
@@ -59,6 +69,23 @@ class TestRunner {
       getRunner()->runTest();
     }
 
+    /**
+     * Return the test with the given full name (e.g. "suite_name" for
+     * test(suite, name) or testF(suite, name)), or nullptr if there is no such
+     * test. The lookup uses a hash table of all the tests, built once, so that
+     * a test or an external tool can query the status of other tests by name
+     * in constant time. See AUNIT_ENABLE_TEST_INDEX for when the table is
+     * built.
+     */
+    static Test* find(const char* name) {
+      return getRunner()->findTest(internal::FCString(name));
+    }
+
+    /** Same as find(const char*) with a flash string. */
+    static Test* find(const __FlashStringHelper* name) {
+      return getRunner()->findTest(internal::FCString(name));
+    }
+
     /** Print out the known tests. For debugging only. */
     static void list() {
       getRunner()->listTests();
@@ -66,7 +93,8 @@ class TestRunner {
 
     /**
      * Exclude the tests which match the pattern.
-     * Currently supports only a trailing '*'. For example, exclude("flash*").
+     * The '*' wildcard matches any sequence of characters, and '?' matches any
+     * single character. For example, exclude("flash*") or exclude("*_slow").
      */
     static void exclude(const char* pattern) {
       getRunner()->setLifeCycleMatchingPattern(
@@ -76,7 +104,7 @@ class TestRunner {
     /**
      * Exclude the tests which match the pattern given by (testClass + "_" +
      * pattern), the same concatenation rule used by the testF() macro.
-     * Currently supports only a trailing '*'. For example,
+     * The '*' and '?' wildcards are supported in the pattern. For example,
      * exclude("CustomTest", "flash*").
      */
     static void exclude(const char* testClass, const char* pattern) {
@@ -86,7 +114,8 @@ class TestRunner {
 
     /**
      * Include the tests which match the pattern.
-     * Currently supports only a trailing '*'. For example, include("flash*").
+     * The '*' and '?' wildcards are supported, as in exclude(). For example,
+     * include("flash*").
      */
     static void include(const char* pattern) {
       getRunner()->setLifeCycleMatchingPattern(pattern, Test::LifeCycle::New);
@@ -95,7 +124,7 @@ class TestRunner {
     /**
      * Include the tests which match the pattern given by (testClass + "_" +
      * pattern), the same concatenation rule used by the testF() macro.
-     * Currently supports only a trailing '*'. For example,
+     * The '*' and '?' wildcards are supported in the pattern. For example,
      * include("CustomTest", "flash*").
      */
     static void include(const char* testClass, const char* pattern) {
@@ -128,6 +157,15 @@ class TestRunner {
     /** Set the output printer. */
     static void setPrinter(Print* printer);
 
+    /**
+     * Set the Reporter which formats the results, for example a TapReporter,
+     * JsonLinesReporter, JUnitReporter or BinaryReporter. The reporter must
+     * outlive the run. Set to nullptr to restore the default TextReporter. On
+     * EpoxyDuino, the '--format text|tap|jsonl|junit|binary' flag selects one
+     * of the built-in reporters.
+     */
+    static void setReporter(Reporter* reporter);
+
     /**
      * Set test runner timeout across all tests, in seconds. Set to 0 for
      * infinite timeout. Useful for preventing testing() test cases that never
@@ -138,18 +176,178 @@ class TestRunner {
       getRunner()->setRunnerTimeout(seconds);
     }
 
+    /**
+     * Enable or disable the batch mode of the scheduler. In the default mode,
+     * each call to run() performs a single life cycle step of a single test.
+     * In batch mode, each call to run() sweeps through all the remaining
+     * tests, calling again() on every testing() test which is still running,
+     * and performing the setup(), teardown() and resolve() steps of the other
+     * tests in the same pass. The runner timeout is checked once per sweep.
+     * The tests are executed in exactly the same order in both modes, but
+     * batch mode reduces the overhead of the global loop() when there are
+     * many testing() tests.
+     */
+    static void setBatchMode(bool isBatchMode) {
+      getRunner()->mIsBatchMode = isBatchMode;
+    }
+
+    /**
+     * Enable or disable idling while all the remaining tests are asleep (see
+     * TestAgain::sleepUntil() and AUNIT_SLEEP()). When a whole pass through
+     * the remaining tests finds only sleeping tests, run() waits until the
+     * earliest of their wake times, with delay() on most platforms, and in the
+     * idle sleep mode of the CPU on AVR, instead of returning immediately.
+     * Enabled by default. Disable it if the global loop() must keep servicing
+     * something else between the calls to run().
+     */
+    static void setIdleSleep(bool isIdleSleep) {
+      getRunner()->mIsIdleSleep = isIdleSleep;
+    }
+
+    /**
+     * Stop the run after 'failures' tests have failed or timed out. The
+     * remaining tests are skipped without being started, the tests which are
+     * already running are skipped after their teardown(), and the summary is
+     * printed immediately. Set to 0 (the default) to always run all the
+     * tests. On EpoxyDuino, also available through the '--max-failures n'
+     * and '--fail-fast' (same as 1) flags.
+     */
+    static void setMaxFailures(uint16_t failures) {
+      getRunner()->mMaxFailures = failures;
+    }
+
+    /**
+     * Put the tests back into their state before the run, with Test::reset(),
+     * and zero the counters of the runner, so that the next run() starts the
+     * same tests again, without registering them again. The tests excluded
+     * from the run stay excluded, and the tests dropped by the shard are not
+     * added back. Should be called once isFinished() returns true, since the
+     * tests which are still running are reset without calling their
+     * teardown(). See also setRepeat().
+     */
+    static void reset() {
+      getRunner()->resetRun();
+    }
+
+    /** Return true if all the tests are resolved and the summary printed. */
+    static bool isFinished() {
+      return getRunner()->mIsResolved;
+    }
+
+    /**
+     * Run the tests 'count' times in a row, calling reset() between the
+     * iterations, then report the number of failed iterations, and the tests
+     * which failed in some of them (see AUNIT_ENABLE_REPEAT_STATS). A 'count'
+     * of 0 or 1 runs the tests once. The iterations also stop after one which
+     * reached the limit of setMaxFailures(). On EpoxyDuino, also available
+     * through the '--repeat n' flag, and exits with a non-zero status if any
+     * iteration failed.
+     */
+    static void setRepeat(uint16_t count) {
+      getRunner()->mRepeatCount = count;
+    }
+
+    /**
+     * Stop repeating the run after the first iteration in which a test failed
+     * or expired. Without setRepeat(), the run is repeated until that
+     * happens. On EpoxyDuino, also available through the '--until-fail' flag.
+     */
+    static void setUntilFail(bool isUntilFail) {
+      getRunner()->mIsUntilFail = isUntilFail;
+    }
+
+    /**
+     * Run only the tests of shard 'index' (starting at 0) out of 'count'
+     * shards, so that the tests of one binary can be spread over several
+     * processes or devices. The sorted tests are assigned round robin, so
+     * every shard given the same 'count' agrees on the partition, and the
+     * union of all shards runs every test exactly once. The tests of the other
+     * shards are neither run nor reported. A 'count' of 0 or 1, or an 'index'
+     * which is not less than 'count', disables sharding. Must be called before
+     * the first run(). On EpoxyDuino, also available through the
+     * '--shard-index i' and '--shard-count n' flags, and the shards can be
+     * balanced with recorded durations using '--durations file'.
+     */
+    static void setShard(uint16_t index, uint16_t count) {
+      TestRunner* runner = getRunner();
+      runner->mShardIndex = index;
+      runner->mShardCount = count;
+    }
+
+  #if EPOXY_DUINO
+    /**
+     * Run the tests on a pool of 'jobs' worker threads. Each test is run from
+     * setup() to teardown() by a single worker, and its output is buffered so
+     * that the messages of different tests do not interleave. Tests marked
+     * with serialTest(), serialTesting() (or Test::setSerial()), and the
+     * tests of fixtures which define setupSuite() or teardownSuite(), are run
+     * afterwards on the main thread, one at a time, as usual. A value of 0 or
+     * 1 disables parallel execution. Available only on EpoxyDuino, also
+     * through the '--jobs N' flag.
+     */
+    static void setParallelism(uint8_t jobs) {
+      getRunner()->mParallelism = jobs;
+    }
+
+    /**
+     * Run each test which is not serial in a separate worker process, so that
+     * a test which crashes, calls exit() or hangs cannot abort the entire run.
+     * The workers are forked from the TestRunner and reused, one process per
+     * job given by setParallelism() (at least one), and send the output and
+     * the result of each test back through a pipe. A worker which dies during
+     * a test fails that test, and a worker which exceeds the timeout of
+     * setKillTimeout() is killed and its test expired. Lost workers are
+     * replaced by new ones. Serial tests, and the tests of fixtures with
+     * setupSuite() or teardownSuite(), are run afterwards on the main process
+     * as usual. Available only on EpoxyDuino, also through the
+     * '--isolate' flag.
+     */
+    static void setIsolation(bool isIsolated) {
+      getRunner()->mIsIsolated = isIsolated;
+    }
+
+    /**
+     * Set the wall-clock time, in seconds, after which the worker process
+     * running an isolated test is killed. Set to 0 to never kill a worker.
+     * Default is kKillTimeoutDefault = 60. Also available through the
+     * '--kill-timeout seconds' flag. See setIsolation().
+     */
+    static void setKillTimeout(TimeoutType seconds) {
+      getRunner()->mKillTimeoutMillis = seconds * 1000UL;
+    }
+
+    /**
+     * Keep the program resident, and read the commands which select and start
+     * each run from stdin, instead of running the tests once and calling
+     * exit(). Between the runs, the tests go back to their state at the end
+     * of the global setup(), so they can run again without restarting the
+     * program. Available only on EpoxyDuino, also through the '--serve' flag.
+     * See the README.md for the commands.
+     */
+    static void setServing(bool isServing) {
+      getRunner()->mIsServing = isServing;
+    }
+  #endif
+
   private:
     /** Default total timeout for the test runner. */
     static const TimeoutType kTimeoutDefault = 10;
 
-    /** Maximum length of the joined matching pattern, including NUL. */
-    static const uint8_t kMaxPatternLength = 63 + 1;
+  #if EPOXY_DUINO
+    /** Default kill timeout of the worker processes of isolated tests. */
+    static const TimeoutType kKillTimeoutDefault = 60;
+  #endif
+
+  #if AUNIT_ENABLE_TIMING
+    /** Number of slowest tests printed at the end of the run. */
+    static const uint8_t kMaxSlowestTests = 5;
+  #endif
 
     /** Return the singleton TestRunner. */
     static TestRunner* getRunner();
 
     /** Count the number of tests. */
-    static uint16_t countTests();
+    uint16_t countTests() const;
 
     // Disable copy-constructor and assignment operator
     TestRunner(const TestRunner&) = delete;
@@ -158,16 +356,14 @@ class TestRunner {
     /** Constructor. */
     TestRunner() {}
 
-    int ellapsedSeconds() const
-    {
-      auto now = std::chrono::high_resolution_clock::now();
-      return std::chrono::duration_cast<std::chrono::seconds>(now - mStartTime).count();
-    }
-
-    int ellapsedMs() const
-    {
-      auto now = std::chrono::high_resolution_clock::now();
-      return std::chrono::duration_cast<std::chrono::milliseconds>(now - mStartTime).count();
+    /**
+     * Return true if the runner timeout has been reached. Uses millis(),
+     * which is monotonic and much cheaper than a system clock call, against
+     * the timeout in milliseconds cached by setRunnerTimeout().
+     */
+    bool isTimedOut() const {
+      return mTimeoutMillis > 0
+          && (unsigned long) (millis() - mStartTime) >= mTimeoutMillis;
     }
 
     /**
@@ -185,34 +381,95 @@ class TestRunner {
       if (!mIsRunning) {
         printStartRunner();
         mIsRunning = true;
+      #if EPOXY_DUINO
+        if (mIsIsolated) {
+          runIsolated();
+        } else if (mParallelism > 1) {
+          runParallel();
+        }
+      #endif
       }
 
       // If no more test cases, then print out summary of run.
       if (*Test::getRoot() == nullptr) {
         if (!mIsResolved) {
-          mEndTime = std::chrono::high_resolution_clock::now();
+          mEndTime = millis();
           resolveRun();
           mIsResolved = true;
+          bool isFailed = mFailedCount || mExpiredCount;
+          mIterationCount++;
+          if (isFailed) mFailedIterationCount++;
+          if (hasMoreIterations(isFailed)) {
+            resetRun();
+            return;
+          }
+          if (isRepeating()) resolveRepeat();
         #if EPOXY_DUINO
-          exit((mFailedCount || mExpiredCount) ? 1 : 0);
+          bool isSaved = saveFiles();
+          if (mIsServing) {
+            serve();
+            return;
+          }
+          exit((mFailedIterationCount > 0 || !isSaved) ? 1 : 0);
         #endif
         }
         return;
       }
 
+      if (mIsBatchMode) {
+        // Advance every remaining test in a single pass. Each test is stepped
+        // until it either stays in the Setup state after a loop(), or is
+        // resolved and removed, which is exactly the sequence of steps that
+        // the same number of individual runTest() calls would perform.
+        mCurrent = Test::getRoot();
+        mIsSweepTimedOut = isTimedOut();
+        while (*mCurrent != nullptr) {
+          runStep();
+        }
+        endSweep();
+        return;
+      }
+
       // If reached the end and there are still test cases left, start from the
       // beginning again.
       if (*mCurrent == nullptr) {
+        endSweep();
         mCurrent = Test::getRoot();
       }
 
+      runStep();
+    }
+
+    /**
+     * Perform the next life cycle step of the current test, and advance
+     * mCurrent when the current test has nothing more to do in this pass.
+     */
+    void runStep() {
       // Implement a finite state machine that calls the (*mCurrent)->setup() or
       // (*mCurrent)->loop(), then changes the test case's mStatus.
-      switch ((*mCurrent)->getLifeCycle()) {
+      Test::LifeCycle lifeCycle = (*mCurrent)->getLifeCycle();
+      if (lifeCycle != Test::LifeCycle::Setup) mIsSweepBusy = true;
+      switch (lifeCycle) {
         case Test::LifeCycle::New:
+          // Once the limit of setMaxFailures() is reached, the tests which
+          // have not started are skipped, without calling setup() or
+          // teardown(), but are left New instead of Excluded for reset().
+          if (mIsSkippingRemaining) {
+            (*mCurrent)->enableVerbosity(mVerbosity);
+            (*mCurrent)->setStatus(Test::Status::Skipped);
+            mSkippedCount++;
+            releaseSuite(*mCurrent);
+            (*mCurrent)->resolve();
+            (*mCurrent)->setLifeCycle(Test::LifeCycle::New);
+            retireTest(mCurrent);
+            break;
+          }
+
           // Transfer the verbosity of the TestRunner to the Test.
           (*mCurrent)->enableVerbosity(mVerbosity);
-          (*mCurrent)->setup();
+          (*mCurrent)->setStarted();
+          openSuite(*mCurrent);
+          setupTest(*mCurrent);
 
           // Support assertXxx() statements inside the setup() method by
           // moving to the next lifeCycle state if an assertXxx() did not fail
@@ -227,21 +484,26 @@ class TestRunner {
           (*mCurrent)->enableVerbosity(mVerbosity);
           (*mCurrent)->setStatus(Test::Status::Skipped);
           mSkippedCount++;
+          releaseSuite(*mCurrent);
           (*mCurrent)->setLifeCycle(Test::LifeCycle::Finished);
           break;
         case Test::LifeCycle::Setup:
           {
-            // Check for timeout. mTimeout == 0 means infinite timeout. NOTE: It
+            // Check for timeout. mTimeoutMillis == 0 means infinite timeout.
+            // Per-test timeouts are checked by TestAgain::loop(). NOTE: It
             // feels like this code should go into the Test::loop() method (like
             // the extra bit of code in TestOnce::loop()) because it seems like
             // we could want the timeout to be configurable on a case by case
             // basis. This would cause the testing() code to move down into a
             // new again() virtual method dispatched from Test::loop(),
-            // analogous to once(). But let's keep the code here for now.
-            if (mTimeout > 0 && ellapsedSeconds() >= mTimeout) {
+            // analogous to once(). But let's keep the code here for now. In
+            // batch mode, the timeout is evaluated once at the start of the
+            // sweep.
+            if (mIsBatchMode ? mIsSweepTimedOut : isTimedOut()) {
               (*mCurrent)->expire();
             } else {
-              (*mCurrent)->loop();
+              loopTest(*mCurrent);
+              recordSleep();
 
               // If test status is unresolved (i.e. still in LifeCycle::New
               // state) after loop(), then this is a continuous testing() test
@@ -256,33 +518,244 @@ class TestRunner {
           }
           break;
         case Test::LifeCycle::Asserted:
-          switch ((*mCurrent)->getStatus()) {
-            case Test::Status::Skipped:
-              mSkippedCount++;
-              break;
-            case Test::Status::Passed:
-              mPassedCount++;
-              break;
-            case Test::Status::Failed:
-              mFailedCount++;
-              break;
-            case Test::Status::Expired:
-              mExpiredCount++;
-              break;
-            default:
-              // should never get here
-              mStatusErrorCount++;
-              break;
-          }
-          (*mCurrent)->teardown();
+          countStatus(**mCurrent);
+          teardownTest(*mCurrent);
+          releaseSuite(*mCurrent);
+        #if AUNIT_ENABLE_TIMING
+          recordTiming(*mCurrent);
+        #endif
           (*mCurrent)->setLifeCycle(Test::LifeCycle::Finished);
           break;
         case Test::LifeCycle::Finished:
           (*mCurrent)->resolve();
           // skip to the next one by taking current test out of the list
-          *mCurrent = *(*mCurrent)->getNext();
+          retireTest(mCurrent);
+          break;
+      }
+    }
+
+    /**
+     * Call test->setup(), and record its duration if AUNIT_ENABLE_TIMING is
+     * set. The micros() clock is cheap on Arduino, and monotonic on
+     * EpoxyDuino. The heap memory allocated by the call is recorded if
+     * AUNIT_ENABLE_HEAP_TRACKING is set, its stack usage if
+     * AUNIT_ENABLE_STACK_TRACKING is set, and the functions which it executes
+     * if AUNIT_ENABLE_IMPACT_TRACKING is set. The output of the previous steps
+     * is written first, if it would otherwise come after the output of the
+     * test, which starts a new block of AUNIT_INTERN_FILE_NAMES.
+     */
+    static void setupTest(Test* test) {
+      Printer::sync();
+    #if AUNIT_INTERN_FILE_NAMES
+      internal::resetPrintedFiles();
+    #endif
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      internal::HeapTracker tracker(&test->getHeapUsage());
+    #endif
+    #if AUNIT_ENABLE_STACK_TRACKING
+      internal::StackTracker stackTracker(test->getStackUsage());
+    #endif
+    #if AUNIT_ENABLE_IMPACT_TRACKING
+      internal::ImpactTracker impactTracker(test);
+    #endif
+    #if AUNIT_ENABLE_TIMING
+      unsigned long start = micros();
+      test->setup();
+      test->getTiming().setupMicros += micros() - start;
+    #else
+      test->setup();
+    #endif
+    }
+
+    /** Call test->loop(), and record its duration. See setupTest(). */
+    static void loopTest(Test* test) {
+      Printer::sync();
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      internal::HeapTracker tracker(&test->getHeapUsage());
+    #endif
+    #if AUNIT_ENABLE_STACK_TRACKING
+      internal::StackTracker stackTracker(test->getStackUsage());
+    #endif
+    #if AUNIT_ENABLE_IMPACT_TRACKING
+      internal::ImpactTracker impactTracker(test);
+    #endif
+    #if AUNIT_ENABLE_TIMING
+      unsigned long start = micros();
+      test->loop();
+      Test::Timing& timing = test->getTiming();
+      timing.loopMicros += micros() - start;
+      timing.loopCount++;
+    #else
+      test->loop();
+    #endif
+    }
+
+    /** Call test->teardown(), and record its duration. See setupTest(). */
+    static void teardownTest(Test* test) {
+      Printer::sync();
+    #if AUNIT_ENABLE_HEAP_TRACKING
+      internal::HeapTracker tracker(&test->getHeapUsage());
+    #endif
+    #if AUNIT_ENABLE_STACK_TRACKING
+      internal::StackTracker stackTracker(test->getStackUsage());
+    #endif
+    #if AUNIT_ENABLE_IMPACT_TRACKING
+      internal::ImpactTracker impactTracker(test);
+    #endif
+    #if AUNIT_ENABLE_TIMING
+      unsigned long start = micros();
+      test->teardown();
+      test->getTiming().teardownMicros += micros() - start;
+    #else
+      test->teardown();
+    #endif
+    }
+
+    /**
+     * Record whether the last loop() was skipped because the test is asleep,
+     * and the earliest wake time of the current pass through the tests.
+     */
+    void recordSleep() {
+      unsigned long wakeMillis;
+      if (!TestAgain::consumeSleep(wakeMillis)) {
+        mIsSweepBusy = true;
+      } else if (!mHasSweepWake || (long) (wakeMillis - mSweepWakeMillis) < 0) {
+        mSweepWakeMillis = wakeMillis;
+        mHasSweepWake = true;
+      }
+    }
+
+    /**
+     * Called at the end of each pass through the tests. Idle until the
+     * earliest wake time if every test of the pass was asleep, but not beyond
+     * the timeout of the TestRunner.
+     */
+    void endSweep() {
+      if (!mIsSweepBusy && mHasSweepWake) idleUntil(mSweepWakeMillis);
+      mIsSweepBusy = false;
+      mHasSweepWake = false;
+    }
+
+    /**
+     * Idle until 'wakeMillis', or until the timeout of the TestRunner if that
+     * comes first. Does nothing if disabled by setIdleSleep(false).
+     */
+    void idleUntil(unsigned long wakeMillis) const {
+      if (!mIsIdleSleep) return;
+      unsigned long now = millis();
+      long wait = (long) (wakeMillis - now);
+      if (mTimeoutMillis > 0) {
+        long remaining = (long) (mStartTime + mTimeoutMillis - now);
+        if (remaining < wait) wait = remaining;
+      }
+      if (wait > 0) idle(wait);
+    }
+
+    /** Wait for 'millis' milliseconds, using as little power as possible. */
+    static void idle(unsigned long millis);
+
+    /**
+     * Call the setupSuite() of the fixture of the test, if it has one and it
+     * is not already open. Called before the setup() of the test.
+     */
+    static void openSuite(Test* test) {
+      internal::FixtureSuite* suite = test->getSuite();
+      if (suite != nullptr) suite->open();
+    }
+
+    /**
+     * Call the teardownSuite() of the fixture of the test, if none of the
+     * tests of the fixture is running, and the following tests in the list
+     * (where the other tests of the fixture are sorted) will not reopen it.
+     * Called after the teardown() of the test, or when it is excluded.
+     */
+    static void releaseSuite(Test* test);
+
+    /**
+     * Increment the result counter corresponding to the status of test, and
+     * the results of the test over the iterations.
+     */
+    void countStatus(Test& test) {
+    #if AUNIT_ENABLE_REPEAT_STATS
+      Test::RepeatStats& stats = test.getRepeatStats();
+      if (test.isPassed()) {
+        if (stats.passedCount < 0xFFFF) stats.passedCount++;
+      } else if (test.isFailed() || test.isExpired()) {
+        if (stats.failedCount < 0xFFFF) stats.failedCount++;
+      }
+    #endif
+      switch (test.getStatus()) {
+        case Test::Status::Skipped:
+          mSkippedCount++;
           break;
+        case Test::Status::Passed:
+          mPassedCount++;
+          break;
+        case Test::Status::Failed:
+          mFailedCount++;
+          if (hasReachedMaxFailures(mFailedCount + mExpiredCount)) {
+            skipRemainingTests();
+          }
+          break;
+        case Test::Status::Expired:
+          mExpiredCount++;
+          if (test.isTestTimeout()) mTestTimeoutCount++;
+          if (hasReachedMaxFailures(mFailedCount + mExpiredCount)) {
+            skipRemainingTests();
+          }
+          break;
+        default:
+          // should never get here
+          mStatusErrorCount++;
+          break;
+      }
+    #if EPOXY_DUINO
+      recordResult(test);
+    #endif
+    }
+
+    /** Return true if the limit of setMaxFailures() has been reached. */
+    bool hasReachedMaxFailures(uint16_t numFailures) const {
+      return mMaxFailures > 0 && numFailures >= mMaxFailures;
+    }
+
+    /** Skip all the tests which have not been resolved yet. */
+    void skipRemainingTests();
+
+    /**
+     * Take the test out of the list, which moves *p to the next test, and
+     * append it to the finished tests, which are put back by resetRun().
+     */
+    void retireTest(Test** p) {
+      Test* test = *p;
+      *p = *test->getNext();
+      *test->getNext() = nullptr;
+      *mDoneTail = test;
+      mDoneTail = test->getNext();
+    }
+
+    /** Implement reset(). */
+    void resetRun();
+
+    /**
+     * Zero the counters, and start a new run from the head of the list. Part
+     * of resetRun().
+     */
+    void resetCounters();
+
+    /** Return true if one more iteration of setRepeat() must run. */
+    bool hasMoreIterations(bool isFailed) const {
+      if (isFailed && (mIsUntilFail
+          || hasReachedMaxFailures(mFailedCount + mExpiredCount))) {
+        return false;
       }
+      if (mRepeatCount > 1) return mIterationCount < mRepeatCount;
+      return mIsUntilFail;
+    }
+
+    /** Return true if the run is repeated by setRepeat() or setUntilFail(). */
+    bool isRepeating() const {
+      return mRepeatCount > 1 || mIsUntilFail;
     }
 
     /**
@@ -296,7 +769,7 @@ class TestRunner {
     void listTests() {
       setupRunner();
 
-      Print* printer = Printer::getPrinter();
+      Print* printer = Printer::getBufferedPrinter();
       printer->print(F("TestRunner test count: "));
       printer->println(mCount);
       for (Test** p = Test::getRoot(); (*p) != nullptr; p = (*p)->getNext()) {
@@ -307,16 +780,30 @@ class TestRunner {
       }
     }
 
-    /** Print out message at the start of the run. */
+    /** Report the start of the run to the Reporter. */
     void printStartRunner() const;
 
-    /** Print out the summary of the entire test suite. */
+    /** Report the summary of the entire test suite to the Reporter. */
     void resolveRun() const;
 
+    /** Report the results of all the iterations to the Reporter. */
+    void resolveRepeat() const;
+
+  #if AUNIT_ENABLE_TIMING
+    /**
+     * Keep track of the kMaxSlowestTests tests with the longest total time.
+     * The Test instances are static, so remain valid after they are removed
+     * from the linked list.
+     */
+    void recordTiming(Test* test);
+
+  #endif
+
     /**
      * Perform TestRunner initialization. The default Printer::getPrinter()
      * is set to `SERIAL_PORT_MONITOR` if it was not already set by something
-     * else in the global setup() function.
+     * else in the global setup() function, or to the native output on stdout
+     * on EpoxyDuino (see AUNIT_NATIVE_OUTPUT_BUFFER_SIZE).
      *
      * Important flash memory optimization:
      *
@@ -372,16 +859,45 @@ class TestRunner {
       if (mIsSetup) return;
 
       if (! Printer::getPrinter()) {
+      #if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+        internal::FdPrint::getInstance()->setFd(STDOUT_FILENO);
+        Printer::setPrinter(internal::FdPrint::getInstance());
+      #else
         Printer::setPrinter(&SERIAL_PORT_MONITOR);
+      #endif
       }
 
+    #if AUNIT_ENABLE_TEST_ARRAY
+      // Before the filters of the command line, which then use the array.
+      mTests.build(Test::getRoot());
+    #endif
     #if EPOXY_DUINO
       processCommandLine();
     #endif
       mIsSetup = true;
+    #if AUNIT_ENABLE_TEST_ARRAY
+      mTests.sort();
+      mTests.relink(Test::getRoot());
+    #else
+      Test::sortTests();
+    #endif
+    #if AUNIT_ENABLE_TEST_INDEX
+      // Before any test is removed from the list by sharding or running.
+      if (! mIndex.isBuilt()) buildIndex();
+    #endif
+      applyShard();
+    #if EPOXY_DUINO
+      applyImpactMap();
+      applyResultsCache();
+      saveRunOrder();
+    #endif
       mCount = countTests();
       mCurrent = Test::getRoot();
-      mStartTime = std::chrono::high_resolution_clock::now();
+      mStartTime = millis();
+      mRepeatStartTime = mStartTime;
+    #if EPOXY_DUINO
+      if (mIsServing) startServing();
+    #endif
     }
 
     /** Enables the given verbosity. */
@@ -406,12 +922,32 @@ class TestRunner {
     void setLifeCycleMatchingSubstring(
         const char* substring, Test::LifeCycle lifeCycle);
 
-    /** Forcibly exclude all tests. */
-    void excludeAll();
+    /**
+     * Apply the compiled filter rules, in order, in a single pass over the
+     * tests. If this is the first filter and it is an include, the tests which
+     * do not match any rule are excluded.
+     */
+    void applyFilters(const internal::FilterRule* rules, size_t numRules);
 
     /** Set the test runner timeout. */
     void setRunnerTimeout(TimeoutType seconds);
 
+    /** Find the test by name, building the index if necessary. */
+    Test* findTest(const internal::FCString& name);
+
+    /**
+     * Build the index of find() from the array of all the tests if
+     * AUNIT_ENABLE_TEST_ARRAY is set, otherwise from the list of the active
+     * tests.
+     */
+    void buildIndex();
+
+    /**
+     * Remove the tests which are not in the shard selected by setShard() from
+     * the sorted list of tests.
+     */
+    void applyShard();
+
   #if EPOXY_DUINO
     enum class FilterType : uint8_t {
       kInclude,
@@ -423,14 +959,108 @@ class TestRunner {
     /** Process command line arguments on EpoxyDuino. */
     void processCommandLine();
 
-    /** Parse the command line flags. */
-    int parseFlags(int argc, const char* const* argv);
+    /**
+     * Parse the command line flags. The filter flags are appended to 'rules'
+     * instead of being applied immediately.
+     */
+    int parseFlags(int argc, const char* const* argv,
+        std::vector<internal::FilterRule>& rules);
+
+    /**
+     * Compile the comma-separated list of words for --include, --exclude,
+     * --includesub and --excludesub flags into 'rules'.
+     */
+    void processCommaList(const char* commaList, FilterType filterType,
+        std::vector<internal::FilterRule>& rules);
+
+    /**
+     * Save which of the tests selected by the global setup() and the command
+     * line are excluded, the starting point of each run of serve(). Then wait
+     * for the first run.
+     */
+    void startServing();
+
+    /**
+     * Read the commands of setServing() from stdin, until the 'run' command,
+     * which calls restartRun() and returns. Calls exit() at the end of stdin,
+     * or on the 'quit' command.
+     */
+    void serve();
+
+    /**
+     * Put the tests saved by startServing() back into the list in their
+     * initial state, apply the filter rules of the next run, and reset the
+     * counters of the runner.
+     */
+    void restartRun(const std::vector<internal::FilterRule>& rules);
+
+    /**
+     * Run all tests which are not marked as serial, and do not belong to a
+     * fixture suite, on a pool of mParallelism worker threads, then remove
+     * them from the linked list of tests. The remaining tests are handled by
+     * runTest() as usual.
+     */
+    void runParallel();
+
+    /**
+     * Run the given test through its entire life cycle, from setup() to
+     * resolve(), in the calling thread.
+     */
+    void runToCompletion(Test* test);
+
+    /**
+     * Run the tests which are not marked as serial on a pool of worker
+     * processes, then remove them from the linked list of tests. See
+     * setIsolation().
+     */
+    void runIsolated();
+
+    /**
+     * Main loop of a worker process of runIsolated(). Run the tests whose
+     * indexes in 'tests' are read from 'commandFd', and send their output and
+     * results to 'resultFd', until 'commandFd' is closed. Never returns.
+     */
+    void runWorker(int commandFd, int resultFd,
+        const std::vector<Test*>& tests);
+
+    /**
+     * Take the tests which were finished by runParallel() or runIsolated() out
+     * of the list, and merge their results into the counters of the runner.
+     */
+    void removeFinishedTests();
+
+    /**
+     * Write the files requested on the command line: the benchmark baselines
+     * if '--update-baselines', the test durations if '--update-durations',
+     * the results cache if '--cache', and the impact map if '--impact-map'.
+     * Return false on error.
+     */
+    static bool saveFiles();
+
+    /**
+     * Exclude the tests which are not affected by the '--changed-files',
+     * according to the '--impact-map'.
+     */
+    void applyImpactMap();
+
+    /**
+     * Reorder or filter the sorted tests using the results cache, for the
+     * '--failed-first' and '--only-failed' flags.
+     */
+    void applyResultsCache();
+
+    /**
+     * Save the tests of the list in their order after the sort, the shard and
+     * '--failed-first', which resetRun() and restartRun() relink for each
+     * iteration of setRepeat() and each run of serve().
+     */
+    void saveRunOrder();
 
     /**
-     * Process the comma-separated list of words for --include, --exclude,
-     * --includesub and --excludesub flags.
+     * Record the result of a test in the results cache, if '--cache', and
+     * its footprint in the impact map, if '--impact-map'.
      */
-    void processCommaList(const char* commaList, FilterType filterType);
+    static void recordResult(const Test& test);
   #endif
 
   private:
@@ -438,10 +1068,22 @@ class TestRunner {
     // allows treating the root node the same as all the other nodes, and
     // simplifies the code traversing the singly-linked list significantly.
     Test** mCurrent = nullptr;
+    internal::TestIndex mIndex;
+  #if AUNIT_ENABLE_TEST_ARRAY
+    // All the tests, in sorted order, built by setupRunner().
+    internal::TestArray mTests;
+  #endif
 
     bool mIsResolved = false;
     bool mIsSetup = false;
     bool mIsRunning = false;
+    bool mIsBatchMode = false;
+    bool mIsSweepTimedOut = false;
+    bool mIsIdleSleep = true;
+    // State of the current pass through the tests, see endSweep().
+    bool mIsSweepBusy = false;
+    bool mHasSweepWake = false;
+    unsigned long mSweepWakeMillis = 0;
     Verbosity mVerbosity = Verbosity::kDefault;
     // True if any include(), exclude(), includesub(), excludesub() was invoked.
     bool hasBeenFiltered = false;
@@ -451,9 +1093,40 @@ class TestRunner {
     uint16_t mSkippedCount = 0;
     uint16_t mExpiredCount = 0;
     uint16_t mStatusErrorCount = 0;
-    TimeoutType mTimeout = kTimeoutDefault;
-    std::chrono::time_point<std::chrono::high_resolution_clock> mStartTime;
-    std::chrono::time_point<std::chrono::high_resolution_clock> mEndTime;
+    uint16_t mTestTimeoutCount = 0;
+    uint16_t mMaxFailures = 0;
+    uint16_t mShardIndex = 0;
+    uint16_t mShardCount = 0;
+    // Set once the limit of setMaxFailures() is reached.
+    bool mIsSkippingRemaining = false;
+    // The iterations of setRepeat() and setUntilFail().
+    uint16_t mRepeatCount = 0;
+    bool mIsUntilFail = false;
+    unsigned long mIterationCount = 0;
+    unsigned long mFailedIterationCount = 0;
+    unsigned long mRepeatStartTime = 0;
+    // The tests taken out of the list, in the order in which they finished.
+    Test* mDone = nullptr;
+    Test** mDoneTail = &mDone;
+    unsigned long mTimeoutMillis = kTimeoutDefault * 1000UL;
+  #if EPOXY_DUINO
+    uint8_t mParallelism = 0;
+    bool mIsIsolated = false;
+    unsigned long mKillTimeoutMillis = kKillTimeoutDefault * 1000UL;
+    bool mIsServing = false;
+    // The tests of each run, in the order saved by saveRunOrder().
+    std::vector<Test*> mRunTests;
+    // Whether each test of mRunTests is excluded at the start of a run of
+    // serve().
+    std::vector<bool> mServeExcluded;
+  #endif
+    unsigned long mStartTime = 0;
+    unsigned long mEndTime = 0;
+  #if AUNIT_ENABLE_TIMING
+    // Sorted by decreasing Test::Timing::totalMicros().
+    Test* mSlowest[kMaxSlowestTests] = {};
+    uint8_t mNumSlowest = 0;
+  #endif
 };
 
 }
@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print
+#include "TestTable.h"
+
+namespace aunit {
+
+void TestTable::loop() {
+  mNumFailedRows = 0;
+  uint16_t numSkippedRows = 0;
+  for (uint16_t i = 0; i < mNumRows; i++) {
+    runRow(i);
+
+    Status status = getStatus();
+    if (status == Status::Failed || status == Status::Expired) {
+      mNumFailedRows++;
+      if (isVerbosity(Verbosity::kAssertionFailed)) {
+        printRowMessage(i, " failed.");
+      }
+    } else if (status == Status::Skipped) {
+      numSkippedRows++;
+      if (isVerbosity(Verbosity::kTestSkipped)) {
+        printRowMessage(i, " skipped.");
+      }
+    } else if (isVerbosity(Verbosity::kAssertionPassed)) {
+      printRowMessage(i, " passed.");
+    }
+
+    // Clear the status of the row, so that the assertions of the next row are
+    // not bypassed by the early bailout of isDone().
+    setStatus(Status::Unknown);
+  }
+
+  if (mNumFailedRows > 0) {
+    fail();
+  } else if (mNumRows > 0 && numSkippedRows == mNumRows) {
+    skip();
+  } else {
+    pass();
+  }
+}
+
+void TestTable::printRowMessage(uint16_t index, const char* result) const {
+  // Don't use F() strings here, same reason as in Assertion.cpp.
+  Print* printer = beginMessage();
+  printer->print("Test ");
+  getName().print(printer);
+  printer->print(" row ");
+  printer->print(index);
+  printer->println(result);
+  endMessage();
+}
+
+}
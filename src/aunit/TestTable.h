@@ -0,0 +1,82 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_TEST_TABLE_H
+#define AUNIT_TEST_TABLE_H
+
+#include <stdint.h>
+#include "MetaAssertion.h"
+
+namespace aunit {
+
+/**
+ * A test which runs the same test body on each row of a table, created by the
+ * testTable() macro. All the rows share a single Test instance and a single
+ * class, instead of one class with its own v-table and static instance per
+ * case, which is much cheaper in flash and static memory for large tables of
+ * test vectors.
+ *
+ * The rows are run in order, all within one call to loop(). Each row is
+ * reported as its own sub-result: a row which fails (or calls failTestNow())
+ * prints "Test name row N failed." after its assertion message, and the
+ * remaining rows are still run. The test fails if any row failed, is skipped
+ * if every row was skipped, and passes otherwise. The filters of the TestRunner select the whole table by its
+ * name.
+ */
+class TestTable: public MetaAssertion {
+  public:
+    /** Run all the rows, then set the status of the test. */
+    void loop() override;
+
+    /** Return the number of rows of the table. */
+    uint16_t getNumRows() const { return mNumRows; }
+
+    /** Return the number of rows which failed in loop(). */
+    uint16_t getNumFailedRows() const { return mNumFailedRows; }
+
+  protected:
+    /** Constructor. */
+    explicit TestTable(uint16_t numRows) : mNumRows(numRows) {}
+
+    /**
+     * Copy the row at 'index' from flash into RAM, and run the test body on
+     * it. Generated by the testTable() macro.
+     */
+    virtual void runRow(uint16_t index) = 0;
+
+  private:
+    // Disable copy-constructor and assignment operator
+    TestTable(const TestTable&) = delete;
+    TestTable& operator=(const TestTable&) = delete;
+
+    /** Print the message "Test name row N {result}." */
+    void printRowMessage(uint16_t index, const char* result) const;
+
+    uint16_t mNumRows;
+    uint16_t mNumFailedRows = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,262 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print, F()
+#include "Printer.h"
+#include "Test.h"
+#include "print_util.h"
+#include "TextReporter.h"
+
+namespace aunit {
+
+using internal::printSeconds;
+
+namespace {
+
+bool hasVerbosity(Verbosity flags, Verbosity verbosity) {
+  return (flags & verbosity) != Verbosity::kNone;
+}
+
+}
+
+// Use a function static to avoid the static initialization ordering problem.
+TextReporter* TextReporter::getDefault() {
+  static TextReporter textReporter;
+  return &textReporter;
+}
+
+void TextReporter::beginRun(uint16_t numTests, Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestRunSummary)) return;
+
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("TestRunner started on "));
+  printer->print(numTests);
+  printer->println(F(" test(s)."));
+}
+
+Print* TextReporter::beginMessage(const Test* /*test*/) {
+  return Printer::getBufferedPrinter();
+}
+
+void TextReporter::endTest(const Test& test, Verbosity verbosity) {
+  printStatus(test, verbosity);
+#if AUNIT_ENABLE_TIMING
+  printTiming(test, verbosity);
+#endif
+#if AUNIT_ENABLE_HEAP_TRACKING
+  printHeapUsage(test, verbosity);
+#endif
+#if AUNIT_ENABLE_STACK_TRACKING
+  printStackUsage(test, verbosity);
+#endif
+}
+
+// The status strings are in flash memory, and the ANSI color codes are
+// printed separately so that they can be turned off.
+void TextReporter::printStatus(const Test& test, Verbosity verbosity) const {
+  if (!hasVerbosity(verbosity, Verbosity::kTestAll)) return;
+
+  const __FlashStringHelper* result = nullptr;
+  const __FlashStringHelper* color = nullptr;
+  switch (test.getStatus()) {
+    case Test::Status::Passed:
+      if (hasVerbosity(verbosity, Verbosity::kTestPassed)) {
+        result = F(" passed");
+        color = F("\033[32m");
+      }
+      break;
+    case Test::Status::Failed:
+      if (hasVerbosity(verbosity, Verbosity::kTestFailed)) {
+        result = F(" failed");
+        color = F("\033[31m");
+      }
+      break;
+    case Test::Status::Skipped:
+      if (hasVerbosity(verbosity, Verbosity::kTestSkipped)) {
+        result = F(" skipped");
+      }
+      break;
+    case Test::Status::Expired:
+      if (hasVerbosity(verbosity, Verbosity::kTestExpired)) {
+        result = F(" failed");
+        color = F("\033[33m");
+      }
+      break;
+    case Test::Status::Unknown:
+      break;
+  }
+  if (result == nullptr) return;
+
+  Print* printer = Printer::getBufferedPrinter();
+  int spc = Test::getDisplayMinPosition() - test.getName().length() + 1;
+  while (spc > 0) {
+    printer->print(' ');
+    spc--;
+  }
+  test.getName().print(printer);
+  if (mIsColor && color) printer->print(color);
+  printer->print(result);
+  if (mIsColor && color) printer->print(F("\033[37m"));
+  printer->println('.');
+}
+
+#if AUNIT_ENABLE_TIMING
+
+// The durations are printed in milliseconds with 3 decimals.
+void TextReporter::printTiming(const Test& test, Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestTiming)) return;
+  if (!test.isStarted()) return;
+
+  const Test::Timing& timing = test.getTiming();
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("    timing: "));
+  printSeconds(printer, timing.totalMicros());
+  printer->print(F(" ms (setup "));
+  printSeconds(printer, timing.setupMicros);
+  printer->print(F(", "));
+  printer->print(timing.loopCount);
+  printer->print(F(" loop(s) "));
+  printSeconds(printer, timing.loopMicros);
+  printer->print(F(", teardown "));
+  printSeconds(printer, timing.teardownMicros);
+  printer->println(')');
+}
+
+#endif
+
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+void TextReporter::printHeapUsage(const Test& test, Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestTiming)) return;
+  if (!test.isStarted()) return;
+
+  const Test::HeapUsage& usage = test.getHeapUsage();
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("    heap: "));
+  printer->print(usage.allocCount);
+  printer->print(F(" allocation(s) of "));
+  printer->print(usage.allocBytes);
+  printer->print(F(" bytes, peak "));
+  printer->print(usage.peakBytes);
+  printer->print(F(" bytes, in use "));
+  printer->print(usage.inUseBytes);
+  printer->println(F(" bytes"));
+}
+
+#endif
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+void TextReporter::printStackUsage(const Test& test, Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestTiming)) return;
+  if (!test.isStarted()) return;
+
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("    stack: "));
+  printer->print(test.getStackUsage());
+  printer->println(F(" bytes"));
+}
+
+#endif
+
+void TextReporter::endRun(const RunSummary& summary, Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestRunSummary)) return;
+  Print* printer = Printer::getBufferedPrinter();
+
+  printer->print(F("TestRunner duration: "));
+  printSeconds(printer, summary.durationMillis);
+  printer->println(F(" seconds."));
+
+  printer->print(F("TestRunner summary: "));
+  printer->print(summary.passedCount);
+  printer->print(F(" passed, "));
+  printer->print(summary.failedCount);
+  printer->print(F(" failed, "));
+  printer->print(summary.skippedCount);
+  printer->print(F(" skipped, "));
+  printer->print(summary.expiredCount);
+  printer->print(F(" timed out, out of "));
+  printer->print(summary.count);
+  printer->println(F(" test(s)."));
+
+  // Reported on a separate line to keep the summary line above unchanged.
+  if (summary.testTimeoutCount > 0) {
+    printer->print(F("TestRunner per-test timeouts: "));
+    printer->print(summary.testTimeoutCount);
+    printer->println(F(" test(s) exceeded their own timeout."));
+  }
+
+#if AUNIT_ENABLE_TIMING
+  if (!hasVerbosity(verbosity, Verbosity::kTestTiming)) return;
+  if (summary.numSlowest == 0) return;
+
+  printer->println(F("TestRunner slowest test(s):"));
+  for (uint8_t i = 0; i < summary.numSlowest; i++) {
+    const Test* test = summary.slowest[i];
+    printer->print(F("    "));
+    printSeconds(printer, test->getTiming().totalMicros());
+    printer->print(F(" ms "));
+    test->getName().println(printer);
+  }
+#endif
+}
+
+void TextReporter::endRepeat(const RepeatSummary& summary,
+    Verbosity verbosity) {
+  if (!hasVerbosity(verbosity, Verbosity::kTestRunSummary)) return;
+  Print* printer = Printer::getBufferedPrinter();
+
+  printer->print(F("TestRunner repeat duration: "));
+  printSeconds(printer, summary.durationMillis);
+  printer->println(F(" seconds."));
+
+  printer->print(F("TestRunner repeat summary: "));
+  printer->print(summary.iterationCount - summary.failedIterationCount);
+  printer->print(F(" passed, "));
+  printer->print(summary.failedIterationCount);
+  printer->print(F(" failed, out of "));
+  printer->print(summary.iterationCount);
+  printer->println(F(" iteration(s)."));
+
+#if AUNIT_ENABLE_REPEAT_STATS
+  // Only the tests which failed at least once, flaky or not.
+  bool isHeaderPrinted = false;
+  for (Test* test = summary.tests; test != nullptr; test = *test->getNext()) {
+    const Test::RepeatStats& stats = test->getRepeatStats();
+    if (stats.failedCount == 0) continue;
+    if (!isHeaderPrinted) {
+      printer->println(F("TestRunner failed test(s):"));
+      isHeaderPrinted = true;
+    }
+    printer->print(F("    "));
+    printer->print(stats.failedCount);
+    printer->print(F(" failed, "));
+    printer->print(stats.passedCount);
+    printer->print(F(" passed "));
+    test->getName().println(printer);
+  }
+#endif
+}
+
+}
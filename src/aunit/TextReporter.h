@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_TEXT_REPORTER_H
+#define AUNIT_TEXT_REPORTER_H
+
+#include "Reporter.h"
+
+namespace aunit {
+
+/**
+ * The default Reporter, which prints human-readable messages like
+ * "TestRunner started on 4 test(s).", "  name passed." and the "TestRunner
+ * summary: ..." line, as selected by the Verbosity. The status of each test
+ * can be highlighted with ANSI color escape sequences, which is enabled by
+ * default.
+ */
+class TextReporter: public Reporter {
+  public:
+    /**
+     * Return the TextReporter used when no other Reporter has been set by
+     * TestRunner::setReporter().
+     */
+    static TextReporter* getDefault();
+
+    /** Constructor. */
+    explicit TextReporter(bool isColor = true):
+        mIsColor(isColor) {}
+
+    /** Enable or disable the ANSI colors. */
+    void setColor(bool isColor) { mIsColor = isColor; }
+
+    /** Return true if the ANSI colors are enabled. */
+    bool isColor() const { return mIsColor; }
+
+    void beginRun(uint16_t numTests, Verbosity verbosity) override;
+
+    Print* beginMessage(const Test* test) override;
+
+    void endTest(const Test& test, Verbosity verbosity) override;
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override;
+
+    void endRepeat(const RepeatSummary& summary, Verbosity verbosity)
+        override;
+
+  private:
+    /** Print the "name passed." line of the test. */
+    void printStatus(const Test& test, Verbosity verbosity) const;
+
+  #if AUNIT_ENABLE_TIMING
+    /** Print the timing of the test, if Verbosity::kTestTiming is enabled. */
+    static void printTiming(const Test& test, Verbosity verbosity);
+  #endif
+
+  #if AUNIT_ENABLE_HEAP_TRACKING
+    /**
+     * Print the heap usage of the test, if Verbosity::kTestTiming is enabled.
+     */
+    static void printHeapUsage(const Test& test, Verbosity verbosity);
+  #endif
+
+  #if AUNIT_ENABLE_STACK_TRACKING
+    /**
+     * Print the stack usage of the test, if Verbosity::kTestTiming is enabled.
+     */
+    static void printStackUsage(const Test& test, Verbosity verbosity);
+  #endif
+
+    bool mIsColor;
+};
+
+}
+
+#endif
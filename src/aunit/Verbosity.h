@@ -57,6 +57,14 @@ namespace aunit {
     /** Print TestRunner summary message. */
     kTestRunSummary = 0x40,
 
+    /**
+     * Print the time spent in each test, and the slowest tests at the end.
+     * Requires AUNIT_ENABLE_TIMING. Also prints the heap and the stack usage
+     * of each test if AUNIT_ENABLE_HEAP_TRACKING and
+     * AUNIT_ENABLE_STACK_TRACKING are set.
+     */
+    kTestTiming = 0x80,
+
     // compound flags
     /** Print all assertXxx() messages. */
     kAssertionAll = (kAssertionPassed | kAssertionFailed),
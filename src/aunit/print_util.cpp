@@ -0,0 +1,132 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Arduino.h> // Print
+#include <string.h> // memset()
+#include "Config.h"
+#include "Reporter.h"
+#include "print_util.h"
+#if EPOXY_DUINO
+  #include <mutex>
+#endif
+
+namespace aunit {
+namespace internal {
+
+namespace {
+
+// The file names seen so far. The id of a file is its index plus 1. All the
+// assertions of a source file pass the same __FILE__ literal, which the
+// compiler stores only once, so the files are compared by address.
+const char* fileTable[AUNIT_FILE_TABLE_SIZE];
+uint8_t numFiles = 0;
+#if EPOXY_DUINO
+  std::mutex fileTableMutex;
+#endif
+
+// One bit per id, set when its path has been printed in the current block of
+// output of this thread. See resetPrintedFiles().
+AUNIT_THREAD_LOCAL uint8_t printedFiles[(AUNIT_FILE_TABLE_SIZE + 7) / 8];
+
+/** Return the id of the 'file', adding it to the table if needed. */
+uint8_t findFile(const char* file) {
+#if EPOXY_DUINO
+  std::lock_guard<std::mutex> lock(fileTableMutex);
+#endif
+  for (uint8_t i = 0; i < numFiles; i++) {
+    if (fileTable[i] == file) return i + 1;
+  }
+  if (numFiles >= AUNIT_FILE_TABLE_SIZE) return 0;
+  fileTable[numFiles++] = file;
+  return numFiles;
+}
+
+}
+
+uint8_t internFile(const char* file, bool& isNew) {
+  isNew = false;
+  uint8_t id = findFile(file);
+  if (id == 0) return 0;
+
+  uint8_t& bits = printedFiles[(id - 1) / 8];
+  uint8_t mask = 1 << ((id - 1) % 8);
+  if ((bits & mask) == 0) {
+    bits |= mask;
+    isNew = true;
+  }
+  return id;
+}
+
+void resetPrintedFiles() {
+  memset(printedFiles, 0, sizeof(printedFiles));
+}
+
+void printLocation(Print* printer, const char* file, uint16_t line) {
+  Reporter::getReporter()->printLocation(printer, file, line);
+}
+
+void printTextLocation(Print* printer, const char* file, uint16_t line) {
+#if AUNIT_INTERN_FILE_NAMES
+  bool isNew;
+  uint8_t id = internFile(file, isNew);
+  if (id == 0) {
+    printer->print(file);
+  } else {
+    // Printed again in each block, so that the block can be read on its own.
+    if (isNew) {
+      printer->print(F("TestRunner file "));
+      printer->print(id);
+      printer->print(F(": "));
+      printer->println(file);
+    }
+    printer->print('#');
+    printer->print(id);
+  }
+#else
+  printer->print(file);
+#endif
+  printer->print(':');
+  printer->print(line);
+  printer->print(F(": "));
+}
+
+void printPathLocation(Print* printer, const char* file, uint16_t line) {
+  printer->print(file);
+  printer->print(':');
+  printer->print(line);
+  printer->print(F(": "));
+}
+
+void printSeconds(Print* printer, unsigned long value) {
+  unsigned long s = value / 1000;
+  int ms = value % 1000;
+  printer->print(s);
+  printer->print('.');
+  if (ms < 100) printer->print('0');
+  if (ms < 10) printer->print('0');
+  printer->print(ms);
+}
+
+}
+}
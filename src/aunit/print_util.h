@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef AUNIT_PRINT_UTIL_H
+#define AUNIT_PRINT_UTIL_H
+
+/**
+ * @file print_util.h
+ *
+ * Formatting helpers shared by the TestRunner and the Reporters.
+ */
+
+#include <stdint.h>
+
+class Print;
+
+namespace aunit {
+namespace internal {
+
+/**
+ * Print the 'value' in thousandths as a decimal number with 3 fractional
+ * digits, without using floating point math. For example, a duration in
+ * millis is printed in seconds, and a duration in micros is printed in
+ * millis. This is the equivalent of 'printer->print((float) value / 1000)',
+ * but saves 1400-1600 bytes of flash memory and 12 bytes of static memory.
+ */
+void printSeconds(Print* printer, unsigned long value);
+
+/**
+ * Print the location prefix of an assertion message to the 'printer'
+ * returned by Reporter::beginMessage(), using the Reporter::printLocation()
+ * of the current reporter.
+ */
+void printLocation(Print* printer, const char* file, uint16_t line);
+
+/**
+ * Print the "{file}:{line}: " prefix of an assertion message. If
+ * AUNIT_INTERN_FILE_NAMES is enabled, the file is replaced by its small id,
+ * as in "#1:{line}: ", and the "TestRunner file 1: {file}" line which maps
+ * the id to the file is printed before the first message of the current
+ * block which uses it (see resetPrintedFiles()).
+ */
+void printTextLocation(Print* printer, const char* file, uint16_t line);
+
+/**
+ * Print the "{file}:{line}: " prefix of an assertion message with the full
+ * path of the file, even if AUNIT_INTERN_FILE_NAMES is enabled. Used by the
+ * reporters which capture each message on its own.
+ */
+void printPathLocation(Print* printer, const char* file, uint16_t line);
+
+/**
+ * Return the small id (starting at 1) of the 'file', or 0 if the table of
+ * AUNIT_FILE_TABLE_SIZE files is full. Set 'isNew' if the path of the id has
+ * not been printed yet in the current block of output of this thread, and
+ * mark it as printed. The 'file' is a __FILE__ literal, compared by address.
+ */
+uint8_t internFile(const char* file, bool& isNew);
+
+/**
+ * Start a new block of output on this thread, in which the path of each id
+ * is printed again by its first use. The ids are assigned by each process,
+ * and the output of each test may be buffered and reordered under --jobs, or
+ * printed by a different process under --isolate, so each block of output
+ * must define the ids that it uses. Called by the TestRunner before the
+ * setup() of each test, and by the BinaryReporter for each block of records.
+ */
+void resetPrintedFiles();
+
+}
+}
+
+#endif
@@ -330,6 +330,30 @@ testing(fixture_slow_skip_monitor) {
   }
 }
 
+// -------------------------------------------------------------------------
+// Test TestRunner::find(), which looks up the tests by name at runtime, even
+// after they have finished.
+// -------------------------------------------------------------------------
+
+testing(find_monitor) {
+  Test* external = TestRunner::find("external");
+  Test* suiteExternal = TestRunner::find(F("MyTestSuite_external"));
+  Test* fixture = TestRunner::find("CustomAgainFixture_fixture_slow_pass");
+  assertTrue(external == &test_external_instance);
+  assertTrue(suiteExternal == &MyTestSuite_external_instance);
+  assertTrue(fixture == &CustomAgainFixture_fixture_slow_pass_instance);
+  assertTrue(TestRunner::find("find_monitor") == this);
+  assertTrue(TestRunner::find("no_such_test") == nullptr);
+  assertTrue(TestRunner::find("externa") == nullptr);
+  assertTrue(TestRunner::find("external_") == nullptr);
+
+  if (fixture->isNotDone()) return;
+  assertTrue(external->isPassed());
+  assertTrue(suiteExternal->isPassed());
+  assertTrue(fixture->isPassed());
+  pass();
+}
+
 #endif
 
 // ------------------------------------------------------
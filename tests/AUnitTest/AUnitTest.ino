@@ -182,6 +182,63 @@ test(FCStringTest, hasSubstring) {
   assertFalse(f.hasSubstring("dc"));
 }
 
+test(FCStringTest, lengthAndHash) {
+  FCString n;
+  FCString a("abc");
+  FCString fa(F("abc"));
+  FCString fb(F("abd"));
+
+  assertEqual((size_t) 0, n.length());
+  assertEqual((size_t) 3, a.length());
+  assertEqual((size_t) 3, fa.length());
+
+  assertEqual(FCString("").getHash(), n.getHash());
+  assertEqual(a.getHash(), fa.getHash());
+  assertEqual(a.getHash(), FCString::hash("abc", 3));
+  assertEqual(a.getHash(), FCString::hash("c", 1, FCString::hash("ab", 2)));
+  assertNotEqual(a.getHash(), fb.getHash());
+}
+
+test(FCStringTest, equals) {
+  FCString n;
+  FCString a("abc");
+  FCString fa(F("abc"));
+  FCString fb(F("abd"));
+  FCString fab(F("ab"));
+
+  assertTrue(n.equals(FCString()));
+  assertFalse(n.equals(FCString("")));
+  assertTrue(a.equals(fa));
+  assertTrue(fa.equals(a));
+  assertFalse(a.equals(fb));
+  assertFalse(a.equals(fab));
+  assertFalse(n.equals(a));
+}
+
+#if defined(EPOXY_DUINO)
+
+// Longer than the cached length of AUNIT_ENABLE_NAME_CACHE, which saturates.
+static const size_t kLongLength = 70000;
+static char longA[kLongLength + 1];
+static char longB[kLongLength + 1];
+static char longC[kLongLength + 1];
+
+test(FCStringTest, longString) {
+  memset(longA, 'x', kLongLength);
+  memset(longB, 'x', kLongLength);
+  memset(longC, 'x', kLongLength);
+  longC[kLongLength - 1] = 'y';
+  FCString a(longA);
+  FCString b(longB);
+  FCString c(longC);
+
+  assertEqual(kLongLength, a.length());
+  assertTrue(a.equals(b));
+  assertFalse(a.equals(c));
+}
+
+#endif
+
 // ------------------------------------------------------
 // Test the various assertXxx() macros.
 // ------------------------------------------------------
@@ -0,0 +1,241 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify assertArrayEqual(), assertMemEqual(), assertAllNear() and
+ * assertStreamEqual(), and the findMismatch() and findNotNear() functions
+ * which locate the first mismatch. The messages of the failed array and stream
+ * assertions are shown in FailingTest.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+using aunit::internal::findMismatch;
+using aunit::internal::findNotNear;
+
+#if defined(ARDUINO_ARCH_AVR)
+static const size_t kLargeSize = 500;
+#else
+static const size_t kLargeSize = 10000;
+#endif
+static uint8_t largeA[kLargeSize];
+static uint8_t largeB[kLargeSize];
+
+test(assertArrayEqual_integers) {
+  const uint8_t a8[] = {1, 2, 3, 4};
+  const uint8_t b8[] = {1, 2, 3, 4};
+  assertArrayEqual(a8, b8, 4);
+
+  const int16_t a16[] = {-1, 2, -3, 4};
+  const int16_t b16[] = {-1, 2, -3, 4};
+  assertArrayEqual(a16, b16, 4);
+
+  const int32_t a32[] = {-100000, 2, 300000};
+  const int32_t b32[] = {-100000, 2, 300000};
+  assertArrayEqual(a32, b32, 3);
+
+  const uint64_t a64[] = {1, 0x123456789abcdefULL};
+  const uint64_t b64[] = {1, 0x123456789abcdefULL};
+  assertArrayEqual(a64, b64, 2);
+
+  // Only the first n elements are compared.
+  const char s[] = "abcdef";
+  const char t[] = "abcxyz";
+  assertArrayEqual(s, t, 3);
+}
+
+test(assertArrayEqual_floats) {
+  const float af[] = {1.0, -0.0, 3.5};
+  const float bf[] = {1.0, 0.0, 3.5};
+  assertArrayEqual(af, bf, 3);
+
+  const double ad[] = {1.0, 2.0, 1e100};
+  const double bd[] = {1.0, 2.0, 1e100};
+  assertArrayEqual(ad, bd, 3);
+}
+
+test(assertMemEqual) {
+  for (size_t i = 0; i < kLargeSize; i++) {
+    largeA[i] = largeB[i] = (uint8_t) i;
+  }
+  assertMemEqual(largeA, largeB, kLargeSize);
+  assertMemEqual(largeA, largeB, 0);
+}
+
+test(assertAllNear) {
+  const float af[] = {1.0, 2.0, 3.0};
+  const float bf[] = {1.01, 1.99, 3.0};
+  assertAllNear(af, bf, 3, 0.02);
+
+  const double ad[] = {1.0, 2.0, 3.0};
+  const double bd[] = {1.001, 1.999, 3.0};
+  assertAllNear(ad, bd, 3, 0.002);
+}
+
+test(findMismatch_bytes) {
+  for (size_t i = 0; i < kLargeSize; i++) {
+    largeA[i] = largeB[i] = (uint8_t) i;
+  }
+  assertEqual(kLargeSize, findMismatch(largeA, largeB, kLargeSize));
+
+  // Mismatches in the first block, in the middle, and in the partial last
+  // block.
+  const size_t offsets[] = {0, 63, 64, kLargeSize / 2, kLargeSize - 1};
+  for (size_t offset : offsets) {
+    largeB[offset]++;
+    assertEqual(offset, findMismatch(largeA, largeB, kLargeSize));
+    largeB[offset]--;
+  }
+
+  // The first of several mismatches.
+  largeB[kLargeSize / 4]++;
+  largeB[kLargeSize / 2]++;
+  assertEqual(kLargeSize / 4, findMismatch(largeA, largeB, kLargeSize));
+}
+
+test(findMismatch_floats) {
+  float a[80];
+  float b[80];
+  for (size_t i = 0; i < 80; i++) {
+    a[i] = b[i] = i;
+  }
+  assertEqual((size_t) 80, findMismatch(a, b, 80));
+
+  b[70] = 0.5;
+  assertEqual((size_t) 70, findMismatch(a, b, 80));
+
+  // NaN is never equal to itself.
+  a[40] = b[40] = NAN;
+  assertEqual((size_t) 40, findMismatch(a, b, 80));
+}
+
+test(findNotNear) {
+  double a[80];
+  double b[80];
+  for (size_t i = 0; i < 80; i++) {
+    a[i] = i;
+    b[i] = i + 0.1;
+  }
+  assertEqual((size_t) 80, findNotNear(a, b, 80, 0.2));
+  assertEqual((size_t) 0, findNotNear(a, b, 80, 0.05));
+
+  b[79] = 100.0;
+  assertEqual((size_t) 79, findNotNear(a, b, 80, 0.2));
+}
+
+// -------------------------------------------------------------------------
+// assertStreamEqual()
+// -------------------------------------------------------------------------
+
+static const uint8_t kGolden[] PROGMEM = {
+  0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+  0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+  0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+};
+
+// Produces 'remaining' bytes of a pseudo random sequence, at most 'maxRead'
+// bytes per call, to exercise the short reads of a ByteSource.
+struct Generator {
+  uint32_t state;
+  size_t remaining;
+  size_t maxRead;
+};
+
+static size_t generate(void* context, uint8_t* buffer, size_t size) {
+  Generator* g = (Generator*) context;
+  if (size > g->remaining) size = g->remaining;
+  if (size > g->maxRead) size = g->maxRead;
+  for (size_t i = 0; i < size; i++) {
+    g->state = g->state * 1103515245 + 12345;
+    buffer[i] = g->state >> 16;
+  }
+  g->remaining -= size;
+  return size;
+}
+
+test(assertStreamEqual_flash) {
+  uint8_t output[sizeof(kGolden)];
+  memcpy_P(output, kGolden, sizeof(kGolden));
+  FlashSource expected(AUNIT_FPSTR(kGolden), sizeof(kGolden));
+  MemorySource actual(output, sizeof(output));
+  assertStreamEqual(expected, actual);
+}
+
+test(assertStreamEqual_callback) {
+#if defined(ARDUINO_ARCH_AVR)
+  const size_t size = 2000;
+#else
+  const size_t size = 1000000;
+#endif
+  Generator g1 = {1, size, 1000};
+  Generator g2 = {1, size, 7};
+  CallbackSource expected(generate, &g1);
+  CallbackSource actual(generate, &g2);
+  assertStreamEqual(expected, actual);
+  assertEqual((size_t) 0, g1.remaining);
+  assertEqual((size_t) 0, g2.remaining);
+}
+
+test(assertStreamEqual_empty) {
+  MemorySource expected(nullptr, 0);
+  MemorySource actual(nullptr, 0);
+  assertStreamEqual(expected, actual);
+}
+
+#if EPOXY_DUINO
+
+test(assertStreamEqual_file) {
+  const char* fileName = "/tmp/ArrayAssertTest.bin";
+  FILE* f = fopen(fileName, "wb");
+  assertTrue(f != nullptr);
+  fwrite(kGolden, 1, sizeof(kGolden), f);
+  fclose(f);
+
+  FileSource expected(fileName);
+  assertTrue(expected.isOpen());
+  assertEqual(sizeof(kGolden), expected.size());
+  MemorySource actual(kGolden, sizeof(kGolden));
+  assertStreamEqual(expected, actual);
+  remove(fileName);
+
+  FileSource missing("/nonexistent/ArrayAssertTest.bin");
+  assertFalse(missing.isOpen());
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    11 passed, 0 failed, 0 skipped, 0 timed out, out of 11 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,148 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify asyncTest(), asyncTestF(), AUNIT_AWAIT() and AUNIT_SLEEP().
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+// The flag is set by Flag_set, and awaited by Flag_await, which interleave.
+// The suite keeps them in the same process with --isolate.
+class Flag: public AsyncTest {
+  protected:
+    static void setupSuite() { flag = false; }
+
+    static bool flag;
+};
+
+bool Flag::flag = false;
+
+asyncTestF(Flag, set) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_SLEEP(30);
+  flag = true;
+  AUNIT_ASYNC_END();
+}
+
+asyncTestF(Flag, await) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_AWAIT(flag, 1000);
+  assertTrue(flag);
+  AUNIT_ASYNC_END();
+}
+
+// A condition which is already true does not suspend the test.
+asyncTest(await_immediate) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_AWAIT(true, 10);
+  AUNIT_AWAIT(true, 0);
+  AUNIT_ASYNC_END();
+}
+
+asyncTest(skipped_after_sleep) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_SLEEP(1);
+  skip();
+  AUNIT_ASYNC_END();
+}
+
+// Four tests which sleep for 100 ms each run in about 100 ms in total,
+// instead of 400 ms.
+unsigned long sleepStart = 0;
+
+class Sleeper: public AsyncTest {
+  protected:
+    void setup() override {
+      AsyncTest::setup();
+      if (sleepStart == 0) sleepStart = millis();
+    }
+
+    // The state which survives a suspension must be a member.
+    uint8_t count = 0;
+};
+
+asyncTestF(Sleeper, a) {
+  AUNIT_ASYNC_BEGIN();
+  for (count = 0; count < 4; count++) {
+    AUNIT_SLEEP(25);
+  }
+  assertEqual(4, count);
+  AUNIT_ASYNC_END();
+}
+
+asyncTestF(Sleeper, b) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_SLEEP(100);
+  AUNIT_ASYNC_END();
+}
+
+asyncTestF(Sleeper, c) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_SLEEP(50);
+  AUNIT_SLEEP(50);
+  AUNIT_ASYNC_END();
+}
+
+asyncTestF(Sleeper, d) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_SLEEP(100);
+  AUNIT_ASYNC_END();
+}
+
+// Inspects other tests, so must not run concurrently with them.
+serialTesting(verify_async) {
+  if (checkTestNotDoneF(Sleeper, a)) return;
+  if (checkTestNotDoneF(Sleeper, b)) return;
+  if (checkTestNotDoneF(Sleeper, c)) return;
+  if (checkTestNotDoneF(Sleeper, d)) return;
+  if (checkTestNotDoneF(Flag, await)) return;
+  if (checkTestNotDone(skipped_after_sleep)) return;
+
+  assertLess(millis() - sleepStart, 300UL);
+  assertTestPassF(Flag, await);
+  assertTestPass(await_immediate);
+  assertTestSkip(skipped_after_sleep);
+#if AUNIT_ENABLE_TIMING
+  assertEqual(1UL, test_await_immediate_instance.getTiming().loopCount);
+#endif
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    8 passed, 0 failed, 1 skipped, 0 timed out, out of 9 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,103 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that TestRunner::setBatchMode() executes the tests in the same order
+ * as the default one-step-per-run() scheduler. Each test appends a character
+ * to a log every time its body is executed, and the last test compares the log
+ * with the sequence produced by the default scheduler. Running this test with
+ * the setBatchMode(true) line below commented out must also pass.
+ */
+
+#include <AUnit.h>
+#include <string.h>
+using namespace aunit;
+
+static char eventLog[16];
+static uint8_t eventCount = 0;
+
+static void logEvent(char c) {
+  if (eventCount < sizeof(eventLog) - 1) eventLog[eventCount++] = c;
+}
+
+testing(a_short) {
+  static uint8_t count = 0;
+  logEvent('a');
+  if (++count == 3) pass();
+}
+
+testing(b_long) {
+  static uint8_t count = 0;
+  logEvent('b');
+  if (++count == 5) pass();
+}
+
+test(c_once) {
+  logEvent('c');
+}
+
+class CustomOnce: public TestOnce {
+  protected:
+    void setup() override {
+      TestOnce::setup();
+      logEvent('s');
+    }
+
+    void teardown() override {
+      logEvent('t');
+      TestOnce::teardown();
+    }
+};
+
+testF(CustomOnce, d_fixture) {
+  logEvent('d');
+}
+
+test(e_skipped) {
+  logEvent('e');
+  skip();
+}
+
+testing(z_verify) {
+  if (checkTestNotDone(a_short) || checkTestNotDone(b_long)) return;
+  assertEqual("sdtabceababbb", (const char*) eventLog);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setBatchMode(true);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    5 passed, 0 failed, 1 skipped, 0 timed out, out of 6 test(s).
+  TestRunner::run();
+}
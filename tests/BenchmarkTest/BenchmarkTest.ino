@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify the statistics computed by benchmark() and benchmarkF(), that
+ * benchmarks are filtered like other tests, and that the benchmark assertions
+ * pass against the compiled-in baselines.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+static volatile uint32_t counter = 0;
+
+benchmark(increment) {
+  counter++;
+}
+
+benchmark(delay, micros20) {
+  delayMicroseconds(20);
+}
+
+class SumFixture: public Benchmark {
+  protected:
+    void setup() override {
+      Benchmark::setup();
+      for (uint8_t i = 0; i < sizeof(mValues); i++) mValues[i] = i;
+    }
+
+    uint8_t mValues[16];
+};
+
+benchmarkF(SumFixture, sum) {
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < sizeof(mValues); i++) sum += mValues[i];
+  doNotOptimize(sum);
+}
+
+// A benchmark fixture whose verify() checks the results against generous
+// limits, which should never fail.
+class CheckedFixture: public Benchmark {
+  protected:
+    void verify() override {
+      assertFasterThan((uint32_t) 100000000);
+      assertNoRegression(1000);
+      assertNoRegression("CheckedFixture_other", 10);
+      assertNoRegression("no_such_baseline", 10);
+    }
+};
+
+benchmarkF(CheckedFixture, checked) {
+  counter++;
+}
+
+static const char kCheckedName[] PROGMEM = "CheckedFixture_checked";
+static const char kOtherName[] PROGMEM = "CheckedFixture_other";
+static const BaselineEntry kBaselines[] PROGMEM = {
+  {kCheckedName, 10000},
+  {kOtherName, 10000000},
+};
+
+benchmark(excluded) {
+  counter++;
+}
+
+// Inspects the other benchmarks, so must not run concurrently with them.
+serialTesting(verify_benchmarks) {
+  if (checkTestNotDone(increment)) return;
+  if (checkTestNotDone(delay, micros20)) return;
+  if (checkTestNotDoneF(SumFixture, sum)) return;
+  if (checkTestNotDoneF(CheckedFixture, checked)) return;
+
+  const Benchmark& increment = test_increment_instance;
+  assertMoreOrEqual(increment.getIterations(), (uint32_t) 2);
+  assertLessOrEqual(increment.getMinNanos(), increment.getMedianNanos());
+  assertLessOrEqual(increment.getMedianNanos(), increment.getP99Nanos());
+
+  // Only 1 iteration fits in a sample if the sample duration is less than 20
+  // micros, so do not assert on the number of iterations.
+  const Benchmark& slow = delay_micros20_instance;
+  assertMoreOrEqual(slow.getMinNanos(), (uint32_t) 20000);
+  assertLessOrEqual(slow.getMinNanos(), slow.getMedianNanos());
+  assertLessOrEqual(slow.getMedianNanos(), slow.getP99Nanos());
+
+  const Benchmark& sum = SumFixture_sum_instance;
+  assertMore(sum.getIterations(), (uint32_t) 0);
+  assertLessOrEqual(sum.getMedianNanos(), sum.getP99Nanos());
+
+  assertTestPassF(CheckedFixture, checked);
+  assertTestSkip(excluded);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("excluded");
+  Baselines::setTable(kBaselines, sizeof(kBaselines) / sizeof(kBaselines[0]));
+}
+
+void loop() {
+  // Should get something like:
+  // Benchmark increment: min 2 ns/op, median 2 ns/op, p99 3 ns/op (64 samples
+  // of 524288 iterations)
+  // ...
+  // TestRunner summary:
+  //    5 passed, 0 failed, 1 skipped, 0 timed out, out of 6 test(s).
+  TestRunner::run();
+}
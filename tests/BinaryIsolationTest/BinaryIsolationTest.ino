@@ -0,0 +1,268 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that the stream of the BinaryReporter can be decoded when the tests
+ * run in parallel worker processes, which assign their own ids to the files
+ * and whose blocks of records are interleaved. The stream is captured into a
+ * buffer by the CapturingReporter, and decoded by the serial test which runs
+ * on the main process after the isolated ones. The summary is then printed
+ * as text.
+ */
+
+#include <string.h>
+#include <AUnit.h>
+using namespace aunit;
+
+#if defined(EPOXY_DUINO)
+
+/** A Print which collects the binary stream into a fixed buffer. */
+class BufferPrint: public Print {
+  public:
+    static const uint16_t kBufSize = 2048;
+
+    size_t write(uint8_t c) override {
+      if (mIndex >= kBufSize) {
+        mIsFull = true;
+        return 0;
+      }
+      mBuf[mIndex++] = c;
+      return 1;
+    }
+
+    const uint8_t* getBuffer() const { return mBuf; }
+
+    uint16_t getLength() const { return mIndex; }
+
+    bool isFull() const { return mIsFull; }
+
+  private:
+    uint8_t mBuf[kBufSize] = {};
+    uint16_t mIndex = 0;
+    bool mIsFull = false;
+};
+
+/**
+ * A BinaryReporter whose stream goes to the 'stream' buffer, before the
+ * worker processes are started, and which prints the summary as text.
+ */
+class CapturingReporter: public BinaryReporter {
+  public:
+    void beginRun(uint16_t numTests, Verbosity verbosity) override {
+      savedPrinter = Printer::getPrinter();
+      Printer::setPrinter(&stream);
+      BinaryReporter::beginRun(numTests, verbosity);
+    }
+
+    void endRun(const RunSummary& summary, Verbosity verbosity) override {
+      BinaryReporter::endRun(summary, verbosity);
+      Printer::flush();
+      Printer::setPrinter(savedPrinter);
+      textReporter.endRun(summary, verbosity);
+    }
+
+    Print* savedPrinter = nullptr;
+    BufferPrint stream;
+    TextReporter textReporter;
+};
+
+CapturingReporter reporter;
+
+// Two files with a distinct first letter, used alternately by the tests, so
+// that the worker processes give them different ids.
+const char kFileA[] = "a.cpp";
+const char kFileB[] = "b.cpp";
+
+/**
+ * Send an assertion message located in the 'file', whose text is the first
+ * letter of the file.
+ */
+void printAt(const Test* test, const char* file) {
+  Reporter* r = Reporter::getReporter();
+  Print* printer = r->beginMessage(test);
+  r->printLocation(printer, file, 10);
+  printer->println(file[0]);
+  r->endMessage();
+}
+
+test(t1_a) { printAt(this, kFileA); pass(); }
+test(t2_b) { printAt(this, kFileB); pass(); }
+test(t3_a) { printAt(this, kFileA); pass(); }
+test(t4_b) { printAt(this, kFileB); pass(); }
+test(t5_a) { printAt(this, kFileA); printAt(this, kFileB); pass(); }
+test(t6_b) { printAt(this, kFileB); printAt(this, kFileA); pass(); }
+
+/**
+ * Decodes the records of the captured stream, and checks that each assertion
+ * message refers to an id defined in the same block, whose path matches the
+ * text of the message. The problems are printed directly, since the messages of
+ * the assertions would go to the stream.
+ */
+class StreamChecker {
+  public:
+    StreamChecker(const uint8_t* buf, uint16_t length, Print* printer):
+        mBuf(buf),
+        mLength(length),
+        mPrinter(printer) {}
+
+    /** Return the number of problems found. */
+    uint16_t check() {
+      // Start record: 0x01 'A' 'U' version numTests width.
+      if (mLength < 4 || mBuf[0] != 0x01) return fail(F("no start record"));
+      mIndex = 4;
+      varint();
+      varint();
+
+      while (mIndex < mLength && mErrors == 0) {
+        uint8_t type = mBuf[mIndex++];
+        switch (type) {
+          case 0x02: // test
+            mName = string();
+            memset(mFiles, 0, sizeof(mFiles));
+            break;
+          case 0x03: { // file
+            unsigned long id = varint();
+            const char* path = string();
+            if (id < kMaxIds) mFiles[id] = path;
+            break;
+          }
+          case 0x04: // message
+            string();
+            break;
+          case 0x05: // assertion message
+            located();
+            break;
+          case 0x06: // result
+            result();
+            break;
+          case 0x07: // end
+            return mErrors;
+          default:
+            return fail(F("unknown record"));
+        }
+      }
+      return mErrors;
+    }
+
+    uint16_t getLocatedCount() const { return mLocatedCount; }
+
+  private:
+    static const uint8_t kMaxIds = AUNIT_FILE_TABLE_SIZE + 1;
+
+    uint16_t fail(const __FlashStringHelper* problem) {
+      mPrinter->print(F("BinaryIsolationTest: "));
+      mPrinter->print(problem);
+      mPrinter->print(F(" at offset "));
+      mPrinter->print(mIndex);
+      if (mName) {
+        mPrinter->print(F(" in test "));
+        mPrinter->print(mName);
+      }
+      mPrinter->println();
+      return ++mErrors;
+    }
+
+    unsigned long varint() {
+      unsigned long value = 0;
+      uint8_t shift = 0;
+      while (mIndex < mLength) {
+        uint8_t b = mBuf[mIndex++];
+        value |= (unsigned long) (b & 0x7F) << shift;
+        if (b < 0x80) break;
+        shift += 7;
+      }
+      return value;
+    }
+
+    const char* string() {
+      const char* s = (const char*) mBuf + mIndex;
+      while (mIndex < mLength && mBuf[mIndex] != 0) mIndex++;
+      mIndex++;
+      return s;
+    }
+
+    void located() {
+      unsigned long id = varint();
+      const char* path = (id == 0) ? string()
+          : (id < kMaxIds) ? mFiles[id] : nullptr;
+      varint();
+      const char* text = string();
+      mLocatedCount++;
+
+      if (path == nullptr) {
+        fail(F("file id not defined in its block"));
+      } else if (path[0] != text[0]) {
+        fail(F("wrong file"));
+      }
+    }
+
+    void result() {
+      uint8_t flags = mBuf[mIndex++];
+      if (flags & 0x10) varint();
+      if (flags & 0x20) {
+        for (uint8_t i = 0; i < 4; i++) varint();
+      }
+      if (flags & 0x40) varint();
+    }
+
+    const uint8_t* const mBuf;
+    const uint16_t mLength;
+    Print* const mPrinter;
+    uint16_t mIndex = 0;
+    uint16_t mErrors = 0;
+    uint16_t mLocatedCount = 0;
+    const char* mName = nullptr;
+    const char* mFiles[kMaxIds] = {};
+};
+
+serialTest(z_verify) {
+  assertFalse(reporter.stream.isFull());
+  StreamChecker checker(reporter.stream.getBuffer(),
+      reporter.stream.getLength(), reporter.savedPrinter);
+  assertEqual(0, checker.check());
+  assertEqual(8, checker.getLocatedCount());
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+#if defined(EPOXY_DUINO)
+  TestRunner::setReporter(&reporter);
+  TestRunner::setIsolation(true);
+  TestRunner::setParallelism(2);
+#endif
+}
+
+void loop() {
+  // Should get:
+  // TestRunner summary:
+  //    7 passed, 0 failed, 0 skipped, 0 timed out, out of 7 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,154 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify the line buffering of BufferedPrint, and of the
+ * Printer::getBufferedPrinter() used for the messages of AUnit.
+ */
+
+#include <string.h>
+#include <AUnit.h>
+#include <aunit/BufferedPrint.h>
+using namespace aunit;
+using aunit::internal::BufferedPrint;
+
+/**
+ * A Print which records the characters written to it, and the number of calls
+ * to its write() methods.
+ */
+class CountingPrint: public Print {
+  public:
+    static const uint8_t kBufSize = 64;
+
+    size_t write(uint8_t c) override {
+      mWriteCount++;
+      append(c);
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+      mWriteCount++;
+      for (size_t i = 0; i < size; i++) append(buffer[i]);
+      return size;
+    }
+
+    const char* getBuffer() const { return mBuf; }
+
+    uint8_t getWriteCount() const { return mWriteCount; }
+
+  private:
+    void append(uint8_t c) {
+      if (mIndex >= kBufSize - 1) return;
+      mBuf[mIndex++] = c;
+      mBuf[mIndex] = '\0';
+    }
+
+    char mBuf[kBufSize] = {};
+    uint8_t mIndex = 0;
+    uint8_t mWriteCount = 0;
+};
+
+test(BufferedPrintTest, line_is_written_at_once) {
+  CountingPrint counting;
+  BufferedPrint<16> buffered;
+  buffered.setTarget(&counting);
+
+  buffered.print(F("file.ino:"));
+  buffered.print(42);
+  buffered.print(':');
+  assertEqual(0, counting.getWriteCount());
+  assertEqual("", counting.getBuffer());
+
+  buffered.println();
+  assertEqual(1, counting.getWriteCount());
+  assertEqual("file.ino:42:\r\n", counting.getBuffer());
+}
+
+test(BufferedPrintTest, full_buffer_is_written) {
+  CountingPrint counting;
+  BufferedPrint<8> buffered;
+  buffered.setTarget(&counting);
+
+  buffered.print("0123456789");
+  assertEqual(1, counting.getWriteCount());
+  assertEqual("01234567", counting.getBuffer());
+
+  buffered.flushBuffer();
+  assertEqual(2, counting.getWriteCount());
+  assertEqual("0123456789", counting.getBuffer());
+
+  // Nothing left to write.
+  buffered.flushBuffer();
+  assertEqual(2, counting.getWriteCount());
+}
+
+test(BufferedPrintTest, setTarget_flushes) {
+  CountingPrint first;
+  CountingPrint second;
+  BufferedPrint<16> buffered;
+  buffered.setTarget(&first);
+
+  buffered.print("abc");
+  buffered.setTarget(&second);
+  buffered.print("def");
+  buffered.flushBuffer();
+
+  assertEqual("abc", first.getBuffer());
+  assertEqual("def", second.getBuffer());
+  assertTrue(buffered.getTarget() == &second);
+}
+
+test(PrinterTest, getBufferedPrinter) {
+  Print* saved = Printer::getPrinter();
+  CountingPrint counting;
+  Printer::setPrinter(&counting);
+
+  Print* printer = Printer::getBufferedPrinter();
+  printer->print(F("Assertion "));
+  printer->print(F("passed"));
+  printer->println('.');
+  Printer::flush();
+  Printer::setPrinter(saved);
+
+  assertTrue(Printer::getPrinter() == saved);
+  assertEqual("Assertion passed.\r\n", counting.getBuffer());
+#if AUNIT_PRINTER_BUFFER_SIZE > 0
+  assertEqual(1, counting.getWriteCount());
+#endif
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 0 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify that the life cycle, the status and the flags of the tests behave
+ * the same with the packed layout of AUNIT_COMPACT_TEST, which is enabled by
+ * the Makefile of this test, and pin the size of a Test. The Makefile also
+ * disables the other optional features which add members to Test.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+#if ! AUNIT_COMPACT_TEST
+  #error AUNIT_COMPACT_TEST must be enabled for this test
+#endif
+
+#if AUNIT_ENABLE_NAME_CACHE || AUNIT_ENABLE_TIMING \
+    || AUNIT_ENABLE_HEAP_TRACKING || AUNIT_ENABLE_STACK_TRACKING \
+    || AUNIT_ENABLE_REPEAT_STATS
+  #error The optional members of Test must be disabled for this test
+#endif
+
+// The expected layout of a compact Test: the v-table pointer, the name (a
+// pointer and its flash/RAM type), the byte of bit fields, the verbosity and
+// the next pointer. This is 9 bytes on AVR, 20 bytes on 32-bit processors and
+// 40 bytes on 64-bit processors.
+struct CompactLayout {
+  void* vtable;
+  struct {
+    const char* string;
+    uint8_t type;
+  } name;
+  uint8_t bitFields;
+  uint8_t verbosity;
+  void* next;
+};
+
+static_assert(sizeof(Test) == sizeof(CompactLayout),
+    "Unexpected size of a Test with AUNIT_COMPACT_TEST");
+
+test(pass_test) {}
+
+test(skip_test) { skipTestNow(); }
+
+test(excluded_test) {}
+
+serialTest(serial_test) {}
+
+testing(loop_test) {
+  static int count = 0;
+  if (++count == 3) pass();
+}
+
+// A test which is never registered with init(), used to exercise the bit
+// fields directly.
+class ProbeTest: public TestOnce {
+  public:
+    void once() override {}
+};
+
+test(bit_fields) {
+  ProbeTest probe;
+  assertTrue(probe.getLifeCycle() == Test::LifeCycle::New);
+  assertTrue(probe.getStatus() == Test::Status::Unknown);
+  assertFalse(probe.isStarted());
+  assertFalse(probe.isSerial());
+
+  probe.setStarted();
+  probe.setSerial();
+  probe.setLifeCycle(Test::LifeCycle::Setup);
+  assertTrue(probe.getLifeCycle() == Test::LifeCycle::Setup);
+  assertTrue(probe.isStarted());
+  assertTrue(probe.isSerial());
+
+  probe.expireTestTimeout();
+  assertTrue(probe.getStatus() == Test::Status::Expired);
+  assertTrue(probe.getLifeCycle() == Test::LifeCycle::Asserted);
+  assertTrue(probe.isExpired());
+  assertTrue(probe.isDone());
+  assertTrue(probe.isTestTimeout());
+
+  probe.setLifeCycle(Test::LifeCycle::Finished);
+  assertTrue(probe.getLifeCycle() == Test::LifeCycle::Finished);
+  assertTrue(probe.getStatus() == Test::Status::Expired);
+  assertTrue(probe.isStarted());
+  assertTrue(probe.isSerial());
+
+  probe.setStatus(Test::Status::Failed);
+  assertTrue(probe.isFailed());
+  assertFalse(probe.isTestTimeout());
+}
+
+test(flash_name) {
+  internal::FCString fname(F("flash_name"));
+  internal::FCString cname("flash_name");
+  assertEqual((int) fname.getType(), (int) internal::FCString::kFStringType);
+  assertEqual((int) cname.getType(), (int) internal::FCString::kCStringType);
+  assertEqual((int) fname.length(), 10);
+  assertTrue(fname.equals(cname));
+}
+
+testing(z_verify) {
+  if (checkTestNotDone(loop_test)) return;
+
+  assertTestPass(pass_test);
+  assertTestSkip(skip_test);
+  assertTestSkip(excluded_test);
+  assertTestPass(serial_test);
+  assertTestPass(loop_test);
+  assertTestPass(flash_name);
+  assertTestPass(bit_fields);
+  assertFalse(test_loop_test_instance.isTestTimeout());
+
+  assertTrue(test_serial_test_instance.isSerial());
+  assertFalse(test_pass_test_instance.isSerial());
+  assertTrue(test_pass_test_instance.isStarted());
+  assertFalse(test_excluded_test_instance.isStarted());
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("excluded_test");
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    6 passed, 0 failed, 2 skipped, 0 timed out, out of 8 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,120 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+ * Verify the compile-time filter of AUNIT_INCLUDE_PATTERN and
+ * AUNIT_EXCLUDE_PATTERN, which are defined by the Makefile of this test. The
+ * removed tests fail if they are ever run.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+using aunit::internal::globMatches;
+using aunit::internal::globMatchesAny;
+
+static_assert(globMatches("a*c", "abbc"), "");
+static_assert(globMatches("a?c,x", "abc"), "");
+static_assert(globMatches("*", ""), "");
+static_assert(! globMatches("a*c", "abcd"), "");
+static_assert(! globMatches("a?c", "ac"), "");
+static_assert(globMatchesAny("x*,ab*", "abc"), "");
+static_assert(! globMatchesAny("x*,y", "abc"), "");
+static_assert(! globMatchesAny("", "abc"), "");
+
+test(keep) {}
+
+test(drop) {
+  fail();
+}
+
+test(keep_slow) {
+  fail();
+}
+
+testing(keepTesting) {
+  pass();
+}
+
+benchmark(dropBenchmark) {}
+
+struct Row {
+  int value;
+};
+
+static const Row rows[] PROGMEM = {{1}};
+
+testTable(dropTable, Row, rows) {
+  (void) row;
+  fail();
+}
+
+class Fixture: public TestOnce {};
+
+testF(Fixture, kept) {}
+
+testF(Fixture, kept_slow) {
+  fail();
+}
+
+lazyTestF(Fixture, lazy_slow) {
+  fail();
+}
+
+test(suite, a) {}
+
+test(suite, ab) {
+  fail();
+}
+
+// Sorted after the other tests, which are finished by then.
+test(keep_verify) {
+  assertTrue(TestRunner::find("keep") != nullptr);
+  assertTrue(TestRunner::find("Fixture_kept") != nullptr);
+  assertTrue(TestRunner::find("suite_a") != nullptr);
+  assertTrue(TestRunner::find("drop") == nullptr);
+  assertTrue(TestRunner::find("keep_slow") == nullptr);
+  assertTrue(TestRunner::find("Fixture_lazy_slow") == nullptr);
+  assertTrue(TestRunner::find("suite_ab") == nullptr);
+
+  // The removed tests look like excluded tests to the meta assertions.
+  assertTestPass(keep);
+  assertTestSkip(drop);
+  assertTestSkip(keep_slow);
+  assertTestSkipF(Fixture, kept_slow);
+  assertTestNotExpire(suite, ab);
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    5 passed, 0 failed, 0 skipped, 0 timed out, out of 5 test(s).
+  TestRunner::run();
+}
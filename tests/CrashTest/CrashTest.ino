@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Tests which crash, exit or hang, run in isolated worker processes by
+ * TestRunner::setIsolation(). Only a_pass and z_after_crash should pass, and
+ * the run must not be aborted. Should get something like:
+ *
+ * @verbatim
+ * TestRunner started on 6 test(s).
+ *         a_pass passed.
+ * Test c_exit exited with status 3.
+ *         c_exit failed.
+ * Test b_crash crashed with signal 11 (Segmentation fault).
+ *        b_crash failed.
+ * Test d_abort crashed with signal 6 (Aborted).
+ *        d_abort failed.
+ * Test e_hang killed after 1 seconds.
+ *         e_hang failed.
+ *  z_after_crash passed.
+ * TestRunner duration: 1.001 seconds.
+ * TestRunner summary: 2 passed, 3 failed, 0 skipped, 1 timed out, out of 6 test(s).
+ * TestRunner per-test timeouts: 1 test(s) exceeded their own timeout.
+ * @endverbatim
+ *
+ * The tests are reported in order of completion, so the order may vary.
+ */
+
+#include <AUnit.h>
+#include <stdlib.h> // exit(), abort()
+using namespace aunit;
+
+test(a_pass) {
+  assertTrue(true);
+}
+
+test(b_crash) {
+  volatile int* p = nullptr;
+  *p = 1;
+}
+
+test(c_exit) {
+  exit(3);
+}
+
+test(d_abort) {
+  abort();
+}
+
+testing(e_hang) {
+  while (true) {}
+}
+
+serialTest(z_after_crash) {
+  assertTestFail(b_crash);
+  assertTestExpire(e_hang);
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+#if defined(EPOXY_DUINO)
+  TestRunner::setIsolation(true);
+  TestRunner::setKillTimeout(1);
+  TestRunner::setParallelism(2);
+#endif
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify TestRunner::setMaxFailures(1). The failure of b_fail must skip the
+ * testing() test which is still running, after calling its teardown(), and
+ * the test which has not started yet, without running it. Should get
+ * something like:
+ *
+ * @verbatim
+ * TestRunner started on 3 test(s).
+ * FailFastTest.ino:59: Assertion failed: (1) == (2).
+ *                    b_fail failed.
+ *                   c_never skipped.
+ * RunningFixture_a_running teardown
+ *  RunningFixture_a_running skipped.
+ * TestRunner duration: 0.000 seconds.
+ * TestRunner summary: 0 passed, 1 failed, 2 skipped, 0 timed out, out of 3 test(s).
+ * @endverbatim
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+class RunningFixture: public TestAgain {
+  protected:
+    void teardown() override {
+      SERIAL_PORT_MONITOR.println(F("RunningFixture_a_running teardown"));
+      TestAgain::teardown();
+    }
+};
+
+testingF(RunningFixture, a_running) {
+  // Never resolved by itself.
+}
+
+test(b_fail) {
+  assertEqual(1, 2);
+}
+
+test(c_never) {
+  SERIAL_PORT_MONITOR.println(F("c_never: should not be called"));
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setMaxFailures(1);
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -1,22 +1,24 @@
 #include "ExternalTests.h"
 
-testing(slow_fail) {
+// Serial, like their monitors in FailingTest.ino, so that they run at the same
+// time as the monitors with --jobs and --isolate.
+serialTesting(slow_fail) {
   static unsigned long start = millis();
   if (millis() - start > 1000) fail();
 }
 
-testing(slow_expire) {
+serialTesting(slow_expire) {
   static unsigned long start = millis();
   if (millis() - start > 1000) expire();
 }
 
-testingF(CustomAgainFixture, fixture_slow_fail) {
+serialTestingF(CustomAgainFixture, fixture_slow_fail) {
   static unsigned long start = millis();
   assertCommon(5);
   if (millis() - start > 1000) fail();
 }
 
-testingF(CustomAgainFixture, fixture_slow_expire) {
+serialTestingF(CustomAgainFixture, fixture_slow_expire) {
   static unsigned long start = millis();
   assertCommon(5);
   if (millis() - start > 1000) expire();
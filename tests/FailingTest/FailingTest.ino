@@ -75,9 +75,54 @@ test(verbosity_testFailed_only) {
 }
 
 // -------------------------------------------------------------------------
-// Test 10 timeout global timeout.
+// Test the messages of the array assertions, which print only the first
+// mismatch.
 // -------------------------------------------------------------------------
-testing(timeout_after_10_seconds) {
+
+test(assertArrayEqual_fails) {
+  int16_t expected[20];
+  int16_t actual[20];
+  for (int16_t i = 0; i < 20; i++) {
+    expected[i] = actual[i] = i;
+  }
+  actual[10] = 0x100;
+  actual[15] = 0x200;
+  assertArrayEqual(expected, actual, 20);
+}
+
+test(assertMemEqual_fails) {
+  const char expected[] = "0123456789";
+  const char actual[] = "0123x56789";
+  assertMemEqual(expected, actual, 10);
+}
+
+test(assertAllNear_fails) {
+  float expected[] = {1.0, 2.0, 3.0, 4.0};
+  float actual[] = {1.0, 2.0, 3.5, 4.0};
+  assertAllNear(expected, actual, 4, 0.25);
+}
+
+test(assertStreamEqual_fails) {
+  static const char expected[] PROGMEM = "0123456789abcdef";
+  const char actual[] = "0123456789abcdEF";
+  FlashSource expectedSource(AUNIT_FPSTR(expected), 16);
+  MemorySource actualSource(actual, 16);
+  assertStreamEqual(expectedSource, actualSource);
+}
+
+test(assertStreamEqual_length_fails) {
+  const char data[] = "0123456789";
+  MemorySource expected(data, 10);
+  MemorySource actual(data, 8);
+  assertStreamEqual(expected, actual);
+}
+
+// -------------------------------------------------------------------------
+// Test 10 timeout global timeout. Serial, so that with --jobs and --isolate it
+// runs alongside the monitors below instead of holding back their start
+// until the timeout.
+// -------------------------------------------------------------------------
+serialTesting(timeout_after_10_seconds) {
   static unsigned long startTime  = millis();
 
   // complete the test in 20 seconds.
@@ -89,12 +134,14 @@ testing(timeout_after_10_seconds) {
 
 // -------------------------------------------------------------------------
 // Test externTest() and externTesting() macros and various meta assertions
-// in failing conditions.
+// in failing conditions. The monitors and the tests they watch are serial, so
+// that they still run side by side on the main thread with --jobs and
+// --isolate.
 // -------------------------------------------------------------------------
 
 externTesting(slow_fail);
 
-testing(slow_fail_monitor) {
+serialTesting(slow_fail_monitor) {
   static unsigned long start = millis();
 
   unsigned long now = millis();
@@ -136,7 +183,7 @@ testing(slow_fail_monitor) {
 
 externTesting(slow_expire);
 
-testing(slow_expire_monitor) {
+serialTesting(slow_expire_monitor) {
   static unsigned long start = millis();
 
   unsigned long now = millis();
@@ -175,7 +222,7 @@ testing(slow_expire_monitor) {
 
 externTestingF(CustomAgainFixture, fixture_slow_fail);
 
-testing(fixture_slow_fail_monitor) {
+serialTesting(fixture_slow_fail_monitor) {
   static unsigned long start = millis();
 
   unsigned long now = millis();
@@ -217,7 +264,7 @@ testing(fixture_slow_fail_monitor) {
 
 externTestingF(CustomAgainFixture, fixture_slow_expire);
 
-testing(fixture_slow_expire_monitor) {
+serialTesting(fixture_slow_expire_monitor) {
   static unsigned long start = millis();
 
   unsigned long now = millis();
@@ -254,6 +301,76 @@ testing(fixture_slow_expire_monitor) {
   }
 }
 
+#if AUNIT_ENABLE_TEST_TIMERS
+
+// A testing() with its own timeout, which must expire well before the 10
+// second timeout of the TestRunner. Made serial by setup(), since there is no
+// serial version of testingWithTimeout().
+testingWithTimeout(per_test_expire, 500) {}
+
+serialTesting(per_test_expire_monitor) {
+  static unsigned long start = millis();
+
+  unsigned long now = millis();
+  if (now - start < 400) {
+    assertTestNotDone(per_test_expire);
+  }
+  if (now - start > 700) {
+    assertTestExpire(per_test_expire);
+    assertTrue(test_per_test_expire_instance.isTestTimeout());
+    pass();
+  }
+}
+
+#endif
+
+// A benchmark which fails its assertFasterThan() check.
+class TooSlowBenchmark: public Benchmark {
+  protected:
+    void verify() override {
+      assertFasterThan((uint32_t) 1);
+    }
+};
+
+benchmarkF(TooSlowBenchmark, delay) {
+  delayMicroseconds(10);
+}
+
+// A table in which only the middle row fails. All 3 rows are run, and the
+// table as a whole fails.
+struct SquareRow {
+  int x;
+  int square;
+};
+
+static const SquareRow kSquareRows[] PROGMEM = {
+  {2, 4},
+  {3, 10},
+  {4, 16},
+};
+
+testTable(square_table, SquareRow, kSquareRows) {
+  assertEqual(row.x * row.x, row.square);
+}
+
+// A lazyTestF() which fails. The message of the assertion is reported under
+// the name of the test, although it is made by the fixture object.
+class LazyFixture: public TestOnce {
+  protected:
+    int expected = 1;
+};
+
+lazyTestF(LazyFixture, lazy_fail) {
+  assertEqual(expected, 2);
+}
+
+// An asyncTest() whose AUNIT_AWAIT() times out.
+asyncTest(await_timeout) {
+  AUNIT_ASYNC_BEGIN();
+  AUNIT_AWAIT(millis() == 0, 10);
+  AUNIT_ASYNC_END();
+}
+
 // -------------------------------------------------------------------------
 
 void setup() {
@@ -265,9 +382,13 @@ void setup() {
 
   SERIAL_PORT_MONITOR.println(F("This test should produce the following:"));
   SERIAL_PORT_MONITOR.println(
-    F("6 passed, 5 failed, 1 skipped, 4 timed out, out of 16 test(s).")
+    F("7 passed, 14 failed, 1 skipped, 5 timed out, out of 27 test(s).")
   );
   SERIAL_PORT_MONITOR.println(F("----"));
+
+#if AUNIT_ENABLE_TEST_TIMERS
+  test_per_test_expire_instance.setSerial();
+#endif
 }
 
 void loop() {
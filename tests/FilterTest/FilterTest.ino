@@ -87,6 +87,43 @@ void assertionLifeCycle(const Test::LifeCycle expected, const Test& instance, ui
 #define assertLifeCycle(expected, instance) \
   assertionLifeCycle(expected, instance, __LINE__)
 
+// Verify the matching of the compiled rules directly, including on flash
+// strings, and on patterns which are not NUL-terminated.
+test(FilterRule_matches) {
+  using internal::FCString;
+  using internal::FilterRule;
+
+  FilterRule glob = FilterRule::compile(nullptr, "a*b?c", 5, false, true);
+  assertTrue(glob.matches(FCString("abxc")));
+  assertTrue(glob.matches(FCString("axxbbyc")));
+  assertTrue(glob.matches(FCString(F("a_b_c"))));
+  assertFalse(glob.matches(FCString("abc")));
+  assertFalse(glob.matches(FCString("abxcd")));
+
+  // Only the first 3 characters of the list are the pattern.
+  FilterRule exact = FilterRule::compile(nullptr, "abc,def", 3, false, true);
+  assertTrue(exact.matches(FCString("abc")));
+  assertTrue(exact.matches(FCString(F("abc"))));
+  assertFalse(exact.matches(FCString("ab")));
+  assertFalse(exact.matches(FCString("abcd")));
+
+  FilterRule prefix = FilterRule::compile(nullptr, "ab*", 3, false, true);
+  assertTrue(prefix.matches(FCString("ab")));
+  assertTrue(prefix.matches(FCString(F("abcd"))));
+  assertFalse(prefix.matches(FCString("a")));
+
+  FilterRule fixture = FilterRule::compile("Custom", "d*", 2, false, true);
+  assertTrue(fixture.matches(FCString("Custom_display")));
+  assertFalse(fixture.matches(FCString("CustomOnce_display")));
+  assertFalse(fixture.matches(FCString("Custom")));
+
+  FilterRule sub = FilterRule::compile(nullptr, "*sp", 3, true, true);
+  assertFalse(sub.matches(FCString("display")));
+  sub = FilterRule::compile(nullptr, "sp", 2, true, true);
+  assertTrue(sub.matches(FCString(F("display"))));
+  assertFalse(sub.matches(FCString("configure")));
+}
+
 // An actual test() to verify that all the assertLifeCycle() in setup() actually
 // passed. This fails if *any* call to assertionLifeCycle() fails.
 test(lifeCycle) {
@@ -164,12 +201,30 @@ void setup() {
 
   TestRunner::include("lifeCycle");
   assertLifeCycle(Test::LifeCycle::New, test_lifeCycle_instance);
+
+  // Wildcards anywhere in the pattern.
+  TestRunner::exclude("Custom*_*");
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomOnce_configure_instance);
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomOnce_display_instance);
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomAgain_configure_instance);
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomAgain_display_instance);
+  assertLifeCycle(Test::LifeCycle::New, test_configure_instance);
+
+  TestRunner::include("*Again_d?splay");
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomOnce_display_instance);
+  assertLifeCycle(Test::LifeCycle::New, CustomAgain_display_instance);
+
+  TestRunner::include("CustomOnce", "*fig*");
+  assertLifeCycle(Test::LifeCycle::New, CustomOnce_configure_instance);
+  assertLifeCycle(Test::LifeCycle::Excluded, CustomAgain_configure_instance);
+
+  TestRunner::include("FilterRule_matches");
 }
 
 void loop() {
   // Should get something like:
   // TestRunner summary:
-  //    4 passed, 0 failed, 3 skipped, 0 timed out, out of 7 test(s).
+  //    5 passed, 0 failed, 3 skipped, 0 timed out, out of 8 test(s).
   //
   // Verify that excluded tests do not execute setup() and teardown(). They
   // go directly into the final Skipped state.
@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify that the static setupSuite() and teardownSuite() methods of a fixture
+ * are called once around all the testF() and testingF() tests of the fixture,
+ * including continuous tests which are interleaved with each other and the
+ * benchmarkF() benchmarks, and are not called for a fixture whose tests are
+ * all excluded.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+class OnceFixture: public TestOnce {
+  protected:
+    static void setupSuite() {
+      setupCount++;
+      sharedValue = 42;
+    }
+
+    static void teardownSuite() {
+      teardownCount++;
+      sharedValue = 0;
+    }
+
+    void assertSuiteOpen() {
+      assertEqual(setupCount, 1);
+      assertEqual(teardownCount, 0);
+      assertEqual(sharedValue, 42);
+    }
+
+  public:
+    static int setupCount;
+    static int teardownCount;
+    static int sharedValue;
+};
+
+int OnceFixture::setupCount = 0;
+int OnceFixture::teardownCount = 0;
+int OnceFixture::sharedValue = 0;
+
+testF(OnceFixture, a) { assertNoFatalFailure(assertSuiteOpen()); }
+testF(OnceFixture, b) { assertNoFatalFailure(assertSuiteOpen()); }
+testF(OnceFixture, c) { assertNoFatalFailure(assertSuiteOpen()); }
+
+class AgainFixture: public TestAgain {
+  protected:
+    static void setupSuite() { setupCount++; }
+    static void teardownSuite() { teardownCount++; }
+
+    void again() override {
+      assertEqual(setupCount, 1);
+      assertEqual(teardownCount, 0);
+      if (++mCount == 3) pass();
+    }
+
+  public:
+    static int setupCount;
+    static int teardownCount;
+
+  private:
+    int mCount = 0;
+};
+
+int AgainFixture::setupCount = 0;
+int AgainFixture::teardownCount = 0;
+
+// The two tests are stepped alternately by the TestRunner, so the suite must
+// stay open until both of them are done.
+testingF(AgainFixture, x) { AgainFixture::again(); }
+testingF(AgainFixture, y) { AgainFixture::again(); }
+
+class BenchFixture: public Benchmark {
+  protected:
+    static void setupSuite() { setupCount++; }
+    static void teardownSuite() { teardownCount++; }
+
+  public:
+    static int setupCount;
+    static int teardownCount;
+};
+
+int BenchFixture::setupCount = 0;
+int BenchFixture::teardownCount = 0;
+
+benchmarkF(BenchFixture, noop) {
+  doNotOptimize(setupCount);
+}
+
+// Only setupSuite() is defined, which is enough to create a suite.
+class ExcludedFixture: public TestOnce {
+  protected:
+    static void setupSuite() { setupCount++; }
+
+  public:
+    static int setupCount;
+};
+
+int ExcludedFixture::setupCount = 0;
+
+testF(ExcludedFixture, a) {}
+testF(ExcludedFixture, b) {}
+
+// A fixture without the static methods has no suite.
+class PlainFixture: public TestOnce {};
+
+testF(PlainFixture, a) {}
+
+// Serial, so that it runs after the tests of the suites with --jobs.
+serialTesting(z_verify) {
+  if (checkTestNotDoneF(OnceFixture, c) || checkTestNotDoneF(AgainFixture, x)
+      || checkTestNotDoneF(AgainFixture, y)
+      || checkTestNotDoneF(BenchFixture, noop)) {
+    return;
+  }
+  assertTestPassF(OnceFixture, a);
+  assertTestPassF(OnceFixture, b);
+  assertTestPassF(OnceFixture, c);
+  assertEqual(OnceFixture::setupCount, 1);
+  assertEqual(OnceFixture::teardownCount, 1);
+  assertEqual(OnceFixture::sharedValue, 0);
+
+  assertTestPassF(AgainFixture, x);
+  assertTestPassF(AgainFixture, y);
+  assertEqual(AgainFixture::setupCount, 1);
+  assertEqual(AgainFixture::teardownCount, 1);
+
+  assertTestPassF(BenchFixture, noop);
+  assertEqual(BenchFixture::setupCount, 1);
+  assertEqual(BenchFixture::teardownCount, 1);
+
+  assertTestSkipF(ExcludedFixture, a);
+  assertTestSkipF(ExcludedFixture, b);
+  assertEqual(ExcludedFixture::setupCount, 0);
+
+  assertTrue(OnceFixture_a_instance.getSuite() != nullptr);
+  assertTrue(OnceFixture_a_instance.getSuite()
+      == OnceFixture_c_instance.getSuite());
+  assertTrue(PlainFixture_a_instance.getSuite() == nullptr);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("ExcludedFixture", "*");
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    8 passed, 0 failed, 2 skipped, 0 timed out, out of 10 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify the heap usage recorded by the TestRunner when
+ * AUNIT_ENABLE_HEAP_TRACKING is set, and the assertNoLeaks() and
+ * assertMaxHeap() assertions.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+#if AUNIT_ENABLE_HEAP_TRACKING
+
+// The compiler may elide a new/delete pair whose pointer does not escape, so
+// the pointers are published here.
+void* volatile sink;
+
+test(no_allocation) {
+  assertNoLeaks();
+  assertMaxHeap(0);
+}
+
+test(balanced) {
+  uint8_t* a = new uint8_t[100];
+  uint8_t* b = new uint8_t[50];
+  sink = a;
+  sink = b;
+  assertMaxHeap(150);
+  delete[] a;
+  delete[] b;
+  assertNoLeaks();
+}
+
+// A fixture which allocates in setup() and frees in teardown() does not leak,
+// but its buffer is part of the peak of the test.
+class BufferFixture: public TestOnce {
+  protected:
+    void setup() override {
+      TestOnce::setup();
+      buffer = new uint8_t[64];
+      sink = buffer;
+    }
+
+    void teardown() override {
+      delete[] buffer;
+      TestOnce::teardown();
+    }
+
+    uint8_t* buffer = nullptr;
+};
+
+testF(BufferFixture, fixture) {
+  assertMaxHeap(64);
+}
+
+// Leaks on purpose, verified by verify_heap below, which frees the block.
+uint8_t* leaked = nullptr;
+
+test(leaky) {
+  leaked = new uint8_t[32];
+}
+
+testing(again_three) {
+  static uint8_t count = 0;
+  uint32_t* p = new uint32_t(count);
+  sink = p;
+  delete p;
+  if (++count == 3) pass();
+}
+
+// Inspects other tests, so must not run concurrently with them.
+serialTesting(verify_heap) {
+  if (checkTestNotDone(balanced)) return;
+  if (checkTestNotDone(leaky)) return;
+  if (checkTestNotDone(again_three)) return;
+  if (checkTestNotDoneF(BufferFixture, fixture)) return;
+
+  const Test::HeapUsage& balanced = test_balanced_instance.getHeapUsage();
+  assertEqual(2UL, balanced.allocCount);
+  assertEqual(150UL, balanced.allocBytes);
+  assertEqual(150UL, balanced.peakBytes);
+  assertEqual(0L, balanced.inUseBytes);
+
+  const Test::HeapUsage& leaky = test_leaky_instance.getHeapUsage();
+  assertEqual(1UL, leaky.allocCount);
+  assertEqual(32L, leaky.inUseBytes);
+
+  const Test::HeapUsage& again = test_again_three_instance.getHeapUsage();
+  assertEqual(3UL, again.allocCount);
+  assertEqual(4UL, again.peakBytes);
+  assertEqual(0L, again.inUseBytes);
+
+  const Test::HeapUsage& fixture =
+      BufferFixture_fixture_instance.getHeapUsage();
+  assertEqual(64UL, fixture.peakBytes);
+  assertEqual(0L, fixture.inUseBytes);
+
+  // Freeing memory allocated by another test does not count as a leak.
+  delete[] leaked;
+  assertNoLeaks();
+  pass();
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setVerbosity(Verbosity::kDefault | Verbosity::kTestTiming);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    6 passed, 0 failed, 0 skipped, 0 timed out, out of 6 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,129 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify that TestRunner::run() idles while all the remaining tests are
+ * asleep, instead of spinning through them until the earliest wakes up.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+// Incremented by the global loop(). Stays the same under --jobs and
+// --isolate, where the tests do not run from loop().
+unsigned long loopCount = 0;
+
+#if AUNIT_ENABLE_TEST_TIMERS
+
+// Without idling, each of these sleeps would take thousands of calls to
+// loop(). With idling, each pass through the sleeping tests costs a few
+// calls, and there is a pass only when one of them wakes up.
+const unsigned long kMaxLoops = 50;
+
+asyncTest(sleep_short) {
+  static unsigned long startLoops;
+  static unsigned long startMillis;
+  AUNIT_ASYNC_BEGIN();
+  startLoops = loopCount;
+  startMillis = millis();
+  AUNIT_SLEEP(40);
+  assertMoreOrEqual(millis() - startMillis, 40UL);
+  assertLess(loopCount - startLoops, kMaxLoops);
+  AUNIT_ASYNC_END();
+}
+
+asyncTest(sleep_long) {
+  static unsigned long startLoops;
+  static unsigned long startMillis;
+  AUNIT_ASYNC_BEGIN();
+  startLoops = loopCount;
+  startMillis = millis();
+  AUNIT_SLEEP(60);
+  AUNIT_SLEEP(60);
+  assertMoreOrEqual(millis() - startMillis, 120UL);
+  assertLess(loopCount - startLoops, kMaxLoops);
+  AUNIT_ASYNC_END();
+}
+
+// A plain testing() can sleep between its calls to again() too.
+uint8_t ticks = 0;
+unsigned long tickStartLoops = 0;
+
+testing(sleep_until) {
+  if (ticks == 0) tickStartLoops = loopCount;
+  if (ticks == 4) {
+    assertLess(loopCount - tickStartLoops, kMaxLoops);
+    pass();
+    return;
+  }
+  ticks++;
+  sleepUntil(millis() + 20);
+}
+
+// A test which is never registered with init(), and sleeps for longer than
+// its own timeout.
+class OversleepingTest: public TestAgain {
+  public:
+    void again() override {
+      sleepUntil(millis() + 2000);
+    }
+};
+
+test(sleep_past_timeout) {
+  OversleepingTest probe;
+  probe.setTimeout(50);
+  unsigned long start = millis();
+  probe.loop();
+
+  // The test reports its deadline instead of its wake time, so the
+  // TestRunner does not idle past the timeout.
+  unsigned long wakeMillis = 0;
+  probe.loop();
+  assertTrue(TestAgain::consumeSleep(wakeMillis));
+  assertLessOrEqual(wakeMillis - start, 50UL);
+
+  delay(60);
+  probe.loop();
+  assertTrue(probe.isExpired());
+  assertTrue(probe.isTestTimeout());
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 0 skipped, 0 timed out, out of 4 test(s).
+  loopCount++;
+  TestRunner::run();
+}
@@ -0,0 +1,154 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify the footprints recorded by the ImpactTracker, which is enabled by the
+ * Makefile of this test together with '-finstrument-functions', and the
+ * selection of the tests by the ImpactMap.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <AUnit.h>
+#include <aunit/ImpactTracker.h>
+#include <aunit/ImpactMap.h>
+#include "Widget.h"
+
+using namespace aunit;
+using aunit::internal::ImpactMap;
+using aunit::internal::ImpactTracker;
+
+namespace {
+
+bool endsWith(const std::string& s, const char* suffix) {
+  std::string t(suffix);
+  return s.size() >= t.size() && s.compare(s.size() - t.size(), t.size(), t)
+      == 0;
+}
+
+bool hasFile(const std::vector<std::string>& files, const char* suffix) {
+  for (const std::string& file : files) {
+    if (endsWith(file, suffix)) return true;
+  }
+  return false;
+}
+
+void writeFile(const char* fileName, const char* content) {
+  FILE* f = fopen(fileName, "w");
+  fputs(content, f);
+  fclose(f);
+}
+
+const char kMapFile[] = "/tmp/ImpactTest.map";
+const char kChangedFile[] = "/tmp/ImpactTest.changed";
+
+/** Selects the tests in setup(), like the '--changed-files' flag. */
+ImpactMap impactMap;
+
+/** Saved by setup(), since the tests may run in parallel or isolated. */
+bool isNoWidgetExcluded = false;
+
+}
+
+// Only the calls made in the scope of the tracker are recorded, so the
+// footprint has the function of Widget.cpp, but not this test itself.
+test(footprint) {
+  std::vector<uintptr_t> addresses;
+  {
+    ImpactTracker tracker(nullptr);
+    assertEqual(7, scaleWidget(2));
+  }
+  ImpactTracker::takeFootprint(nullptr, addresses);
+  assertEqual((size_t) 1, addresses.size());
+
+  std::vector<std::string> files;
+  assertTrue(ImpactTracker::resolveFiles(addresses, files));
+  assertEqual((size_t) 1, files.size());
+  assertTrue(hasFile(files, "/Widget.cpp"));
+
+  // Taken only once.
+  addresses.clear();
+  ImpactTracker::takeFootprint(nullptr, addresses);
+  assertTrue(addresses.empty());
+}
+
+// Its recorded file matches a changed file.
+test(uses_widget) {
+  assertEqual(7, scaleWidget(2));
+}
+
+// None of its recorded files has changed, so it is excluded.
+test(no_widget) {
+  fail();
+}
+
+// Not in the map, so it runs.
+test(new_test) {
+  pass();
+}
+
+test(select) {
+  assertTrue(impactMap.hasChangedFiles());
+  assertTrue(isNoWidgetExcluded);
+  assertFalse(impactMap.loadChangedFiles("/nonexistent/ImpactTest.changed"));
+
+  // Nothing was recorded into this map, so its file is not written.
+  assertTrue(impactMap.save());
+  FILE* f = fopen(kMapFile, "r");
+  assertTrue(f == nullptr);
+  if (f) fclose(f);
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  writeFile(kMapFile,
+      "# comment\n"
+      "uses_widget /home/me/repo/tests/ImpactTest/Widget.cpp\n"
+      "uses_widget /home/me/repo/src/aunit/Test.cpp\n"
+      "no_widget /home/me/repo/tests/ImpactTest/ImpactTest.ino\n");
+  writeFile(kChangedFile,
+      "tests/ImpactTest/../ImpactTest/Widget.cpp\n"
+      "\n"
+      "ImpactTest.ino.orig\n");
+  impactMap.load(kMapFile);
+  impactMap.loadChangedFiles(kChangedFile);
+  impactMap.select(Test::getRoot());
+  isNoWidgetExcluded = (test_no_widget_instance.getLifeCycle()
+      == Test::LifeCycle::Excluded);
+  remove(kMapFile);
+  remove(kChangedFile);
+}
+
+void loop() {
+  // Should get:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 1 skipped, 0 timed out, out of 5 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,5 @@
+#include "Widget.h"
+
+int scaleWidget(int size) {
+  return size * 3 + 1;
+}
@@ -0,0 +1,7 @@
+#ifndef IMPACT_TEST_WIDGET_H
+#define IMPACT_TEST_WIDGET_H
+
+/** The code under test, in a separate source file. */
+int scaleWidget(int size);
+
+#endif
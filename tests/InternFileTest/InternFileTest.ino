@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+ * Verify the "#{id}:{line}: " prefix of the assertion messages printed with
+ * AUNIT_INTERN_FILE_NAMES, which is enabled by the Makefile of this test with
+ * a table of only 2 files, and that each test defines again the ids that it
+ * uses.
+ */
+
+#include <string.h>
+#include <AUnit.h>
+#include <aunit/print_util.h>
+using namespace aunit;
+using aunit::internal::printLocation;
+
+/** A Print which collects its output into a fixed NUL-terminated buffer. */
+class BufferPrint: public Print {
+  public:
+    static const uint16_t kBufSize = 128;
+
+    size_t write(uint8_t c) override {
+      if (mIndex >= kBufSize - 1) return 0;
+      mBuf[mIndex++] = c;
+      mBuf[mIndex] = '\0';
+      return 1;
+    }
+
+    const char* getBuffer() const { return mBuf; }
+
+    void clear() {
+      mIndex = 0;
+      mBuf[0] = '\0';
+    }
+
+  private:
+    char mBuf[kBufSize] = {};
+    uint16_t mIndex = 0;
+};
+
+static const char kFirst[] = "first.cpp";
+static const char kSecond[] = "second.cpp";
+static const char kThird[] = "third.cpp";
+
+// The table is shared by the whole program, so the ids are checked in a single
+// test. The other tests do not add any file.
+test(printLocation) {
+  BufferPrint out;
+
+  // The path is printed once, before the first use of the id.
+  printLocation(&out, kFirst, 10);
+  assertEqual("TestRunner file 1: first.cpp\r\n#1:10: ", out.getBuffer());
+  out.clear();
+  printLocation(&out, kFirst, 11);
+  assertEqual("#1:11: ", out.getBuffer());
+
+  out.clear();
+  printLocation(&out, kSecond, 12);
+  assertEqual("TestRunner file 2: second.cpp\r\n#2:12: ", out.getBuffer());
+
+  // The table is full, so the third file keeps its path.
+  out.clear();
+  printLocation(&out, kThird, 13);
+  assertEqual("third.cpp:13: ", out.getBuffer());
+
+  out.clear();
+  printLocation(&out, kFirst, 14);
+  assertEqual("#1:14: ", out.getBuffer());
+
+  // A new block of output defines the id again.
+  internal::resetPrintedFiles();
+  out.clear();
+  printLocation(&out, kFirst, 15);
+  assertEqual("TestRunner file 1: first.cpp\r\n#1:15: ", out.getBuffer());
+}
+
+// The output of each test may be printed out of order by --jobs, or by
+// another process with its own ids by --isolate, so the TestRunner starts a
+// new block for each test. The id itself depends on which test runs first.
+test(printLocation_again) {
+  BufferPrint out;
+  printLocation(&out, kFirst, 20);
+  assertEqual(0, strncmp("TestRunner file ", out.getBuffer(), 16));
+  assertTrue(strstr(out.getBuffer(), ": first.cpp\r\n#") != nullptr);
+}
+
+// The messages captured by these reporters keep the full path, so that they
+// do not depend on the definition of the id in another message.
+test(printLocation_path) {
+  BufferPrint out;
+  JUnitReporter junit;
+  junit.printLocation(&out, kFirst, 30);
+  assertEqual("first.cpp:30: ", out.getBuffer());
+
+  out.clear();
+  JsonLinesReporter jsonLines;
+  jsonLines.printLocation(&out, kFirst, 31);
+  assertEqual("first.cpp:31: ", out.getBuffer());
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 0 skipped, 0 timed out, out of 3 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that TestRunner::setIsolation() runs the tests in worker processes,
+ * so that their side effects are not visible to the TestRunner, while their
+ * results are. The serial test runs on the main process after the isolated
+ * ones.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+static int counter = 0;
+
+test(a_increment) {
+  counter++;
+  assertEqual(1, counter);
+}
+
+testing(b_increment_again) {
+  counter++;
+  if (counter >= 3) pass();
+}
+
+test(c_skipped) {
+  skip();
+}
+
+serialTest(z_verify) {
+  assertEqual(0, counter);
+  assertTestPass(a_increment);
+  assertTestPass(b_increment_again);
+  assertTestSkip(c_skipped);
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+#if defined(EPOXY_DUINO)
+  TestRunner::setIsolation(true);
+  TestRunner::setParallelism(2);
+#endif
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 1 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify that the fixture objects of lazyTestF() and lazyTestingF() are
+ * constructed only when their tests are run, destroyed after their
+ * teardown(), and never constructed for the tests which are excluded.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+static int numConstructed = 0;
+static int numDestroyed = 0;
+static int numTornDown = 0;
+
+class BufferFixture: public TestOnce {
+  public:
+    BufferFixture() : mBuffer(new uint8_t[16]()) { numConstructed++; }
+
+    ~BufferFixture() {
+      delete[] mBuffer;
+      numDestroyed++;
+    }
+
+  protected:
+    void setup() override {
+      TestOnce::setup();
+      mBuffer[0] = 1;
+    }
+
+    void teardown() override {
+      numTornDown++;
+      TestOnce::teardown();
+    }
+
+    uint8_t* mBuffer;
+};
+
+lazyTestF(BufferFixture, a) {
+  assertEqual(mBuffer[0], 1);
+  assertEqual(numConstructed - numDestroyed, 1);
+}
+
+lazyTestF(BufferFixture, b) {
+  assertEqual(mBuffer[0], 1);
+  assertEqual(numConstructed - numDestroyed, 1);
+}
+
+lazyTestF(BufferFixture, excluded) {
+  fail();
+}
+
+lazyTestF(BufferFixture, skipped) {
+  skipTestNow();
+}
+
+class CountFixture: public TestAgain {
+  protected:
+    int mCount = 0;
+};
+
+lazyTestingF(CountFixture, loop) {
+  if (++mCount == 3) pass();
+}
+
+// Serial, so that the counters are stable with --jobs.
+serialTesting(z_verify) {
+  if (checkTestNotDoneF(CountFixture, loop)) return;
+
+  assertTestPassF(BufferFixture, a);
+  assertTestPassF(BufferFixture, b);
+  assertTestSkipF(BufferFixture, excluded);
+  assertTestSkipF(BufferFixture, skipped);
+  assertTestPassF(CountFixture, loop);
+
+  // Only a, b and skipped were constructed, and all of them were destroyed.
+  assertEqual(numConstructed, 3);
+  assertEqual(numDestroyed, 3);
+  assertEqual(numTornDown, 3);
+  assertTrue(BufferFixture_a_instance.getTest() == nullptr);
+  assertTrue(CountFixture_loop_instance.getTest() == nullptr);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("BufferFixture", "excluded");
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 2 skipped, 0 timed out, out of 6 test(s).
+  TestRunner::run();
+}
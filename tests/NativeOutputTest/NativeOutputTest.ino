@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify the buffering of the native output of EpoxyDuino, which is the
+ * default printer when AUNIT_NATIVE_OUTPUT_BUFFER_SIZE is set.
+ */
+
+#include <stdio.h> // tmpfile()
+#include <stdlib.h> // malloc()
+#include <string.h>
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // pread(), dup(), dup2()
+#include <AUnit.h>
+using namespace aunit;
+
+#if AUNIT_NATIVE_OUTPUT_BUFFER_SIZE > 0
+
+using aunit::internal::FdPrint;
+
+/**
+ * Sends the native output to a temporary file, until restore() is called.
+ * Nothing may be asserted in between, because the messages of the assertions
+ * would also go to the file.
+ */
+class Capture {
+  public:
+    Capture():
+        mFile(tmpfile()),
+        mOldFd(FdPrint::getInstance()->getFd()) {
+      FdPrint::getInstance()->setFd(fileno(mFile));
+    }
+
+    ~Capture() {
+      restore();
+      fclose(mFile);
+    }
+
+    void restore() { FdPrint::getInstance()->setFd(mOldFd); }
+
+    /** Return the number of bytes written to the file. */
+    long size() const {
+      struct stat st;
+      fstat(fileno(mFile), &st);
+      return st.st_size;
+    }
+
+    /** Read 'size' bytes at 'offset' of the file into 'buffer'. */
+    void read(char* buffer, size_t size, long offset) const {
+      ssize_t n = pread(fileno(mFile), buffer, size, offset);
+      buffer[n > 0 ? n : 0] = '\0';
+    }
+
+  private:
+    FILE* mFile;
+    int mOldFd;
+};
+
+// They reconfigure the printer of the main thread.
+serialTest(small_writes_are_buffered) {
+  Capture capture;
+  FdPrint::getInstance()->print(F("hello"));
+  long sizeBefore = capture.size();
+  FdPrint::getInstance()->flushBuffer();
+  long sizeAfter = capture.size();
+  char buffer[8];
+  capture.read(buffer, 5, 0);
+  capture.restore();
+
+  assertEqual(0L, sizeBefore);
+  assertEqual(5L, sizeAfter);
+  assertEqual("hello", buffer);
+}
+
+// A block larger than the buffer is written after the buffered characters,
+// and before the characters which follow it.
+serialTest(large_write_keeps_order) {
+  const size_t blockSize = AUNIT_NATIVE_OUTPUT_BUFFER_SIZE + 100;
+  uint8_t* block = (uint8_t*) malloc(blockSize);
+  memset(block, 'x', blockSize);
+
+  Capture capture;
+  FdPrint* output = FdPrint::getInstance();
+  output->print(F("ab"));
+  output->write(block, blockSize);
+  long sizeBlock = capture.size();
+  output->print(F("cd"));
+  output->flushBuffer();
+  long sizeAfter = capture.size();
+  char head[4];
+  char tail[4];
+  capture.read(head, 3, 0);
+  capture.read(tail, 3, sizeAfter - 3);
+  capture.restore();
+  free(block);
+
+  assertEqual((long) blockSize + 2, sizeBlock);
+  assertEqual((long) blockSize + 4, sizeAfter);
+  assertEqual("abx", head);
+  assertEqual("xcd", tail);
+}
+
+// The native output and the Serial of EpoxyDuino share stdout, which is sent
+// to a temporary file here, so the messages of the assertions must be written
+// in order with the line printed to Serial between them, within the same step.
+serialTest(serial_lines_keep_order) {
+  FILE* file = tmpfile();
+  FdPrint::getInstance()->flushBuffer();
+  fflush(stdout);
+  int oldStdout = dup(STDOUT_FILENO);
+  dup2(fileno(file), STDOUT_FILENO);
+
+  assertEqual(101, 101);
+  SERIAL_PORT_MONITOR.println(F("SERIAL LINE"));
+  fflush(stdout);
+  assertEqual(202, 202);
+
+  FdPrint::getInstance()->flushBuffer();
+  fflush(stdout);
+  dup2(oldStdout, STDOUT_FILENO);
+  close(oldStdout);
+  char buffer[512];
+  size_t n = fread(buffer, 1, sizeof(buffer) - 1, (rewind(file), file));
+  buffer[n] = '\0';
+  fclose(file);
+
+  const char* first = strstr(buffer, "(101)");
+  const char* serial = strstr(buffer, "SERIAL LINE");
+  const char* second = strstr(buffer, "(202)");
+  assertTrue(first != nullptr);
+  assertTrue(serial != nullptr);
+  assertTrue(second != nullptr);
+  assertLess(first - buffer, serial - buffer);
+  assertLess(serial - buffer, second - buffer);
+}
+
+// The messages of the assertions fill the buffer several times, which is
+// written each time it is full.
+test(many_lines) {
+  for (int i = 0; i < 2000; i++) {
+    assertEqual(i, i);
+  }
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  // Print the assertion messages of many_lines.
+  TestRunner::setVerbosity(Verbosity::kAll);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 0 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
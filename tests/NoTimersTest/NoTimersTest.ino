@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that asyncTest() and AUNIT_SLEEP() still work when the per-test
+ * timers of TestAgain are removed by AUNIT_ENABLE_TEST_TIMERS=0, which is set
+ * by the Makefile of this test.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+#if AUNIT_ENABLE_TEST_TIMERS
+  #error AUNIT_ENABLE_TEST_TIMERS must be disabled for this test
+#endif
+
+static_assert(sizeof(TestAgain) == sizeof(MetaAssertion),
+    "TestAgain must not add any member without AUNIT_ENABLE_TEST_TIMERS");
+
+// Number of calls to the body, which polls its wake time.
+unsigned long sleepVisits = 0;
+
+asyncTest(sleep) {
+  static unsigned long startMillis;
+  sleepVisits++;
+  AUNIT_ASYNC_BEGIN();
+  startMillis = millis();
+  AUNIT_SLEEP(50);
+  assertMoreOrEqual(millis() - startMillis, 50UL);
+  AUNIT_ASYNC_END();
+}
+
+asyncTest(await) {
+  static unsigned long startMillis;
+  AUNIT_ASYNC_BEGIN();
+  startMillis = millis();
+  AUNIT_SLEEP(10);
+  AUNIT_AWAIT(millis() - startMillis >= 30, 1000);
+  AUNIT_ASYNC_END();
+}
+
+testing(z_verify) {
+  if (checkTestNotDone(sleep) || checkTestNotDone(await)) return;
+
+  assertTestPass(sleep);
+  assertTestPass(await);
+  // Once before and once after the sleep, since run() is not called while
+  // it sleeps.
+  assertEqual(2UL, sleepVisits);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 0 skipped, 0 timed out, out of 3 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,124 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that TestRunner::setParallelism() runs every test exactly once, and
+ * that the serialTest() and serialTesting() tests are run after all the other
+ * tests have finished. On platforms other than EpoxyDuino, the tests are
+ * simply run sequentially.
+ */
+
+#include <AUnit.h>
+#if defined(EPOXY_DUINO)
+  #include <atomic>
+#endif
+using namespace aunit;
+
+#if defined(EPOXY_DUINO)
+  std::atomic<int> onceCount(0);
+  std::atomic<int> againCount(0);
+#else
+  int onceCount = 0;
+  int againCount = 0;
+#endif
+
+// -----------------------------------------------------------------------
+// Tests which can be run concurrently.
+// -----------------------------------------------------------------------
+
+test(parallel, once1) { onceCount++; assertTrue(true); }
+test(parallel, once2) { onceCount++; assertEqual(1, 1); }
+test(parallel, once3) { onceCount++; assertNotEqual(1, 2); }
+test(parallel, once4) { onceCount++; assertLess(1, 2); }
+test(parallel, once5) { onceCount++; assertStringCaseEqual("a", "A"); }
+test(parallel, once6) { onceCount++; }
+
+test(parallel, skipped) { onceCount++; skip(); }
+
+testing(parallel, again1) {
+  static int iterations = 0;
+  if (++iterations == 10) { againCount++; pass(); }
+}
+
+testing(parallel, again2) {
+  static int iterations = 0;
+  if (++iterations == 100) { againCount++; pass(); }
+}
+
+class CustomOnce: public TestOnce {
+  protected:
+    void setup() override {
+      TestOnce::setup();
+      mValue = 42;
+    }
+
+    int mValue = 0;
+};
+
+testF(CustomOnce, fixture) {
+  onceCount++;
+  assertEqual(42, mValue);
+}
+
+// -----------------------------------------------------------------------
+// Tests run after all the concurrent tests. The names are chosen to sort after
+// the tests above, so that they also pass when the tests run sequentially.
+// -----------------------------------------------------------------------
+
+serialTest(total, once) {
+  assertEqual(8, (int) onceCount);
+}
+
+// When run sequentially, the testing() tests above are interleaved with this
+// one, so wait for them to finish instead of asserting right away.
+serialTesting(total, again) {
+  if (againCount == 2) pass();
+}
+
+serialTestF(CustomOnce, serial) {
+  assertEqual(42, mValue);
+}
+
+// -----------------------------------------------------------------------
+// setup() and loop().
+// -----------------------------------------------------------------------
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+#if defined(EPOXY_DUINO)
+  TestRunner::setParallelism(4);
+#endif
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    12 passed, 0 failed, 1 skipped, 0 timed out, out of 13 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/*
+ * Verify TestRunner::setRepeat(), which resets the tests with
+ * TestRunner::reset() and runs them again in the same process. The tests are
+ * sorted by name, so 'verify' runs last in each iteration.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+static const uint16_t kIterations = 3;
+
+uint16_t aRuns = 0;
+uint16_t sleeperRuns = 0;
+uint16_t iterations = 0;
+
+test(a) {
+  aRuns++;
+}
+
+// Excluded in setup(), and stays excluded in every iteration.
+test(excluded) {
+  fail();
+}
+
+// TestAgain::setup() clears the sleep of the previous iteration.
+testing(sleeper) {
+  static bool isAwake = false;
+  if (isAwake) {
+    isAwake = false;
+    pass();
+    return;
+  }
+  sleeperRuns++;
+  isAwake = true;
+#if AUNIT_ENABLE_TEST_TIMERS
+  sleepUntil(millis() + 5);
+#endif
+}
+
+test(verify) {
+  iterations++;
+  assertEqual(iterations, aRuns);
+  assertEqual(iterations, sleeperRuns);
+
+#if AUNIT_ENABLE_REPEAT_STATS
+  // The results of the previous iterations are kept by reset().
+  const Test::RepeatStats& stats = test_a_instance.getRepeatStats();
+  assertEqual(iterations, stats.passedCount);
+  assertEqual((uint16_t) 0, stats.failedCount);
+  assertEqual((uint16_t) 0,
+      test_excluded_instance.getRepeatStats().failedCount);
+#endif
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("excluded");
+  TestRunner::setRepeat(kIterations);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 1 skipped, 0 timed out, out of 4 test(s).
+  // (3 times), then:
+  // TestRunner repeat summary: 3 passed, 0 failed, out of 3 iteration(s).
+  TestRunner::run();
+}
@@ -0,0 +1,311 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify the output of the TextReporter, TapReporter, JsonLinesReporter,
+ * JUnitReporter and BinaryReporter.
+ * Each reporter writes to the current Printer, which is temporarily replaced
+ * by a BufferPrint, and is fed with the results of the 'passing' and
+ * 'excluded' tests below.
+ */
+
+#include <string.h>
+#include <AUnit.h>
+using namespace aunit;
+
+/**
+ * A Print which collects its output into a fixed NUL-terminated buffer. The
+ * binary output may contain NUL characters, so its length is also kept.
+ */
+class BufferPrint: public Print {
+  public:
+    static const uint16_t kBufSize = 256;
+
+    size_t write(uint8_t c) override {
+      if (mIndex >= kBufSize - 1) return 0;
+      mBuf[mIndex++] = c;
+      mBuf[mIndex] = '\0';
+      return 1;
+    }
+
+    const char* getBuffer() const { return mBuf; }
+
+    uint16_t getLength() const { return mIndex; }
+
+    void clear() {
+      mIndex = 0;
+      mBuf[0] = '\0';
+    }
+
+  private:
+    char mBuf[kBufSize] = {};
+    uint16_t mIndex = 0;
+};
+
+test(passing) {
+  pass();
+}
+
+test(excluded) {}
+
+/**
+ * Runs the reporter with its output redirected into a buffer. Waits for the
+ * 'passing' and 'excluded' tests to be resolved first.
+ */
+class ReporterFixture: public TestAgain {
+  protected:
+    void setup() override {
+      TestAgain::setup();
+      savedPrinter = Printer::getPrinter();
+    }
+
+    void teardown() override {
+      Printer::setPrinter(savedPrinter);
+      TestAgain::teardown();
+    }
+
+    bool isReady() {
+      return test_passing_instance.isDone()
+          && test_excluded_instance.isDone();
+    }
+
+    void capture() {
+      out.clear();
+      Printer::setPrinter(&out);
+    }
+
+    void release() {
+      Printer::setPrinter(savedPrinter);
+    }
+
+    /** Write a message with characters which must be escaped. */
+    void writeMessage(Reporter* reporter) {
+      Print* printer = reporter->beginMessage(&test_passing_instance);
+      printer->println(F("a<b & \"c\""));
+      printer->print(F("d"));
+      reporter->endMessage();
+    }
+
+    bool startsWith(const char* prefix) {
+      return strncmp(out.getBuffer(), prefix, strlen(prefix)) == 0;
+    }
+
+    Print* savedPrinter;
+    BufferPrint out;
+};
+
+serialTestingF(ReporterFixture, text) {
+  if (!isReady()) return;
+  TextReporter reporter(false /*isColor*/);
+
+  capture();
+  reporter.endTest(test_passing_instance, Verbosity::kTestAll);
+  reporter.endTest(test_excluded_instance, Verbosity::kTestAll);
+  release();
+  assertTrue(strstr(out.getBuffer(),
+      " passing passed.\r\n") != nullptr);
+  assertTrue(strstr(out.getBuffer(),
+      " excluded skipped.\r\n") != nullptr);
+  assertTrue(strchr(out.getBuffer(), '\033') == nullptr);
+
+  reporter.setColor(true);
+  capture();
+  reporter.endTest(test_passing_instance, Verbosity::kTestAll);
+  reporter.endTest(test_excluded_instance, Verbosity::kTestPassed);
+  release();
+  assertTrue(strstr(out.getBuffer(),
+      " passing\033[32m passed\033[37m.\r\n") != nullptr);
+  assertTrue(strstr(out.getBuffer(), "excluded") == nullptr);
+  pass();
+}
+
+serialTestingF(ReporterFixture, tap) {
+  if (!isReady()) return;
+  TapReporter reporter;
+
+  capture();
+  reporter.beginRun(2, Verbosity::kNone);
+  writeMessage(&reporter);
+  reporter.endTest(test_passing_instance, Verbosity::kNone);
+  reporter.endTest(test_excluded_instance, Verbosity::kNone);
+  release();
+
+  assertEqual(
+      "TAP version 13\r\n"
+      "1..2\r\n"
+      "# a<b & \"c\"\r\n"
+      "# d\r\n"
+      "ok - passing\r\n"
+      "ok - excluded # SKIP\r\n",
+      out.getBuffer());
+  pass();
+}
+
+serialTestingF(ReporterFixture, jsonl) {
+  if (!isReady()) return;
+  JsonLinesReporter reporter;
+
+  capture();
+  reporter.beginRun(2, Verbosity::kNone);
+  writeMessage(&reporter);
+  release();
+  assertEqual(
+      "{\"event\":\"start\",\"tests\":2}\r\n"
+      "{\"event\":\"message\",\"test\":\"passing\","
+          "\"text\":\"a<b & \\\"c\\\"\\nd\"}\r\n",
+      out.getBuffer());
+
+  // The "micros" field, if any, follows the status.
+  capture();
+  reporter.endTest(test_passing_instance, Verbosity::kNone);
+  release();
+  assertTrue(startsWith(
+      "{\"event\":\"test\",\"name\":\"passing\",\"status\":\"passed\""));
+  pass();
+}
+
+serialTestingF(ReporterFixture, junit) {
+  if (!isReady()) return;
+  JUnitReporter reporter;
+
+  capture();
+  reporter.beginRun(2, Verbosity::kNone);
+  release();
+  assertEqual(
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+      "<testsuite name=\"AUnit\" tests=\"2\">\r\n",
+      out.getBuffer());
+
+  // The "time" attribute, if any, follows the name.
+  capture();
+  writeMessage(&reporter);
+  reporter.endTest(test_passing_instance, Verbosity::kNone);
+  release();
+  assertTrue(startsWith(
+      "  <testcase classname=\"AUnit\" name=\"passing\""));
+  assertTrue(strstr(out.getBuffer(),
+      "><system-out>a&lt;b &amp; &quot;c&quot;\nd</system-out></testcase>")
+      != nullptr);
+
+  capture();
+  reporter.endTest(test_excluded_instance, Verbosity::kNone);
+  reporter.endRun(RunSummary(), Verbosity::kNone);
+  release();
+  assertTrue(strstr(out.getBuffer(),
+      "><skipped/></testcase>\r\n</testsuite>\r\n") != nullptr);
+  pass();
+}
+
+serialTestingF(ReporterFixture, binary) {
+  if (!isReady()) return;
+  BinaryReporter reporter;
+
+  capture();
+  reporter.beginRun(2, Verbosity::kNone);
+  release();
+  assertEqual(6, out.getLength());
+  assertEqual(0, memcmp(out.getBuffer(), "\x01" "AU" "\x01" "\x02", 5));
+  assertEqual((uint8_t) Test::getDisplayMinPosition(),
+      (uint8_t) out.getBuffer()[5]);
+
+  // The name of the test is sent once, before its first message, and the
+  // trailing newline of a message is dropped.
+  capture();
+  writeMessage(&reporter);
+  writeMessage(&reporter);
+  reporter.endTest(test_passing_instance, Verbosity::kNone);
+  release();
+  const char kMessages[] =
+      "\x02" "passing\0"
+      "\x04" "a<b & \"c\"\nd\0"
+      "\x04" "a<b & \"c\"\nd\0"
+      "\x06";
+  assertEqual(0, memcmp(out.getBuffer(), kMessages, sizeof(kMessages) - 1));
+  uint8_t flags = out.getBuffer()[sizeof(kMessages) - 1];
+  assertEqual((uint8_t) Test::Status::Passed, (uint8_t) (flags & 0x07));
+
+  // The path of a file is sent once, then only its id. The line 300 is the
+  // varint 0xAC 0x02.
+  capture();
+  for (uint8_t i = 0; i < 2; i++) {
+    Print* printer = reporter.beginMessage(&test_excluded_instance);
+    reporter.printLocation(printer, "binary.cpp", 300);
+    printer->println('x');
+    reporter.endMessage();
+  }
+  reporter.endTest(test_excluded_instance, Verbosity::kNone);
+  release();
+  const char* buf = out.getBuffer();
+  char id = buf[11];
+  assertEqual(0, memcmp(buf, "\x02" "excluded\0" "\x03", 11));
+  assertEqual(0, memcmp(buf + 12, "binary.cpp\0", 11));
+  const char kLocated[] = {0x05, id, (char) 0xAC, 0x02, 'x', 0};
+  assertEqual(0, memcmp(buf + 23, kLocated, 6));
+  assertEqual(0, memcmp(buf + 29, kLocated, 6));
+  assertEqual((uint8_t) 0x06, (uint8_t) buf[35]);
+  assertEqual((uint8_t) Test::Status::Skipped, (uint8_t) buf[36]);
+
+  // The next block sends the path again, with the same id.
+  capture();
+  Print* printer = reporter.beginMessage(&test_passing_instance);
+  reporter.printLocation(printer, "binary.cpp", 300);
+  printer->println('x');
+  reporter.endMessage();
+  release();
+  const char kDefined[] = {0x02, 'p', 'a', 's', 's', 'i', 'n', 'g', 0,
+      0x03, id, 'b', 'i', 'n', 'a', 'r', 'y', '.', 'c', 'p', 'p', 0};
+  assertEqual(sizeof(kDefined) + 6, (size_t) out.getLength());
+  assertEqual(0, memcmp(out.getBuffer(), kDefined, sizeof(kDefined)));
+  assertEqual(0, memcmp(out.getBuffer() + sizeof(kDefined), kLocated, 6));
+
+  RunSummary summary = RunSummary();
+  summary.count = 2;
+  summary.passedCount = 1;
+  summary.skippedCount = 1;
+  summary.durationMillis = 300;
+  capture();
+  reporter.endRun(summary, Verbosity::kNone);
+  release();
+  assertEqual(9, out.getLength());
+  assertEqual(0, memcmp(out.getBuffer(),
+      "\x07" "\x02\x01\x00\x01\x00\x00" "\xAC\x02", 9));
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("excluded");
+}
+
+void loop() {
+  // Should get:
+  // TestRunner summary:
+  //    6 passed, 0 failed, 1 skipped, 0 timed out, out of 7 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that the ResultsCache of the '--cache' flag reads back the file
+ * written by save(), including a test name longer than any line buffer. The
+ * tests are run twice with '--failed-first', by the command line set in
+ * setup(), to verify that each iteration of setRepeat() keeps its order.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <AUnit.h>
+#include <aunit/ResultsCache.h>
+
+using namespace aunit;
+
+#if defined(EPOXY_DUINO)
+
+using aunit::internal::ResultsCache;
+
+namespace {
+
+const char kCacheFile[] = "/tmp/ResultsCacheTest.cache";
+const char kRunnerCacheFile[] = "/tmp/ResultsCacheTest.runner";
+
+const uint16_t kIterations = 2;
+
+void writeFile(const char* fileName, const std::string& content) {
+  FILE* f = fopen(fileName, "w");
+  fputs(content.c_str(), f);
+  fclose(f);
+}
+
+std::string readFile(const char* fileName) {
+  std::string content;
+  FILE* f = fopen(fileName, "r");
+  if (f == nullptr) return content;
+  for (int c; (c = fgetc(f)) != EOF; ) {
+    content += (char) c;
+  }
+  fclose(f);
+  return content;
+}
+
+}
+
+// A name of 300 characters must stay a single entry, instead of its tail
+// becoming a separate entry of unknown status.
+test(long_name_round_trip) {
+  std::string longName = "LongFixture_" + std::string(300, 'x');
+  std::string content = longName + " failed 12\n"
+      + "short_name passed 34\n";
+  writeFile(kCacheFile, content);
+
+  ResultsCache cache;
+  assertTrue(cache.load(kCacheFile));
+  assertTrue(cache.save());
+  std::string saved = readFile(kCacheFile);
+  remove(kCacheFile);
+
+  assertTrue(saved == content);
+}
+
+// The comments and the incomplete lines are dropped, and the last entry of a
+// name wins.
+test(comments_and_duplicates) {
+  writeFile(kCacheFile,
+      "# comment\n"
+      "a_test passed 1\n"
+      "incomplete\n"
+      "a_test failed 2\n"
+      "b_test expired 3");
+
+  ResultsCache cache;
+  assertTrue(cache.load(kCacheFile));
+  assertTrue(cache.save());
+  std::string saved = readFile(kCacheFile);
+  remove(kCacheFile);
+
+  assertTrue(saved == "a_test failed 2\nb_test expired 3\n");
+}
+
+std::string order;
+
+test(order_a) {
+  order += "a";
+}
+
+// Failed in the cache written by setup(), so run first by '--failed-first'.
+test(order_z) {
+  order += "z";
+}
+
+// The other tests are not in the cache, so they keep their sorted order, and
+// this one runs last.
+test(verify_order) {
+  static uint16_t iterations = 0;
+  iterations++;
+  std::string expected;
+  for (uint16_t i = 0; i < iterations; i++) expected += "za";
+  assertTrue(order == expected);
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+#if defined(EPOXY_DUINO)
+  writeFile(kRunnerCacheFile, "order_z failed 1\n");
+  static const char* const argv[] = {
+    epoxy_argv[0], "--cache", kRunnerCacheFile, "--failed-first"
+  };
+  epoxy_argc = 4;
+  epoxy_argv = argv;
+  TestRunner::setRepeat(kIterations);
+#endif
+}
+
+void loop() {
+  // Should get, twice:
+  // TestRunner summary:
+  //    5 passed, 0 failed, 0 skipped, 0 timed out, out of 5 test(s).
+  // then:
+  // TestRunner repeat summary: 2 passed, 0 failed, out of 2 iteration(s).
+  TestRunner::run();
+}
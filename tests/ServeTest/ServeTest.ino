@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify TestRunner::setServing(), which runs the tests several times in the
+ * same process, as selected by the commands read from stdin. The commands are
+ * written to a pipe which replaces stdin in setup().
+ */
+
+#include <string.h>
+#include <unistd.h> // pipe(), dup2()
+#include <AUnit.h>
+using namespace aunit;
+
+// The 'list' command does not start a run, and the unknown command is
+// reported. The 'run' commands start the four runs.
+static const char kCommands[] =
+    "run\n"
+    "list\n"
+    "run a sleeper\n"
+    "bogus\n"
+    "run\n"
+    "run verify\n"
+    "quit\n";
+
+uint8_t aRuns = 0;
+uint8_t sleeperRuns = 0;
+uint8_t asyncRuns = 0;
+
+test(a) {
+  aRuns++;
+}
+
+// TestAgain::setup() clears the sleep of the previous run.
+testing(sleeper) {
+  static bool isAwake = false;
+  if (isAwake) {
+    isAwake = false;
+    pass();
+    return;
+  }
+  sleeperRuns++;
+  isAwake = true;
+  sleepUntil(millis() + 5);
+}
+
+// AsyncTest::setup() starts each run from the beginning of the body.
+asyncTest(async) {
+  AUNIT_ASYNC_BEGIN();
+  asyncRuns++;
+  AUNIT_SLEEP(5);
+  AUNIT_ASYNC_END();
+}
+
+// Excluded in setup(), so it runs only when a run includes it, in the last
+// run.
+test(verify) {
+  assertEqual(3, aRuns);
+  assertEqual(3, sleeperRuns);
+  assertEqual(3, asyncRuns);
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  int fds[2];
+  if (pipe(fds) != 0) exit(1);
+  if (write(fds[1], kCommands, strlen(kCommands)) < 0) exit(1);
+  close(fds[1]);
+  dup2(fds[0], STDIN_FILENO);
+  close(fds[0]);
+
+  TestRunner::exclude("verify");
+  TestRunner::setServing(true);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 1 skipped, 0 timed out, out of 4 test(s).
+  // (3 times), then:
+  //    1 passed, 0 failed, 3 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify that TestRunner::setShard() keeps only the tests of the selected
+ * shard, assigned round robin in sorted order, and that the tests of the other
+ * shards are marked as skipped and done without being run or reported. With
+ * setShard(0, 2), shard 0 contains a_0, a_2, a_4 and z_verify.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+static uint8_t runCount = 0;
+
+test(a_0) { runCount++; }
+test(a_1) { runCount++; }
+test(a_2) { runCount++; }
+test(a_3) { runCount++; }
+test(a_4) { runCount++; }
+test(a_5) { runCount++; }
+
+testing(z_verify) {
+  if (checkTestNotDone(a_0) || checkTestNotDone(a_2)
+      || checkTestNotDone(a_4)) {
+    return;
+  }
+  assertTestPass(a_0);
+  assertTestSkip(a_1);
+  assertTestPass(a_2);
+  assertTestSkip(a_3);
+  assertTestPass(a_4);
+  assertTestSkip(a_5);
+  assertEqual(3, (int) runCount);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setShard(0, 2);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 0 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
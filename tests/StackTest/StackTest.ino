@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify the stack usage measured by the TestRunner when
+ * AUNIT_ENABLE_STACK_TRACKING is set (see the Makefile), and the
+ * assertMaxStack() assertion.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+#if AUNIT_ENABLE_STACK_TRACKING
+
+namespace {
+
+// Use about 'size' bytes of stack. The buffer is written with a value
+// different from the canary pattern so that every byte is seen.
+template <uint16_t size>
+__attribute__((noinline)) uint8_t useStack(uint8_t value) {
+  volatile uint8_t buffer[size];
+  for (uint16_t i = 0; i < size; i++) buffer[i] = value;
+  return buffer[size / 2];
+}
+
+}
+
+test(shallow) {
+  assertMaxStack(1024);
+}
+
+test(deep) {
+  assertEqual(1, useStack<2000>(1));
+}
+
+// The stack unwinds between the calls to loop(), so the deepest call is
+// recorded, even if it is not the last one.
+testing(again_deepest_first) {
+  static uint8_t count = 0;
+  if (count == 0) {
+    useStack<3000>(2);
+  } else {
+    useStack<100>(3);
+  }
+  if (++count == 3) pass();
+}
+
+// Inspects other tests, so must not run concurrently with them.
+serialTesting(verify_stack) {
+  if (checkTestNotDone(shallow)) return;
+  if (checkTestNotDone(deep)) return;
+  if (checkTestNotDone(again_deepest_first)) return;
+
+  assertLess(test_shallow_instance.getStackUsage(), 1024);
+
+  uint16_t deep = test_deep_instance.getStackUsage();
+  assertMoreOrEqual(deep, 2000);
+  assertLess(deep, 3000);
+
+  uint16_t again = test_again_deepest_first_instance.getStackUsage();
+  assertMoreOrEqual(again, 3000);
+  assertLess(again, 4000);
+  pass();
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setVerbosity(Verbosity::kDefault | Verbosity::kTestTiming);
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 0 skipped, 0 timed out, out of 4 test(s).
+  TestRunner::run();
+}
@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+ * Verify that testTable() runs its body once for each row of a PROGMEM table,
+ * using a single Test instance, and that the table is selected by the filters
+ * by its name like any other test.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+struct AddRow {
+  int a;
+  int b;
+  int sum;
+};
+
+static const AddRow kAddRows[] PROGMEM = {
+  {0, 0, 0},
+  {1, 2, 3},
+  {-1, 1, 0},
+  {100, -30, 70},
+  {32767, -32767, 0},
+};
+
+static uint16_t addRowCount = 0;
+
+testTable(add, AddRow, kAddRows) {
+  addRowCount++;
+  assertEqual(row.a + row.b, row.sum);
+}
+
+struct ParseRow {
+  const char* text;
+  long value;
+};
+
+static const char kText0[] PROGMEM = "0";
+static const char kText1[] PROGMEM = "42";
+static const char kText2[] PROGMEM = "-17";
+
+static const ParseRow kParseRows[] PROGMEM = {
+  {kText0, 0},
+  {kText1, 42},
+  {kText2, -17},
+};
+
+testTable(Parse, atol, ParseRow, kParseRows) {
+  char buf[8];
+  strcpy_P(buf, row.text);
+  assertEqual(atol(buf), row.value);
+}
+
+// A table whose first row skips itself, which does not fail the table.
+static const AddRow kSkipRows[] PROGMEM = {
+  {0, 0, 1},
+  {1, 2, 3},
+};
+
+testTable(skipped_rows, AddRow, kSkipRows) {
+  if (row.a + row.b != row.sum) {
+    skipTestNow();
+  }
+  assertEqual(row.a + row.b, row.sum);
+}
+
+// Excluded by the filter in setup().
+static uint16_t excludedRowCount = 0;
+
+testTable(excluded, AddRow, kAddRows) {
+  (void) row;
+  excludedRowCount++;
+}
+
+testing(z_verify) {
+  if (checkTestNotDone(add) || checkTestNotDoneF(Parse, atol)
+      || checkTestNotDone(skipped_rows)) {
+    return;
+  }
+  assertTestPass(add);
+  assertEqual((int) test_add_instance.getNumRows(), 5);
+  assertEqual((int) test_add_instance.getNumFailedRows(), 0);
+  assertEqual((int) addRowCount, 5);
+
+  assertTestPassF(Parse, atol);
+  assertEqual((int) Parse_atol_instance.getNumRows(), 3);
+
+  assertTestPass(skipped_rows);
+  assertEqual((int) test_skipped_rows_instance.getNumFailedRows(), 0);
+
+  assertTestSkip(excluded);
+  assertEqual((int) excludedRowCount, 0);
+  pass();
+}
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::exclude("excluded");
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    4 passed, 0 failed, 1 skipped, 0 timed out, out of 5 test(s).
+  TestRunner::run();
+}
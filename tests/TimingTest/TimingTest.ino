@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Verify the timing statistics recorded by the TestRunner when
+ * AUNIT_ENABLE_TIMING is set, and exercise the output of
+ * Verbosity::kTestTiming.
+ */
+
+#include <AUnit.h>
+using namespace aunit;
+
+testing(again_three) {
+  static uint8_t count = 0;
+  if (++count == 3) pass();
+}
+
+class SlowFixture: public TestOnce {
+  protected:
+    void setup() override {
+      TestOnce::setup();
+      delay(2);
+    }
+
+    void teardown() override {
+      delay(1);
+      TestOnce::teardown();
+    }
+};
+
+testF(SlowFixture, slow) {
+  delay(3);
+}
+
+test(excluded) {}
+
+#if AUNIT_ENABLE_TIMING
+
+// Inspects other tests, so must not run concurrently with them.
+serialTesting(verify_timing) {
+  if (checkTestNotDone(again_three)) return;
+  if (checkTestNotDoneF(SlowFixture, slow)) return;
+
+  const Test::Timing& again = test_again_three_instance.getTiming();
+  assertEqual(3UL, again.loopCount);
+
+  const Test::Timing& slow = SlowFixture_slow_instance.getTiming();
+  assertEqual(1UL, slow.loopCount);
+  assertMoreOrEqual(slow.setupMicros, 2000UL);
+  assertMoreOrEqual(slow.loopMicros, 3000UL);
+  assertMoreOrEqual(slow.teardownMicros, 1000UL);
+  assertMoreOrEqual(slow.totalMicros(), 6000UL);
+
+  assertTrue(SlowFixture_slow_instance.isStarted());
+  assertFalse(test_excluded_instance.isStarted());
+  assertEqual(0UL, test_excluded_instance.getTiming().totalMicros());
+  pass();
+}
+
+#endif
+
+void setup() {
+#ifdef ARDUINO
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until Serial is ready - Leonardo
+
+  TestRunner::setVerbosity(Verbosity::kDefault | Verbosity::kTestTiming);
+  TestRunner::exclude("excluded");
+}
+
+void loop() {
+  // Should get something like:
+  // TestRunner summary:
+  //    3 passed, 0 failed, 1 skipped, 0 timed out, out of 4 test(s).
+  // TestRunner slowest test(s):
+  //    6.226 ms SlowFixture_slow
+  //    ...
+  TestRunner::run();
+}
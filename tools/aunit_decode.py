@@ -0,0 +1,372 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright (c) 2018 Brian T. Park
+#
+# Decode the binary stream of the AUnit BinaryReporter (see
+# src/aunit/BinaryReporter.h) into the text output of the TextReporter, or into
+# the XML document of the JUnitReporter. The stream is read from a file, or
+# from stdin, for example a serial port:
+#
+#   $ stty -F /dev/ttyACM0 raw 115200
+#   $ ./aunit_decode.py < /dev/ttyACM0
+#   $ ./Test.out --format binary | ./aunit_decode.py --format junit
+#
+# The text output is written as soon as each record is decoded. The bytes
+# outside of the records are copied unchanged to the output, so that what the
+# program itself prints to Serial is not lost.
+
+import argparse
+import sys
+from typing import BinaryIO, Dict, List, Optional, TextIO
+from xml.sax.saxutils import escape, quoteattr
+
+VERSION = 1
+
+START = 0x01
+TEST = 0x02
+FILE = 0x03
+MESSAGE = 0x04
+ASSERTION_MESSAGE = 0x05
+RESULT = 0x06
+END = 0x07
+REPEAT = 0x08
+
+PASSED = 1
+FAILED = 2
+SKIPPED = 3
+EXPIRED = 4
+
+TEST_TIMEOUT_FLAG = 0x08
+TIMING_FLAG = 0x10
+HEAP_FLAG = 0x20
+STACK_FLAG = 0x40
+
+
+class EndOfStream(Exception):
+    pass
+
+
+class Reader:
+    """Read the bytes, varints and strings of the stream."""
+
+    def __init__(self, stream: BinaryIO):
+        self.stream = stream
+        self.pending = bytearray()
+
+    def unread(self, data: bytes) -> None:
+        self.pending[0:0] = data
+
+    def byte(self) -> int:
+        if self.pending:
+            return self.pending.pop(0)
+        b = self.stream.read(1)
+        if not b:
+            raise EndOfStream()
+        return b[0]
+
+    def varint(self) -> int:
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if b < 0x80:
+                return value
+            shift += 7
+
+    def zigzag(self) -> int:
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def string(self) -> str:
+        data = bytearray()
+        while True:
+            b = self.byte()
+            if b == 0:
+                return data.decode('utf-8', errors='replace')
+            data.append(b)
+
+
+class Result:
+    """The result record of a test, and its messages."""
+
+    def __init__(self, name: str):
+        self.name = name
+        self.messages: List[str] = []
+        self.status = 0
+        self.is_test_timeout = False
+        self.micros: Optional[int] = None
+        self.heap: Optional[List[int]] = None
+        self.stack: Optional[int] = None
+
+
+class TextWriter:
+    """Write the same lines as the TextReporter with Verbosity::kDefault."""
+
+    def __init__(self, out: TextIO, is_color: bool, is_timing: bool):
+        self.out = out
+        self.is_color = is_color
+        self.is_timing = is_timing
+        self.width = 0
+
+    def raw(self, text: str) -> None:
+        self.out.write(text)
+        self.out.flush()
+
+    def begin_run(self, num_tests: int, width: int) -> None:
+        self.width = width
+        self.line(f'TestRunner started on {num_tests} test(s).')
+
+    def message(self, text: str) -> None:
+        self.line(text)
+
+    def end_test(self, result: Result) -> None:
+        if result.status == PASSED:
+            status, color = ' passed', '\033[32m'
+        elif result.status == FAILED:
+            status, color = ' failed', '\033[31m'
+        elif result.status == SKIPPED:
+            status, color = ' skipped', ''
+        elif result.status == EXPIRED:
+            status, color = ' failed', '\033[33m'
+        else:
+            return
+        padding = ' ' * (self.width - len(result.name) + 1)
+        if self.is_color and color:
+            status = f'{color}{status}\033[37m'
+        self.line(f'{padding}{result.name}{status}.')
+
+        if not self.is_timing:
+            return
+        if result.micros is not None:
+            self.line(f'    timing: {format_thousandths(result.micros)} ms')
+        if result.heap is not None:
+            allocs, size, peak, in_use = result.heap
+            self.line(f'    heap: {allocs} allocation(s) of {size} bytes, '
+                      f'peak {peak} bytes, in use {in_use} bytes')
+        if result.stack is not None:
+            self.line(f'    stack: {result.stack} bytes')
+
+    def end_run(self, counts: List[int], millis: int) -> None:
+        tests, passed, failed, skipped, expired, test_timeouts = counts
+        self.line(f'TestRunner duration: {format_thousandths(millis)} '
+                  'seconds.')
+        self.line(f'TestRunner summary: {passed} passed, {failed} failed, '
+                  f'{skipped} skipped, {expired} timed out, '
+                  f'out of {tests} test(s).')
+        if test_timeouts > 0:
+            self.line(f'TestRunner per-test timeouts: {test_timeouts} '
+                      'test(s) exceeded their own timeout.')
+
+    def end_repeat(self, iterations: int, failed: int, millis: int,
+                   tests: List[List]) -> None:
+        self.line(f'TestRunner repeat duration: {format_thousandths(millis)} '
+                  'seconds.')
+        self.line(f'TestRunner repeat summary: {iterations - failed} passed, '
+                  f'{failed} failed, out of {iterations} iteration(s).')
+        if tests:
+            self.line('TestRunner failed test(s):')
+        for name, passed_count, failed_count in tests:
+            self.line(f'    {failed_count} failed, {passed_count} passed '
+                      f'{name}')
+
+    def end(self) -> None:
+        pass
+
+    def line(self, text: str) -> None:
+        self.out.write(text + '\n')
+        self.out.flush()
+
+
+class JUnitWriter:
+    """Write the same document as the JUnitReporter. The bytes outside of the
+    records are dropped, since they would make the XML invalid."""
+
+    def __init__(self, out: TextIO):
+        self.out = out
+
+    def raw(self, text: str) -> None:
+        pass
+
+    def begin_run(self, num_tests: int, width: int) -> None:
+        self.out.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        self.out.write(f'<testsuite name="AUnit" tests="{num_tests}">\n')
+
+    def message(self, text: str) -> None:
+        pass
+
+    def end_test(self, result: Result) -> None:
+        self.out.write(
+            f'  <testcase classname="AUnit" name={quoteattr(result.name)}')
+        if result.micros is not None:
+            time = format_thousandths(result.micros // 1000)
+            self.out.write(f' time="{time}"')
+        message = result.messages[-1] if result.messages else ''
+        if result.status == FAILED:
+            first_line = message.split('\n')[0]
+            self.out.write(f'><failure message={quoteattr(first_line)}>'
+                           f'{escape(message)}</failure></testcase>\n')
+        elif result.status == EXPIRED:
+            self.out.write('><failure type="timeout" message="timed out">'
+                           f'{escape(message)}</failure></testcase>\n')
+        elif result.status == SKIPPED:
+            self.out.write('><skipped/></testcase>\n')
+        elif message:
+            self.out.write(f'><system-out>{escape(message)}'
+                           '</system-out></testcase>\n')
+        else:
+            self.out.write('/>\n')
+
+    def end_run(self, counts: List[int], millis: int) -> None:
+        self.out.write('</testsuite>\n')
+
+    def end_repeat(self, iterations: int, failed: int, millis: int,
+                   tests: List[List]) -> None:
+        pass
+
+    def end(self) -> None:
+        self.out.flush()
+
+
+def format_thousandths(value: int) -> str:
+    """Same as printSeconds() in src/aunit/print_util.cpp."""
+    return f'{value // 1000}.{value % 1000:03d}'
+
+
+class Decoder:
+    """Decode the records of the stream and pass them to the writer."""
+
+    def __init__(self, reader: Reader, writer):
+        self.reader = reader
+        self.writer = writer
+        self.files: Dict[int, str] = {}
+        self.is_started = False
+        self.result: Optional[Result] = None
+        self.raw = bytearray()
+
+    def run(self) -> None:
+        try:
+            while True:
+                self.next()
+        except EndOfStream:
+            self.flush_raw()
+        self.writer.end()
+
+    def next(self) -> None:
+        b = self.reader.byte()
+        if b == START:
+            magic = bytes([self.reader.byte(), self.reader.byte()])
+            if magic != b'AU':
+                self.raw.append(b)
+                self.reader.unread(magic)
+                return
+            version = self.reader.byte()
+            if version != VERSION:
+                raise ValueError(f'Unsupported stream version {version}')
+            self.flush_raw()
+            self.is_started = True
+            num_tests = self.reader.varint()
+            width = self.reader.varint()
+            self.files.clear()
+            self.result = None
+            self.writer.begin_run(num_tests, width)
+        elif not self.is_started or b > REPEAT:
+            self.raw.append(b)
+            if b == ord('\n'):
+                self.flush_raw()
+        else:
+            self.flush_raw()
+            self.record(b)
+
+    def record(self, b: int) -> None:
+        reader = self.reader
+        if b == TEST:
+            # The ids of the files are defined again in each block.
+            self.result = Result(reader.string())
+            self.files.clear()
+        elif b == FILE:
+            file_id = reader.varint()
+            self.files[file_id] = reader.string()
+        elif b == MESSAGE:
+            self.message(reader.string())
+        elif b == ASSERTION_MESSAGE:
+            file_id = reader.varint()
+            if file_id == 0:
+                path = reader.string()
+            else:
+                path = self.files.get(file_id, f'#{file_id}')
+            line = reader.varint()
+            self.message(f'{path}:{line}: {reader.string()}')
+        elif b == RESULT:
+            result = self.result or Result('')
+            self.result = None
+            flags = reader.byte()
+            result.status = flags & 0x07
+            result.is_test_timeout = bool(flags & TEST_TIMEOUT_FLAG)
+            if flags & TIMING_FLAG:
+                result.micros = reader.varint()
+            if flags & HEAP_FLAG:
+                result.heap = [reader.varint(), reader.varint(),
+                               reader.varint(), reader.zigzag()]
+            if flags & STACK_FLAG:
+                result.stack = reader.varint()
+            self.writer.end_test(result)
+        elif b == END:
+            counts = [reader.varint() for _ in range(6)]
+            self.writer.end_run(counts, reader.varint())
+        elif b == REPEAT:
+            iterations = reader.varint()
+            failed = reader.varint()
+            millis = reader.varint()
+            tests = [[reader.string(), reader.varint(), reader.varint()]
+                     for _ in range(reader.varint())]
+            self.writer.end_repeat(iterations, failed, millis, tests)
+
+    def message(self, text: str) -> None:
+        if self.result is not None:
+            self.result.messages.append(text)
+        self.writer.message(text)
+
+    def flush_raw(self) -> None:
+        if not self.raw:
+            return
+        text = self.raw.decode('utf-8', errors='replace')
+        self.writer.raw(text.replace('\r\n', '\n'))
+        self.raw.clear()
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description='Decode the output of the AUnit BinaryReporter')
+    parser.add_argument('--format', choices=['text', 'junit'], default='text',
+                        help='Output format (default: text)')
+    parser.add_argument('--color', action=argparse.BooleanOptionalAction,
+                        default=None,
+                        help='ANSI colors of the text (default: if a tty)')
+    parser.add_argument('--timing', action='store_true',
+                        help='Print the timing, heap and stack of each test')
+    parser.add_argument('input', nargs='?',
+                        help='Input file (default: stdin)')
+    args = parser.parse_args()
+
+    if args.format == 'junit':
+        writer = JUnitWriter(sys.stdout)
+    else:
+        is_color = sys.stdout.isatty() if args.color is None else args.color
+        writer = TextWriter(sys.stdout, is_color, args.timing)
+
+    try:
+        if args.input:
+            with open(args.input, 'rb', buffering=0) as stream:
+                Decoder(Reader(stream), writer).run()
+        else:
+            Decoder(Reader(sys.stdin.buffer), writer).run()
+    except BrokenPipeError:
+        # The output was piped into a program like 'head' which exited.
+        sys.stderr.close()
+
+
+if __name__ == '__main__':
+    main()